@@ -0,0 +1,73 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/utils/AddressParser.h"
+#include "cpplibsocket/utils/utils.h"
+
+using namespace cpplibsocket;
+using namespace cpplibsocket::literals;
+
+namespace {
+
+const std::string IPV4 = "192.168.100.200";
+const std::string IPV6 = "2001:db8:85a3::8a2e:370:7334";
+
+/// The path utils::createAddr() took before the numeric parser was introduced
+Address createAddrSystem(const IPVer ipVersion, const std::string& ip, const Port port) {
+    struct addrinfo hint = {};
+    hint.ai_family = toNativeDomain(ipVersion);
+    hint.ai_flags = AI_NUMERICHOST;
+    const utils::AddrInfo addrInfo(ip, &hint);
+    Address addr = {};
+    std::memcpy(&addr.sa, (*std::begin(addrInfo))->ai_addr, (*std::begin(addrInfo))->ai_addrlen);
+    utils::setPort(addr, port);
+    return addr;
+}
+
+} // namespace
+
+BENCHMARK(createAddrIPv4_getaddrinfo) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(createAddrSystem(IPVer::IPV4, IPV4, 80));
+    }
+}
+
+BENCHMARK(createAddrIPv4) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(utils::createAddr(IPVer::IPV4, IPV4, 80));
+    }
+}
+
+BENCHMARK(createAddrIPv6_getaddrinfo) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(createAddrSystem(IPVer::IPV6, IPV6, 80));
+    }
+}
+
+BENCHMARK(createAddrIPv6) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(utils::createAddr(IPVer::IPV6, IPV6, 80));
+    }
+}
+
+BENCHMARK(addressLiteralIPv6) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const Address addr = "[2001:db8:85a3::8a2e:370:7334]:80"_addr;
+        bench::doNotOptimize(addr);
+    }
+}
+
+BENCHMARK(parseIPv6) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        utils::IpBytes ip;
+        bench::doNotOptimize(utils::parseIp(IPVer::IPV6, IPV6.data(), IPV6.size(), ip));
+        bench::doNotOptimize(ip);
+    }
+}
+
+BENCHMARK(inetPtonIPv6) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        in6_addr ip;
+        bench::doNotOptimize(::inet_pton(AF_INET6, IPV6.c_str(), &ip));
+        bench::doNotOptimize(ip);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef CPPLIBSOCKET_BENCH_BENCHMARK_H_
+#define CPPLIBSOCKET_BENCH_BENCHMARK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Benchmark body, runs the measured operation the given number of times
+using Function = std::function<void(std::size_t iterations)>;
+
+struct Entry {
+    std::string name;
+    Function function;
+};
+
+inline std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+struct Registrar {
+    Registrar(const char* name, Function function) { registry().push_back({ name, std::move(function) }); }
+};
+
+/// Prevents the compiler from optimizing the computation of the given value away
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+/// Defines a benchmark, the body receives the number of iterations as `iterations`
+#define BENCHMARK(name)                                                                                      \
+    static void name(std::size_t iterations);                                                                \
+    static const bench::Registrar BENCH_CONCAT(name, Registrar)(#name, name);                                \
+    static void name(std::size_t iterations)
+
+#endif // CPPLIBSOCKET_BENCH_BENCHMARK_H_
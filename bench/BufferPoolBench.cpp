@@ -0,0 +1,31 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/BufferPool.h"
+
+#include <memory>
+
+using namespace cpplibsocket;
+
+BENCHMARK(receiveBuffer_new) {
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::unique_ptr<Byte[]> buffer(new Byte[16384]);
+        bench::doNotOptimize(buffer.get());
+    }
+}
+
+BENCHMARK(receiveBuffer_pool) {
+    BufferPool pool;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        PooledBuffer buffer = pool.acquire(16384);
+        bench::doNotOptimize(buffer.data());
+    }
+}
+
+BENCHMARK(receiveBuffer_poolShared) {
+    BufferPool pool;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        PooledBuffer buffer = pool.acquire(16384);
+        PooledBuffer copy = buffer;
+        bench::doNotOptimize(copy.data());
+    }
+}
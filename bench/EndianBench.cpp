@@ -0,0 +1,107 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/common/Endian.h"
+
+#include <vector>
+
+namespace {
+
+// Large enough to be worth vectorizing, small enough to stay in the L1 cache
+constexpr std::size_t COUNT = 1024;
+
+constexpr Endian::Type FOREIGN =
+    Endian::getNative() == Endian::Type::Little ? Endian::Type::Big : Endian::Type::Little;
+
+/// The byte by byte loop Endian::convertToNative() used before
+template <typename T>
+T reverseBytes(const T& value) {
+    T result;
+    const char* source = reinterpret_cast<const char*>(&value);
+    char* destination = reinterpret_cast<char*>(&result);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        destination[i] = source[sizeof(T) - 1 - i];
+    }
+    return result;
+}
+
+template <typename T>
+void convertBytewise(const std::size_t iterations) {
+    std::vector<T> source(COUNT, T(1));
+    std::vector<T> destination(COUNT);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < COUNT; ++j) {
+            destination[j] = reverseBytes(source[j]);
+        }
+        bench::doNotOptimize(destination);
+    }
+}
+
+template <typename T>
+void convertScalar(const std::size_t iterations) {
+    std::vector<T> source(COUNT, T(1));
+    std::vector<T> destination(COUNT);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < COUNT; ++j) {
+            destination[j] = Endian::convertToNative(source[j], FOREIGN);
+        }
+        bench::doNotOptimize(destination);
+    }
+}
+
+template <typename T>
+void convertBulk(const std::size_t iterations) {
+    std::vector<T> source(COUNT, T(1));
+    std::vector<T> destination(COUNT);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Endian::convertToNative(source.data(), destination.data(), COUNT, FOREIGN);
+        bench::doNotOptimize(destination);
+    }
+}
+
+} // namespace
+
+// Each iteration converts an array of COUNT values
+
+BENCHMARK(endian16_bytewise) {
+    convertBytewise<std::uint16_t>(iterations);
+}
+
+BENCHMARK(endian16_scalar) {
+    convertScalar<std::uint16_t>(iterations);
+}
+
+BENCHMARK(endian16_bulk) {
+    convertBulk<std::uint16_t>(iterations);
+}
+
+BENCHMARK(endian32_bytewise) {
+    convertBytewise<std::uint32_t>(iterations);
+}
+
+BENCHMARK(endian32_scalar) {
+    convertScalar<std::uint32_t>(iterations);
+}
+
+BENCHMARK(endian32_bulk) {
+    convertBulk<std::uint32_t>(iterations);
+}
+
+BENCHMARK(endian64_bytewise) {
+    convertBytewise<std::uint64_t>(iterations);
+}
+
+BENCHMARK(endian64_scalar) {
+    convertScalar<std::uint64_t>(iterations);
+}
+
+BENCHMARK(endian64_bulk) {
+    convertBulk<std::uint64_t>(iterations);
+}
+
+BENCHMARK(endianDouble_scalar) {
+    convertScalar<double>(iterations);
+}
+
+BENCHMARK(endianDouble_bulk) {
+    convertBulk<double>(iterations);
+}
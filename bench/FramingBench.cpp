@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/Framing.h"
+
+#include <thread>
+
+using namespace cpplibsocket;
+
+namespace {
+
+constexpr UnsignedSize FRAME_COUNT = 32;
+constexpr UnsignedSize PAYLOAD_SIZE = 100;
+
+/// Connected sockets whose receiving end is drained by a thread, so the sends never block
+struct DrainedConnection {
+    DrainedConnection()
+        : client(IPVer::IPV4) {
+        Socket<IPProto::TCP> listener(IPVer::IPV4);
+        const Port port = listener.bind("127.0.0.1");
+        listener.listen(1);
+        client.connect("127.0.0.1", port);
+        client.setOption<opt::NoDelay>(true);
+        Socket<IPProto::TCP> server = std::move(*listener.accept());
+        drain = std::thread([moved = std::move(server)]() {
+            Byte buffer[64 * 1024];
+            while (*moved.receive(buffer, sizeof(buffer)) != 0) {
+            }
+        });
+    }
+
+    ~DrainedConnection() {
+        client.close();
+        drain.join();
+    }
+
+    Socket<IPProto::TCP> client;
+    std::thread drain;
+};
+
+} // namespace
+
+BENCHMARK(frameDecode) {
+    const FrameEncoder::Options options;
+    FrameEncoder encoder(options);
+    const std::vector<Byte> payload(PAYLOAD_SIZE, 0xab);
+    for (UnsignedSize i = 0; i < FRAME_COUNT; ++i) {
+        encoder.add(payload.data(), payload.size());
+    }
+    std::vector<Byte> stream;
+    for (const ConstBuffer& buffer : encoder.buffers()) {
+        stream.insert(stream.end(), buffer.data, buffer.data + buffer.size);
+    }
+    const FrameDecoder decoder(options);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const DecodedFrame frame = decoder.decode(stream.data() + i % FRAME_COUNT * (PAYLOAD_SIZE + 4),
+                                                  stream.size() - i % FRAME_COUNT * (PAYLOAD_SIZE + 4));
+        bench::doNotOptimize(frame);
+    }
+}
+
+BENCHMARK(frameSend_twoSendsPerFrame) {
+    DrainedConnection connection;
+    const std::vector<Byte> payload(PAYLOAD_SIZE, 0xab);
+    const Byte prefix[] = { 0, 0, 0, PAYLOAD_SIZE };
+    for (std::size_t i = 0; i < iterations; ++i) {
+        connection.client.send(prefix, sizeof(prefix));
+        connection.client.send(payload.data(), payload.size());
+    }
+}
+
+BENCHMARK(frameSend_batchedEncoder) {
+    DrainedConnection connection;
+    const std::vector<Byte> payload(PAYLOAD_SIZE, 0xab);
+    FrameEncoder encoder;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        encoder.add(payload.data(), payload.size());
+        if (encoder.size() == FRAME_COUNT || i + 1 == iterations) {
+            while (!encoder.empty()) {
+                encoder.flush(connection.client);
+            }
+        }
+    }
+}
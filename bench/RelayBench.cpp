@@ -0,0 +1,92 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/Relay.h"
+
+#include <thread>
+#include <vector>
+
+using namespace cpplibsocket;
+
+namespace {
+
+constexpr UnsignedSize TRANSFER_SIZE = 1024 * 1024;
+
+Socket<IPProto::TCP> connectTo(Socket<IPProto::TCP>& listener) {
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+    Socket<IPProto::TCP> socket(IPVer::IPV4);
+    socket.connect("127.0.0.1", port);
+    return socket;
+}
+
+/// Client connected to a server through the two sockets of a proxy, the server is drained by a thread
+struct ProxiedConnection {
+    ProxiedConnection()
+        : proxyListener(IPVer::IPV4)
+        , serverListener(IPVer::IPV4)
+        , client(connectTo(proxyListener))
+        , proxyIn(std::move(*proxyListener.accept()))
+        , proxyOut(connectTo(serverListener)) {
+        drain = std::thread([server = std::move(*serverListener.accept())]() {
+            Byte buffer[64 * 1024];
+            while (*server.receive(buffer, sizeof(buffer)) != 0) {
+            }
+        });
+        client.setBlocked(false);
+        proxyIn.setBlocked(false);
+        proxyOut.setBlocked(false);
+    }
+
+    ~ProxiedConnection() {
+        proxyOut.close();
+        drain.join();
+    }
+
+    Socket<IPProto::TCP> proxyListener;
+    Socket<IPProto::TCP> serverListener;
+    Socket<IPProto::TCP> client;
+    Socket<IPProto::TCP> proxyIn;
+    Socket<IPProto::TCP> proxyOut;
+    std::thread drain;
+};
+
+} // namespace
+
+// 1 MiB forwarded by the proxy, received into user space and sent
+BENCHMARK(relay_receiveAndSend) {
+    ProxiedConnection connection;
+    const std::vector<Byte> data(TRANSFER_SIZE, 0xab);
+    std::vector<Byte> buffer(64 * 1024);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        UnsignedSize sent = 0;
+        UnsignedSize forwarded = 0;
+        while (forwarded < TRANSFER_SIZE) {
+            connection.client.sendAll(data.data(), data.size(), sent);
+            const Expected<UnsignedSize, SocketError> received =
+                connection.proxyIn.tryReceive(buffer.data(), buffer.size());
+            if (!received) {
+                continue;
+            }
+            UnsignedSize relayed = 0;
+            while (relayed < *received) {
+                connection.proxyOut.sendAll(buffer.data(), *received, relayed);
+            }
+            forwarded += *received;
+        }
+    }
+}
+
+// The same data forwarded by the Relay
+BENCHMARK(relay_splice) {
+    ProxiedConnection connection;
+    Relay relay(connection.proxyIn, connection.proxyOut);
+    const std::vector<Byte> data(TRANSFER_SIZE, 0xab);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        UnsignedSize sent = 0;
+        const UnsignedSize target = relay.forwardedToSecond() + relay.bufferedToSecond() + TRANSFER_SIZE;
+        while (relay.forwardedToSecond() + relay.bufferedToSecond() < target) {
+            connection.client.sendAll(data.data(), data.size(), sent);
+            relay.pump();
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/Socket.h"
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace cpplibsocket;
+
+namespace {
+
+constexpr UnsignedSize FILE_SIZE = 1024 * 1024;
+constexpr UnsignedSize CHUNK_SIZE = 64 * 1024;
+
+/// File of FILE_SIZE bytes, removed once done
+struct TemporaryFile {
+    TemporaryFile()
+        : path("cpplibsocket_sendfile_bench") {
+        const std::vector<char> data(FILE_SIZE, 'x');
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    ~TemporaryFile() { std::remove(path.c_str()); }
+
+    std::string path;
+};
+
+/// Connected sockets whose receiving end is drained by a thread
+struct DrainedConnection {
+    DrainedConnection()
+        : client(IPVer::IPV4) {
+        Socket<IPProto::TCP> listener(IPVer::IPV4);
+        const Port port = listener.bind("127.0.0.1");
+        listener.listen(1);
+        client.connect("127.0.0.1", port);
+        Socket<IPProto::TCP> server = std::move(*listener.accept());
+        drain = std::thread([moved = std::move(server)]() {
+            Byte buffer[CHUNK_SIZE];
+            while (*moved.receive(buffer, sizeof(buffer)) != 0) {
+            }
+        });
+    }
+
+    ~DrainedConnection() {
+        client.close();
+        drain.join();
+    }
+
+    Socket<IPProto::TCP> client;
+    std::thread drain;
+};
+
+} // namespace
+
+// A 1 MiB file read into user space a chunk at a time and sent
+BENCHMARK(fileSend_readAndSend) {
+    TemporaryFile temporary;
+    DrainedConnection connection;
+    std::ifstream file(temporary.path, std::ios::binary);
+    std::vector<Byte> chunk(CHUNK_SIZE);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        file.clear();
+        file.seekg(0);
+        while (file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()))
+                   .gcount() > 0) {
+            UnsignedSize sent = 0;
+            connection.client.sendAll(chunk.data(), static_cast<UnsignedSize>(file.gcount()), sent);
+        }
+    }
+}
+
+// The same file sent from the page cache
+BENCHMARK(fileSend_sendFile) {
+    TemporaryFile temporary;
+    DrainedConnection connection;
+    const FileHandle file = Platform::openFile(temporary.path);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        UnsignedSize sent = 0;
+        connection.client.sendFile(file, 0, FILE_SIZE, sent);
+    }
+    Platform::closeFile(file);
+}
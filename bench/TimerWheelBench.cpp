@@ -0,0 +1,46 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/Socket.h"
+#include "cpplibsocket/TimerWheel.h"
+
+#include <memory>
+
+using namespace cpplibsocket;
+
+namespace {
+
+constexpr std::size_t CONNECTION_COUNT = 10000;
+
+} // namespace
+
+// Deadline of one of many connections re-armed on a message received
+BENCHMARK(timerWheelRearm) {
+    TimerWheel wheel;
+    std::unique_ptr<Timer[]> timers(new Timer[CONNECTION_COUNT]);
+    const TimerWheel::Clock::time_point deadline = TimerWheel::Clock::now() + std::chrono::seconds(30);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        wheel.schedule(timers[i % CONNECTION_COUNT], deadline + std::chrono::milliseconds(i));
+    }
+    bench::doNotOptimize(wheel.size());
+}
+
+// The same deadline mapped to the socket receive timeout, a system call per message
+BENCHMARK(socketTimeoutRearm) {
+    Socket<IPProto::TCP> socket(IPVer::IPV4);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        socket.setTimeout(std::chrono::seconds(30) + std::chrono::milliseconds(i % 1000), Direction::RX);
+    }
+}
+
+BENCHMARK(timerWheelAdvance) {
+    TimerWheel wheel;
+    std::unique_ptr<Timer[]> timers(new Timer[CONNECTION_COUNT]);
+    const TimerWheel::Clock::time_point start = TimerWheel::Clock::now();
+    for (std::size_t i = 0; i < CONNECTION_COUNT; ++i) {
+        wheel.schedule(timers[i], start + std::chrono::hours(1));
+    }
+    // Idle ticks of a busy wheel, the timers are only moved down its levels
+    for (std::size_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(wheel.advance(start + std::chrono::milliseconds(i)));
+    }
+}
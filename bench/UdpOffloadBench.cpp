@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/Socket.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <vector>
+
+using namespace cpplibsocket;
+
+namespace {
+
+constexpr UnsignedSize DATAGRAM_SIZE = 1200;
+constexpr UnsignedSize DATAGRAM_COUNT = 32;
+
+/// Receiver that's never read, the datagrams it can't hold are dropped
+struct Sink {
+    Sink()
+        : receiver(IPVer::IPV4) {
+        address = utils::createAddr(IPVer::IPV4, "127.0.0.1", receiver.bind("127.0.0.1"));
+    }
+
+    Socket<IPProto::UDP> receiver;
+    Address address;
+};
+
+} // namespace
+
+// 32 datagrams of 1200 bytes, a system call and a pass through the stack each
+BENCHMARK(udpSend_perDatagram) {
+    Sink sink;
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const std::vector<Byte> data(DATAGRAM_SIZE * DATAGRAM_COUNT, 0xab);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (UnsignedSize offset = 0; offset < data.size(); offset += DATAGRAM_SIZE) {
+            sender.sendTo(data.data() + offset, DATAGRAM_SIZE, sink.address);
+        }
+    }
+}
+
+// The same datagrams split by the kernel
+BENCHMARK(udpSend_segmented) {
+    Sink sink;
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const std::vector<Byte> data(DATAGRAM_SIZE * DATAGRAM_COUNT, 0xab);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sender.sendToSegmented(data.data(), data.size(), DATAGRAM_SIZE, sink.address);
+    }
+}
@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+
+#include "cpplibsocket/Socket.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace cpplibsocket;
+
+namespace {
+
+constexpr UnsignedSize MESSAGE_SIZE = 64;
+constexpr UnsignedSize TRANSFER_SIZE = 1024 * 1024;
+
+/// Loopback TCP connection, the counterpart of Socket<IPProto::UnixStream>::pair()
+std::pair<Socket<IPProto::TCP>, Socket<IPProto::TCP>> tcpPair() {
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+    Socket<IPProto::TCP> client(IPVer::IPV4, SocketOptions<IPProto::TCP>().set<opt::NoDelay>(true));
+    client.connect("127.0.0.1", port);
+    Socket<IPProto::TCP> server = std::move(*listener.accept());
+    server.setOption<opt::NoDelay>(true);
+    return std::make_pair(std::move(client), std::move(server));
+}
+
+/// Sends every message back until a shorter one (or EOF) arrives
+template <typename TSocket>
+void echo(const TSocket& socket) {
+    Byte buffer[MESSAGE_SIZE];
+    while (true) {
+        UnsignedSize received = 0;
+        socket.receiveExact(buffer, sizeof(buffer), received);
+        if (received < sizeof(buffer)) {
+            return;
+        }
+        UnsignedSize sent = 0;
+        socket.sendAll(buffer, sizeof(buffer), sent);
+    }
+}
+
+template <typename TSocket>
+void pingPong(const TSocket& client, const std::size_t iterations) {
+    Byte message[MESSAGE_SIZE] = {};
+    for (std::size_t i = 0; i < iterations; ++i) {
+        UnsignedSize sent = 0;
+        client.sendAll(message, sizeof(message), sent);
+        UnsignedSize received = 0;
+        client.receiveExact(message, sizeof(message), received);
+    }
+}
+
+template <typename TSocket>
+void drain(const TSocket& socket) {
+    std::vector<Byte> buffer(64 * 1024);
+    while (*socket.receive(buffer.data(), buffer.size()) != 0) {
+    }
+}
+
+template <typename TSocket>
+void transfer(const TSocket& client, const std::size_t iterations) {
+    const std::vector<Byte> data(TRANSFER_SIZE, 0xab);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        UnsignedSize sent = 0;
+        client.sendAll(data.data(), data.size(), sent);
+    }
+}
+
+} // namespace
+
+// 64 byte request and response over a loopback TCP connection
+BENCHMARK(pingPong_tcp) {
+    auto sockets = tcpPair();
+    std::thread server([&sockets]() { echo(sockets.second); });
+    pingPong(sockets.first, iterations);
+    sockets.first.shutdown(Direction::TX);
+    server.join();
+}
+
+// The same over a Unix domain stream socket
+BENCHMARK(pingPong_unixStream) {
+    auto sockets = Socket<IPProto::UnixStream>::pair();
+    std::thread server([&sockets]() { echo(sockets.second); });
+    pingPong(sockets.first, iterations);
+    sockets.first.shutdown(Direction::TX);
+    server.join();
+}
+
+// 64 byte request and response datagrams over loopback UDP
+BENCHMARK(pingPong_udp) {
+    Socket<IPProto::UDP> server(IPVer::IPV4);
+    const Address serverAddress = utils::createAddr(IPVer::IPV4, "127.0.0.1", server.bind("127.0.0.1"));
+    Socket<IPProto::UDP> client(IPVer::IPV4);
+    client.bind("127.0.0.1");
+    std::thread echoing([&server]() {
+        Byte buffer[MESSAGE_SIZE];
+        Address source;
+        while (*server.receiveFrom(buffer, sizeof(buffer), source) == sizeof(buffer)) {
+            server.sendTo(buffer, sizeof(buffer), source);
+        }
+    });
+    Byte message[MESSAGE_SIZE] = {};
+    Address source;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        client.sendTo(message, sizeof(message), serverAddress);
+        client.receiveFrom(message, sizeof(message), source);
+    }
+    client.sendTo(message, 0, serverAddress);
+    echoing.join();
+}
+
+// The same over a pair of Unix domain datagram sockets
+BENCHMARK(pingPong_unixDatagram) {
+    auto sockets = Socket<IPProto::UnixDatagram>::pair();
+    std::thread server([&sockets]() { echo(sockets.second); });
+    pingPong(sockets.first, iterations);
+    sockets.first.send(nullptr, 0);
+    server.join();
+}
+
+// 1 MiB sent over a loopback TCP connection
+BENCHMARK(transfer_tcp) {
+    auto sockets = tcpPair();
+    std::thread server([&sockets]() { drain(sockets.second); });
+    transfer(sockets.first, iterations);
+    sockets.first.shutdown(Direction::TX);
+    server.join();
+}
+
+// The same over a Unix domain stream socket
+BENCHMARK(transfer_unixStream) {
+    auto sockets = Socket<IPProto::UnixStream>::pair();
+    std::thread server([&sockets]() { drain(sockets.second); });
+    transfer(sockets.first, iterations);
+    sockets.first.shutdown(Direction::TX);
+    server.join();
+}
@@ -0,0 +1,40 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::chrono::milliseconds MIN_DURATION(200);
+
+} // namespace
+
+/// Runs all the benchmarks, or only those whose name contains the first argument
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    std::printf("%-40s %15s %15s\n", "benchmark", "iterations", "ns/iteration");
+    for (const bench::Entry& entry : bench::registry()) {
+        if (entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        std::size_t iterations = 1;
+        Clock::duration elapsed;
+        while (true) {
+            const Clock::time_point start = Clock::now();
+            entry.function(iterations);
+            elapsed = Clock::now() - start;
+            if (elapsed >= MIN_DURATION) {
+                break;
+            }
+            iterations *= 2;
+        }
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        std::printf("%-40s %15zu %15.2f\n",
+                    entry.name.c_str(),
+                    iterations,
+                    static_cast<double>(ns) / static_cast<double>(iterations));
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+#ifndef CPPLIBSOCKET_BUFFERPOOL_H_
+#define CPPLIBSOCKET_BUFFERPOOL_H_
+
+#include "cpplibsocket/SocketCommon.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace cpplibsocket {
+
+namespace detail {
+    class BufferPoolState;
+
+    struct BufferHeader {
+        Byte* data;
+        UnsignedSize capacity;
+        UnsignedSize size;
+        BufferPoolState* pool;
+        std::uint32_t sizeClass;
+        std::atomic<std::uint32_t> references;
+    };
+
+    /// Gives the buffer back to its pool once its last reference is dropped
+    void releaseBuffer(BufferHeader* header) noexcept;
+} // namespace detail
+
+/// Reference-counted handle to a buffer of a BufferPool
+///
+/// Copies of the handle share the buffer, which goes back to the pool when the last of them is destroyed.
+/// The reference count is atomic, so the copies may be released by different threads. The buffer contents are
+/// not synchronized.
+class PooledBuffer final {
+public:
+    /// Creates an empty handle
+    PooledBuffer() noexcept = default;
+
+    PooledBuffer(const PooledBuffer& other) noexcept
+        : mHeader(other.mHeader) {
+        if (mHeader) {
+            mHeader->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : mHeader(other.mHeader) {
+        other.mHeader = nullptr;
+    }
+
+    PooledBuffer& operator=(PooledBuffer other) noexcept {
+        std::swap(mHeader, other.mHeader);
+        return *this;
+    }
+
+    ~PooledBuffer() noexcept { reset(); }
+
+    /// Drops the reference to the buffer, leaving the handle empty
+    void reset() noexcept {
+        if (mHeader && mHeader->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            detail::releaseBuffer(mHeader);
+        }
+        mHeader = nullptr;
+    }
+
+    explicit operator bool() const noexcept { return mHeader != nullptr; }
+
+    Byte* data() noexcept { return mHeader ? mHeader->data : nullptr; }
+
+    const Byte* data() const noexcept { return mHeader ? mHeader->data : nullptr; }
+
+    /// Returns the size of the data in the buffer, e.g. the size of the data received into it
+    UnsignedSize size() const noexcept { return mHeader ? mHeader->size : 0; }
+
+    /// Sets the size of the data in the buffer
+    void resize(const UnsignedSize size) noexcept {
+        ASSERT(mHeader && size <= mHeader->capacity);
+        mHeader->size = size;
+    }
+
+    /// Returns the size of the buffer class the buffer was taken from
+    UnsignedSize capacity() const noexcept { return mHeader ? mHeader->capacity : 0; }
+
+    /// Returns the whole buffer as the storage for data to be received
+    MutableBuffer mutableBuffer() noexcept { return { data(), capacity() }; }
+
+    /// Returns the data in the buffer as a piece of data to be sent
+    ConstBuffer constBuffer() const noexcept { return { data(), size() }; }
+
+    /// Returns the number of handles sharing the buffer
+    std::uint32_t useCount() const noexcept {
+        return mHeader ? mHeader->references.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    friend class BufferPool;
+
+    explicit PooledBuffer(detail::BufferHeader* header) noexcept
+        : mHeader(header) {}
+
+    detail::BufferHeader* mHeader = nullptr;
+};
+
+/// Configuration of BufferPool
+struct BufferPoolOptions {
+    /// The sizes of the buffer classes, a request is served from the smallest class it fits into
+    std::vector<UnsignedSize> bufferSizes{ 2048, 16384, 65536 };
+
+    /// The size of the memory chunks the buffers are carved from, rounded up to a multiple of the buffer size
+    /// (and of the huge page size if huge pages are used)
+    UnsignedSize chunkSize = 256 * 1024;
+
+    /// The maximum size of memory the pool allocates, 0 for no limit
+    UnsignedSize maxMemory = 0;
+
+    /// The maximum number of free buffers of each class kept by each thread, 0 to disable the thread caches
+    UnsignedSize threadCacheSize = 32;
+
+    /// Backs the chunks with huge pages (MAP_HUGETLB on Linux, large pages on Windows)
+    ///
+    /// If no huge pages are available, the chunks fall back to regular pages, which are advised to be
+    /// backed by transparent huge pages on Linux.
+    bool hugePages = false;
+};
+
+/// Pool of fixed-size buffers to receive data into
+///
+/// Buffers are only taken from the pool for the time data is being processed, so idle connections don't need
+/// to hold a buffer sized for the largest message they may receive, \see Socket<IPProto::TCP>::receive().
+/// The memory is allocated in chunks on demand and is kept by the pool until it's destroyed.
+///
+/// The pool is thread-safe. Each thread keeps a cache of free buffers, so taking and releasing buffers only
+/// locks the pool when the cache of the thread runs empty or overflows. All the buffers have to be released
+/// before the pool is destroyed.
+class BufferPool final {
+public:
+    using Options = BufferPoolOptions;
+
+    /// \throws Exception in case the buffer sizes are not valid.
+    explicit BufferPool(const Options& options = Options());
+
+    ~BufferPool() noexcept;
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /// Takes a buffer of at least the given size from the pool
+    /// \param size The size of the data to be stored in the buffer, the initial size of the buffer.
+    /// \throws Exception in case the size exceeds the largest buffer class, if the memory limit was reached
+    /// or if the memory couldn't be allocated.
+    PooledBuffer acquire(const UnsignedSize size);
+
+    /// Takes a buffer of at least the given size from the pool, \see acquire()
+    /// \returns The buffer, or an empty handle if the buffer couldn't be taken.
+    PooledBuffer tryAcquire(const UnsignedSize size) noexcept;
+
+    /// Returns the size of the largest buffer class
+    UnsignedSize maxBufferSize() const noexcept;
+
+    /// Returns the size of memory allocated by the pool
+    UnsignedSize allocatedMemory() const noexcept;
+
+    /// Tells whether or not any of the memory allocated is backed by huge pages
+    bool usesHugePages() const noexcept;
+
+    /// Gives the free buffers cached by the calling thread back to the pool
+    void flushThreadCache() noexcept;
+
+private:
+    std::shared_ptr<detail::BufferPoolState> mState;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_BUFFERPOOL_H_
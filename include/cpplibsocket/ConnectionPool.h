@@ -0,0 +1,159 @@
+#ifndef CPPLIBSOCKET_CONNECTIONPOOL_H_
+#define CPPLIBSOCKET_CONNECTIONPOOL_H_
+
+#include "cpplibsocket/SocketTcp.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cpplibsocket {
+
+/// Configuration of a ConnectionPool
+struct ConnectionPoolOptions {
+    /// The maximum number of connections to a single address, both idle and checked out, 0 for no limit
+    UnsignedSize maxPerHost = 16;
+
+    /// Idle connections unused for longer are closed instead of being checked out
+    std::chrono::steady_clock::duration idleTimeout = std::chrono::seconds(60);
+
+    /// The options set on the new connections, e.g. opt::NoDelay
+    SocketOptions<IPProto::TCP> socketOptions;
+};
+
+/// Pool of outbound TCP connections kept alive for reuse, keyed by the address of the peer
+///
+/// Checking a connection out reuses the most recently returned idle connection to the address, which is
+/// the least likely to have been closed by the peer in the meantime, or connects a new one. Idle connections
+/// are checked for having been closed by the peer (readable EOF) or for pending data before they're handed
+/// out. The number of connections per address is limited, checking out waits for a connection to be returned
+/// once the limit is reached.
+///
+/// The pool is thread-safe, the connections are checked out and returned concurrently and the connections
+/// are established without holding the lock. The pool has to outlive the leases.
+class ConnectionPool final {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Options = ConnectionPoolOptions;
+
+    class Lease;
+
+    explicit ConnectionPool(const Options& options = Options());
+
+    ~ConnectionPool() noexcept;
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /// Checks out a connection to the address, waiting for one to be returned if the limit is reached
+    /// \throws Exception in case the connection couldn't be established.
+    Lease acquire(const Address& address);
+
+    /// Checks out a connection to the address, \see acquire()
+    /// \param timeout The maximum time to wait for a connection to be returned or to be established.
+    /// \throws Exception in case no connection was returned in time or if the connection couldn't be
+    /// established in time.
+    template <typename TRep, typename TPeriod>
+    Lease acquire(const Address& address, const std::chrono::duration<TRep, TPeriod> timeout);
+
+    /// Closes the idle connections unused for longer than the idle timeout and those closed by the peer
+    /// \returns The number of connections closed.
+    UnsignedSize evictIdle(const Clock::time_point now = Clock::now());
+
+    /// Returns the number of idle connections
+    UnsignedSize idleCount() const;
+
+    /// Returns the number of connections to the address, both idle and checked out
+    UnsignedSize size(const Address& address) const;
+
+    const Options& options() const noexcept { return mOptions; }
+
+private:
+    struct HostKey {
+        AddressFamily family;
+        Port port;
+        std::uint32_t scope;
+        std::array<Byte, 16> ip;
+
+        explicit HostKey(const Address& address);
+
+        bool operator==(const HostKey& other) const noexcept;
+    };
+
+    struct HostKeyHash {
+        std::size_t operator()(const HostKey& key) const noexcept;
+    };
+
+    struct IdleConnection {
+        Socket<IPProto::TCP> socket;
+        Clock::time_point since;
+    };
+
+    struct Host {
+        std::vector<IdleConnection> idle;
+        UnsignedSize connections = 0;
+        std::condition_variable released;
+    };
+
+    Lease acquireUntil(const Address& address, const Clock::time_point* deadline);
+
+    /// Returns the connection to the pool, or just frees its slot if it's not reusable
+    void release(Host& host, Socket<IPProto::TCP> socket, const bool reusable) noexcept;
+
+    static bool isHealthy(const Socket<IPProto::TCP>& socket) noexcept;
+
+    Options mOptions;
+    mutable std::mutex mMutex;
+    std::unordered_map<HostKey, std::unique_ptr<Host>, HostKeyHash> mHosts;
+};
+
+/// Connection checked out of a ConnectionPool
+///
+/// The connection is returned to the pool as idle once the lease is destroyed. Connections that failed or
+/// whose response wasn't read completely must not be reused, they have to be discarded instead.
+class ConnectionPool::Lease final {
+public:
+    Lease(Lease&& other) noexcept;
+
+    Lease& operator=(Lease&& other) noexcept;
+
+    ~Lease() noexcept { release(); }
+
+    Socket<IPProto::TCP>& operator*() noexcept { return mSocket; }
+
+    Socket<IPProto::TCP>* operator->() noexcept { return &mSocket; }
+
+    /// Tells whether or not the connection was idle in the pool, as opposed to newly established
+    bool isReused() const noexcept { return mReused; }
+
+    /// Returns the connection to the pool as idle
+    void release() noexcept;
+
+    /// Closes the connection instead of returning it to the pool
+    void discard() noexcept;
+
+private:
+    friend class ConnectionPool;
+
+    Lease(ConnectionPool& pool, Host& host, Socket<IPProto::TCP> socket, const bool reused) noexcept;
+
+    ConnectionPool* mPool;
+    Host* mHost;
+    Socket<IPProto::TCP> mSocket;
+    bool mReused;
+};
+
+template <typename TRep, typename TPeriod>
+ConnectionPool::Lease ConnectionPool::acquire(const Address& address,
+                                              const std::chrono::duration<TRep, TPeriod> timeout) {
+    const Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+    return acquireUntil(address, &deadline);
+}
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_CONNECTIONPOOL_H_
@@ -0,0 +1,627 @@
+#ifndef CPPLIBSOCKET_COROUTINE_H_
+#define CPPLIBSOCKET_COROUTINE_H_
+
+#if !defined(__cpp_impl_coroutine) || !defined(__cpp_lib_coroutine)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+#if !defined(__cpp_impl_coroutine) || !defined(__cpp_lib_coroutine)
+#error "cpplibsocket/Coroutine.h requires C++20 coroutines"
+#endif
+
+#include "cpplibsocket/Reactor.h"
+#include "cpplibsocket/Socket.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cpplibsocket {
+
+/// Allocator of coroutine frames, \see FrameAllocator::setCurrent()
+///
+/// Each frame remembers the allocator it was allocated by, so the frames may outlive the allocator being the
+/// current one, but not the allocator itself.
+class FrameAllocator {
+public:
+    virtual ~FrameAllocator() noexcept = default;
+
+    virtual void* allocate(const std::size_t size) = 0;
+
+    virtual void deallocate(void* frame, const std::size_t size) noexcept = 0;
+
+    /// Returns the allocator of the frames of coroutines created by the calling thread
+    ///
+    /// The frames are allocated by operator new unless another allocator is set.
+    static FrameAllocator& current() noexcept;
+
+    /// Sets the allocator of the frames of coroutines created by the calling thread
+    /// \param allocator The allocator, nullptr for the default one.
+    /// \returns The previous allocator.
+    static FrameAllocator* setCurrent(FrameAllocator* allocator) noexcept;
+};
+
+/// Frame allocator keeping the released frames for reuse, so a long-running server stops allocating once its
+/// handlers are warmed up
+///
+/// Frames up to MAX_RECYCLED_SIZE bytes are recycled, larger ones go straight to operator new. The allocator
+/// is not thread-safe, it's meant to be the current allocator of a single event loop thread.
+class RecyclingFrameAllocator final : public FrameAllocator {
+public:
+    static constexpr std::size_t GRANULARITY = 64;
+    static constexpr std::size_t MAX_RECYCLED_SIZE = 64 * GRANULARITY;
+
+    RecyclingFrameAllocator() = default;
+
+    ~RecyclingFrameAllocator() noexcept override {
+        for (std::vector<void*>& frames : mFree) {
+            for (void* frame : frames) {
+                ::operator delete(frame);
+            }
+        }
+    }
+
+    RecyclingFrameAllocator(const RecyclingFrameAllocator&) = delete;
+    RecyclingFrameAllocator& operator=(const RecyclingFrameAllocator&) = delete;
+
+    void* allocate(const std::size_t size) override {
+        const std::size_t bucket = bucketOf(size);
+        if (bucket < mFree.size() && !mFree[bucket].empty()) {
+            void* frame = mFree[bucket].back();
+            mFree[bucket].pop_back();
+            return frame;
+        }
+        return ::operator new(bucket < MAX_RECYCLED_SIZE / GRANULARITY ? (bucket + 1) * GRANULARITY : size);
+    }
+
+    void deallocate(void* frame, const std::size_t size) noexcept override {
+        const std::size_t bucket = bucketOf(size);
+        if (bucket < MAX_RECYCLED_SIZE / GRANULARITY) {
+            try {
+                if (mFree.size() <= bucket) {
+                    mFree.resize(bucket + 1);
+                }
+                mFree[bucket].push_back(frame);
+                return;
+            } catch (const std::bad_alloc&) {
+            }
+        }
+        ::operator delete(frame);
+    }
+
+private:
+    static std::size_t bucketOf(const std::size_t size) noexcept { return (size - 1) / GRANULARITY; }
+
+    std::vector<std::vector<void*>> mFree;
+};
+
+namespace detail {
+
+    class DefaultFrameAllocator final : public FrameAllocator {
+    public:
+        void* allocate(const std::size_t size) override { return ::operator new(size); }
+
+        void deallocate(void* frame, const std::size_t) noexcept override { ::operator delete(frame); }
+    };
+
+    inline DefaultFrameAllocator gDefaultFrameAllocator;
+    inline thread_local FrameAllocator* tCurrentFrameAllocator = &gDefaultFrameAllocator;
+
+    /// Common part of the promises of all the tasks
+    class PromiseBase {
+    public:
+        // The allocator is stored past the end of the frame, aligned for the pointer
+        static void* operator new(const std::size_t size) {
+            FrameAllocator& allocator = FrameAllocator::current();
+            void* frame = allocator.allocate(allocatorOffset(size) + sizeof(FrameAllocator*));
+            *reinterpret_cast<FrameAllocator**>(static_cast<char*>(frame) + allocatorOffset(size)) =
+                &allocator;
+            return frame;
+        }
+
+        static void operator delete(void* frame, const std::size_t size) noexcept {
+            FrameAllocator* allocator =
+                *reinterpret_cast<FrameAllocator**>(static_cast<char*>(frame) + allocatorOffset(size));
+            allocator->deallocate(frame, allocatorOffset(size) + sizeof(FrameAllocator*));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename TPromise>
+            std::coroutine_handle<> await_suspend(const std::coroutine_handle<TPromise> coroutine) noexcept {
+                PromiseBase& promise = coroutine.promise();
+                if (promise.mContinuation) {
+                    return promise.mContinuation;
+                }
+                if (promise.mDetached) {
+                    coroutine.destroy();
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+
+        void unhandled_exception() noexcept {
+            if (mDetached) {
+                // Nobody is there to observe the exception of a spawned task
+                std::terminate();
+            }
+            mException = std::current_exception();
+        }
+
+        void setContinuation(const std::coroutine_handle<> continuation) noexcept {
+            mContinuation = continuation;
+        }
+
+        void detach() noexcept { mDetached = true; }
+
+        void rethrowIfFailed() const {
+            if (mException) {
+                std::rethrow_exception(mException);
+            }
+        }
+
+    private:
+        static constexpr std::size_t allocatorOffset(const std::size_t size) noexcept {
+            constexpr std::size_t alignment = alignof(FrameAllocator*);
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        std::coroutine_handle<> mContinuation;
+        std::exception_ptr mException;
+        bool mDetached = false;
+    };
+
+} // namespace detail
+
+inline FrameAllocator& FrameAllocator::current() noexcept {
+    return *detail::tCurrentFrameAllocator;
+}
+
+inline FrameAllocator* FrameAllocator::setCurrent(FrameAllocator* allocator) noexcept {
+    FrameAllocator* previous = detail::tCurrentFrameAllocator;
+    detail::tCurrentFrameAllocator = allocator ? allocator : &detail::gDefaultFrameAllocator;
+    return previous;
+}
+
+/// Lazily started coroutine producing a value of the given type
+///
+/// The task starts when it's awaited, the awaiting coroutine is resumed once the task completes. Top level
+/// tasks are started by spawn().
+template <typename T = void>
+class [[nodiscard]] Task final {
+public:
+    class promise_type final : public detail::PromiseBase {
+    public:
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        template <typename TValue>
+        void return_value(TValue&& value) {
+            mValue.emplace(std::forward<TValue>(value));
+        }
+
+        T takeValue() {
+            rethrowIfFailed();
+            return std::move(*mValue);
+        }
+
+    private:
+        std::optional<T> mValue;
+    };
+
+    Task(Task&& other) noexcept
+        : mCoroutine(std::exchange(other.mCoroutine, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        std::swap(mCoroutine, other.mCoroutine);
+        return *this;
+    }
+
+    ~Task() noexcept {
+        if (mCoroutine) {
+            mCoroutine.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+        mCoroutine.promise().setContinuation(awaiting);
+        return mCoroutine;
+    }
+
+    T await_resume() { return mCoroutine.promise().takeValue(); }
+
+    /// Gives up the ownership of the coroutine, \see spawn()
+    std::coroutine_handle<promise_type> release() noexcept { return std::exchange(mCoroutine, nullptr); }
+
+private:
+    explicit Task(const std::coroutine_handle<promise_type> coroutine) noexcept
+        : mCoroutine(coroutine) {}
+
+    std::coroutine_handle<promise_type> mCoroutine;
+};
+
+/// Lazily started coroutine producing no value, \see Task
+template <>
+class [[nodiscard]] Task<void> final {
+public:
+    class promise_type final : public detail::PromiseBase {
+    public:
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        void return_void() const noexcept {}
+    };
+
+    Task(Task&& other) noexcept
+        : mCoroutine(std::exchange(other.mCoroutine, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        std::swap(mCoroutine, other.mCoroutine);
+        return *this;
+    }
+
+    ~Task() noexcept {
+        if (mCoroutine) {
+            mCoroutine.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) noexcept {
+        mCoroutine.promise().setContinuation(awaiting);
+        return mCoroutine;
+    }
+
+    void await_resume() { mCoroutine.promise().rethrowIfFailed(); }
+
+    /// Gives up the ownership of the coroutine, \see spawn()
+    std::coroutine_handle<promise_type> release() noexcept { return std::exchange(mCoroutine, nullptr); }
+
+private:
+    explicit Task(const std::coroutine_handle<promise_type> coroutine) noexcept
+        : mCoroutine(coroutine) {}
+
+    std::coroutine_handle<promise_type> mCoroutine;
+};
+
+/// Starts the task, which then runs on its own and destroys itself once it completes
+///
+/// The task runs until it awaits an operation that would block, the rest of it is then driven by the
+/// event loop. Exceptions escaping the task terminate the program.
+inline void spawn(Task<void> task) {
+    const std::coroutine_handle<Task<void>::promise_type> coroutine = task.release();
+    coroutine.promise().detach();
+    coroutine.resume();
+}
+
+/// Suspends coroutines until their sockets are ready, driven by a Reactor (Linux only)
+///
+/// Each socket handle is registered with the reactor edge triggered the first time a coroutine waits for
+/// it and stays registered until it's released, so waiting for a handle that is already registered costs no
+/// system call. At most one coroutine may wait for a handle to become readable and one to become writable
+/// at a time. Like the reactor, it's meant to be driven by a single thread.
+class AsyncIo final {
+public:
+    /// Operation retried whenever its socket becomes ready, until it completes
+    struct Waiter {
+        /// Attempts the operation, returns false if it would block
+        bool (*attempt)(Waiter* waiter) noexcept;
+        std::coroutine_handle<> coroutine;
+    };
+
+    explicit AsyncIo(Reactor& reactor) noexcept
+        : mReactor(reactor) {}
+
+    ~AsyncIo() noexcept {
+        for (const auto& entry : mWaiters) {
+            try {
+                mReactor.remove(entry.first);
+            } catch (const Exception&) {
+            }
+        }
+    }
+
+    AsyncIo(const AsyncIo&) = delete;
+    AsyncIo& operator=(const AsyncIo&) = delete;
+
+    Reactor& reactor() noexcept { return mReactor; }
+
+    /// Registers the waiter to be attempted once the handle is ready for the event
+    /// \param event Either IOEvent::Readable or IOEvent::Writable.
+    /// \throws Exception in case the handle couldn't be registered with the reactor.
+    void wait(const SocketHandle handle, const IOEvent event, Waiter* waiter) {
+        auto found = mWaiters.find(handle);
+        if (found == mWaiters.end()) {
+            mReactor.watch(
+                handle,
+                IOEvent::Readable | IOEvent::Writable,
+                [this, handle](const Reactor::Events events) { dispatch(handle, events); },
+                TriggerMode::Edge);
+            found = mWaiters.emplace(handle, Waiters{}).first;
+        }
+        Waiter*& slot = event == IOEvent::Readable ? found->second.reader : found->second.writer;
+        ASSERT(!slot);
+        slot = waiter;
+    }
+
+    /// Unregisters the handle, it has to be called before the socket is closed
+    ///
+    /// No coroutine may be waiting for the handle.
+    void release(const SocketHandle handle) noexcept {
+        const auto found = mWaiters.find(handle);
+        if (found == mWaiters.end()) {
+            return;
+        }
+        ASSERT(!found->second.reader && !found->second.writer);
+        mWaiters.erase(found);
+        try {
+            mReactor.remove(handle);
+        } catch (const Exception&) {
+        }
+    }
+
+private:
+    struct Waiters {
+        Waiter* reader = nullptr;
+        Waiter* writer = nullptr;
+    };
+
+    void dispatch(const SocketHandle handle, const Reactor::Events events) {
+        const bool failed = events.isSet(IOEvent::Error) || events.isSet(IOEvent::HangUp);
+        if (failed || events.isSet(IOEvent::Readable)) {
+            attempt(handle, &Waiters::reader);
+        }
+        // The reader may have released the handle
+        if (failed || events.isSet(IOEvent::Writable)) {
+            attempt(handle, &Waiters::writer);
+        }
+    }
+
+    void attempt(const SocketHandle handle, Waiter* Waiters::*slot) {
+        const auto found = mWaiters.find(handle);
+        if (found == mWaiters.end()) {
+            return;
+        }
+        Waiter* waiter = found->second.*slot;
+        if (waiter && waiter->attempt(waiter)) {
+            found->second.*slot = nullptr;
+            waiter->coroutine.resume();
+        }
+    }
+
+    Reactor& mReactor;
+    std::unordered_map<SocketHandle, Waiters> mWaiters;
+};
+
+namespace detail {
+
+    /// Awaitable of a socket operation, attempted right away and then whenever the socket is ready
+    ///
+    /// TOperation::operator() returns the result, or std::nullopt if the operation would block. No memory is
+    /// allocated, the awaiter lives in the frame of the awaiting coroutine.
+    template <typename TOperation>
+    class IoAwaiter final : private AsyncIo::Waiter {
+    public:
+        using Result = typename std::invoke_result_t<TOperation&>::value_type;
+
+        IoAwaiter(AsyncIo& io, const SocketHandle handle, const IOEvent event, TOperation operation) noexcept
+            : AsyncIo::Waiter{ &IoAwaiter::attemptOperation, nullptr }
+            , mIo(io)
+            , mHandle(handle)
+            , mEvent(event)
+            , mOperation(std::move(operation)) {}
+
+        bool await_ready() noexcept { return attemptOperation(this); }
+
+        void await_suspend(const std::coroutine_handle<> awaiting) {
+            coroutine = awaiting;
+            mIo.wait(mHandle, mEvent, this);
+        }
+
+        Result await_resume() noexcept { return std::move(*mResult); }
+
+    private:
+        static bool attemptOperation(AsyncIo::Waiter* waiter) noexcept {
+            IoAwaiter* self = static_cast<IoAwaiter*>(waiter);
+            self->mResult = self->mOperation();
+            return self->mResult.has_value();
+        }
+
+        AsyncIo& mIo;
+        SocketHandle mHandle;
+        IOEvent mEvent;
+        TOperation mOperation;
+        std::optional<Result> mResult;
+    };
+
+    template <typename TOperation>
+    IoAwaiter<TOperation> makeIoAwaiter(AsyncIo& io,
+                                        const SocketHandle handle,
+                                        const IOEvent event,
+                                        TOperation operation) noexcept {
+        return IoAwaiter<TOperation>(io, handle, event, std::move(operation));
+    }
+
+    /// Returns nullopt if the result would block, so the operation is attempted again later
+    template <typename T>
+    std::optional<Expected<T, SocketError>> unlessWouldBlock(Expected<T, SocketError> result) noexcept {
+        if (!result && result.error().isWouldBlock()) {
+            return std::nullopt;
+        }
+        return std::optional<Expected<T, SocketError>>(std::move(result));
+    }
+
+} // namespace detail
+
+/// Non-blocking socket whose operations are awaited by coroutines, \see AsyncIo
+///
+/// The operations are attempted right away and only suspend the coroutine if they would block. The socket
+/// must not be destroyed while a coroutine awaits its operation.
+template <IPProto TIPProto>
+class AsyncSocket final {
+public:
+    using SocketType = Socket<TIPProto>;
+
+    /// Takes over the socket and makes it non-blocking
+    /// \throws Exception in case the socket couldn't be made non-blocking.
+    AsyncSocket(AsyncIo& io, SocketType socket)
+        : mIo(&io)
+        , mSocket(std::move(socket)) {
+        mSocket.setBlocked(false);
+    }
+
+    AsyncSocket(AsyncSocket&& other) noexcept = default;
+
+    AsyncSocket& operator=(AsyncSocket&& other) noexcept {
+        if (mSocket.isOpen()) {
+            mIo->release(mSocket.getSocketHandle());
+        }
+        mIo = other.mIo;
+        mSocket = std::move(other.mSocket);
+        return *this;
+    }
+
+    ~AsyncSocket() noexcept {
+        if (mSocket.isOpen()) {
+            mIo->release(mSocket.getSocketHandle());
+        }
+    }
+
+    SocketType& socket() noexcept { return mSocket; }
+
+    /// Accepts a client connection, \see Socket<IPProto::TCP>::tryAccept()
+    /// \returns The non-blocking socket of the client connected or the error.
+    auto asyncAccept() const noexcept
+        requires(TIPProto == IPProto::TCP)
+    {
+        AsyncIo* io = mIo;
+        const SocketType* socket = &mSocket;
+        return detail::makeIoAwaiter(
+            *mIo,
+            mSocket.getSocketHandle(),
+            IOEvent::Readable,
+            [io, socket]() noexcept -> std::optional<Expected<AsyncSocket, SocketError>> {
+                SocketHandle client = Platform::accept(socket->getSocketHandle(), nullptr, true, true);
+                while (client == Platform::SOCKET_NULL) {
+                    const SocketError error = SocketError::last();
+                    if (error.isWouldBlock()) {
+                        return std::nullopt;
+                    }
+                    if (error.category() != SocketError::Category::ConnectionAborted &&
+                        error.category() != SocketError::Category::Interrupted) {
+                        return Expected<AsyncSocket, SocketError>(makeUnexpected(error));
+                    }
+                    // The connection was reset while queued
+                    client = Platform::accept(socket->getSocketHandle(), nullptr, true, true);
+                }
+                return Expected<AsyncSocket, SocketError>(
+                    AsyncSocket(*io, SocketType::adopt(socket->getIpVersion(), client), NonBlocking{}));
+            });
+    }
+
+    /// Connects to a server, \see Socket<IPProto::TCP>::tryConnect()
+    /// \returns Connected or the error.
+    auto asyncConnect(const Address& address) noexcept
+        requires(TIPProto == IPProto::TCP)
+    {
+        const SocketType* socket = &mSocket;
+        return detail::makeIoAwaiter(
+            *mIo,
+            mSocket.getSocketHandle(),
+            IOEvent::Writable,
+            [socket, address, initiated = false]() mutable noexcept
+            -> std::optional<Expected<Connected, SocketError>> {
+                if (initiated) {
+                    return socket->connectResult();
+                }
+                const Expected<Connected, SocketError> result = socket->tryConnect(address);
+                if (!result && result.error().category() == SocketError::Category::InProgress) {
+                    initiated = true;
+                    return std::nullopt;
+                }
+                return result;
+            });
+    }
+
+    /// Sends data to the peer, \see Socket<IPProto::TCP>::trySend()
+    /// \returns The size of the data sent or the error.
+    auto asyncSend(const Byte* data, const UnsignedSize size) const noexcept
+        requires(TIPProto == IPProto::TCP)
+    {
+        const SocketType* socket = &mSocket;
+        return detail::makeIoAwaiter(
+            *mIo, mSocket.getSocketHandle(), IOEvent::Writable, [socket, data, size]() noexcept {
+                return detail::unlessWouldBlock(socket->trySend(data, size));
+            });
+    }
+
+    /// Receives data from the peer, \see Socket<IPProto::TCP>::tryReceive()
+    /// \returns The size of the data received (0 if the peer closed the connection) or the error.
+    auto asyncReceive(Byte* data, const UnsignedSize maxSize) const noexcept
+        requires(TIPProto == IPProto::TCP)
+    {
+        const SocketType* socket = &mSocket;
+        return detail::makeIoAwaiter(
+            *mIo, mSocket.getSocketHandle(), IOEvent::Readable, [socket, data, maxSize]() noexcept {
+                return detail::unlessWouldBlock(socket->tryReceive(data, maxSize));
+            });
+    }
+
+    /// Sends a datagram, \see Socket<IPProto::UDP>::trySendTo()
+    /// \returns The size of the data sent or the error.
+    auto asyncSendTo(const Byte* data, const UnsignedSize size, const Address& address) noexcept
+        requires(TIPProto == IPProto::UDP)
+    {
+        SocketType* socket = &mSocket;
+        return detail::makeIoAwaiter(
+            *mIo, mSocket.getSocketHandle(), IOEvent::Writable, [socket, data, size, &address]() noexcept {
+                return detail::unlessWouldBlock(socket->trySendTo(data, size, address));
+            });
+    }
+
+    /// Receives a datagram, \see Socket<IPProto::UDP>::tryReceiveFrom()
+    /// \returns The size of the data received or the error.
+    auto asyncReceiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) noexcept
+        requires(TIPProto == IPProto::UDP)
+    {
+        SocketType* socket = &mSocket;
+        return detail::makeIoAwaiter(
+            *mIo, mSocket.getSocketHandle(), IOEvent::Readable, [socket, data, maxSize, &source]() noexcept {
+                return detail::unlessWouldBlock(socket->tryReceiveFrom(data, maxSize, source));
+            });
+    }
+
+private:
+    struct NonBlocking {};
+
+    AsyncSocket(AsyncIo& io, SocketType socket, NonBlocking) noexcept
+        : mIo(&io)
+        , mSocket(std::move(socket)) {}
+
+    AsyncIo* mIo;
+    SocketType mSocket;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_COROUTINE_H_
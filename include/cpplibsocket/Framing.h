@@ -0,0 +1,152 @@
+#ifndef CPPLIBSOCKET_FRAMING_H_
+#define CPPLIBSOCKET_FRAMING_H_
+
+#include "cpplibsocket/SocketTcp.h"
+#include "cpplibsocket/common/Endian.h"
+
+#include <vector>
+
+namespace cpplibsocket {
+
+/// Configuration of the length-prefixed framing, \see FrameDecoder and FrameEncoder
+struct FramingOptions {
+    /// The width of the length prefix in bytes, 1, 2, 4 or 8
+    unsigned prefixSize = 4;
+
+    /// The byte order of the length prefix
+    Endian::Type byteOrder = Endian::Type::Big;
+
+    /// The maximum size of the payload of a frame, larger frames are rejected
+    UnsignedSize maxFrameSize = 16 * 1024 * 1024;
+};
+
+/// Result of decoding a frame, \see FrameDecoder::decode()
+struct DecodedFrame {
+    enum class Status : int {
+        /// The frame is complete, the payload is available
+        Complete,
+
+        /// More data is needed to complete the frame
+        Incomplete,
+
+        /// The frame exceeds the maximum frame size, the stream can't be decoded any further
+        TooLarge
+    };
+
+    Status status;
+
+    /// The payload of a complete frame, pointing into the decoded data
+    ConstBuffer payload;
+
+    /// The size of the whole frame including the prefix. Once the prefix is decoded, it's known for
+    /// incomplete frames too, the size of the prefix is reported otherwise. For frames that are too large
+    /// it's the size of the payload declared by the prefix.
+    UnsignedSize size;
+};
+
+/// Decoder of length-prefixed frames
+///
+/// The decoder keeps no state, it decodes the frame at the beginning of contiguous data, e.g. of a RingBuffer
+/// or of a FrameReader. The payload is never copied.
+class FrameDecoder final {
+public:
+    using Options = FramingOptions;
+
+    /// \throws Exception in case the prefix size is not valid.
+    explicit FrameDecoder(const Options& options = Options());
+
+    /// Decodes the frame at the beginning of the data
+    /// \param data The data received.
+    /// \param size The size of the data received.
+    /// \returns The frame, the data of the size of the frame should be consumed once it's complete.
+    DecodedFrame decode(const Byte* data, const UnsignedSize size) const noexcept;
+
+    const Options& options() const noexcept { return mOptions; }
+
+private:
+    Options mOptions;
+};
+
+/// Encoder of length-prefixed frames, batching the frames into vectored writes
+///
+/// The payloads are not copied, only the prefixes are stored by the encoder. All the frames added are sent
+/// by as few system calls as possible, up to Platform::MAX_BUFFER_COUNT / 2 frames per call.
+class FrameEncoder final {
+public:
+    using Options = FramingOptions;
+
+    /// \throws Exception in case the prefix size is not valid.
+    explicit FrameEncoder(const Options& options = Options());
+
+    /// Adds a frame to be sent
+    /// \param payload The payload of the frame, it has to stay valid until the frame is sent.
+    /// \param size The size of the payload.
+    /// \throws Exception in case the payload exceeds the maximum frame size.
+    void add(const Byte* payload, const UnsignedSize size);
+
+    /// Returns the number of frames not sent completely yet
+    UnsignedSize size() const noexcept { return mPrefixes.size() / mOptions.prefixSize; }
+
+    bool empty() const noexcept { return mPrefixes.empty(); }
+
+    /// Returns the buffers of all the frames added, the prefixes interleaved with the payloads
+    ///
+    /// The buffers stay valid until a frame is added or the encoder is cleared.
+    const std::vector<ConstBuffer>& buffers() noexcept;
+
+    /// Sends the frames added, \see Socket<IPProto::TCP>::sendAllv()
+    ///
+    /// On a non-blocking socket the sending stops with WouldBlock once the send buffer is full, the next
+    /// call continues where this one stopped. The encoder is cleared once all the frames are sent.
+    /// \returns The size of the data sent by this call or the error.
+    Expected<UnsignedSize, SocketError> flush(const Socket<IPProto::TCP>& socket) noexcept;
+
+    /// Drops all the frames added
+    void clear() noexcept;
+
+private:
+    Options mOptions;
+    std::vector<Byte> mPrefixes;
+    std::vector<ConstBuffer> mBuffers;
+    BufferCursor mCursor;
+    bool mBuffersValid = true;
+};
+
+/// Incremental reader of length-prefixed frames from a TCP socket
+///
+/// The data is received into a single buffer, as much as the socket has available, and the complete frames
+/// are decoded in place. A partial frame is only moved to the beginning of the buffer when the rest of it
+/// doesn't fit the buffer anymore. The buffer grows up to the size of the largest frame allowed.
+class FrameReader final {
+public:
+    using Options = FramingOptions;
+
+    /// \param options The framing configuration.
+    /// \param capacity The initial capacity of the buffer.
+    /// \throws Exception in case the prefix size is not valid.
+    explicit FrameReader(const Options& options = Options(), const UnsignedSize capacity = 64 * 1024);
+
+    /// Receives the data the socket has available
+    /// \returns The size of the data received (0 if the peer closed the connection) or the error,
+    /// SocketError::noBuffers() if the buffer is full of frames not consumed by next().
+    /// \throws std::bad_alloc in case the buffer couldn't grow.
+    Expected<UnsignedSize, SocketError> receive(const Socket<IPProto::TCP>& socket);
+
+    /// Decodes the next frame received, \see FrameDecoder::decode()
+    ///
+    /// Complete frames are consumed, their payloads stay valid until the next receive().
+    DecodedFrame next() noexcept;
+
+    /// Returns the size of the data received and not consumed yet
+    UnsignedSize size() const noexcept { return mEnd - mBegin; }
+
+private:
+    FrameDecoder mDecoder;
+    std::vector<Byte> mBuffer;
+    UnsignedSize mBegin = 0;
+    UnsignedSize mEnd = 0;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_FRAMING_H_
@@ -0,0 +1,59 @@
+#ifndef CPPLIBSOCKET_HAPPYEYEBALLS_H_
+#define CPPLIBSOCKET_HAPPYEYEBALLS_H_
+
+#include "cpplibsocket/Resolver.h"
+#include "cpplibsocket/SocketTcp.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace cpplibsocket {
+
+/// Configuration of the connection racing, \see connectFirst()
+struct HappyEyeballsOptions {
+    /// The delay before the next address is attempted while the previous attempts are still pending, RFC 8305
+    /// recommends 250 ms
+    std::chrono::milliseconds attemptDelay = std::chrono::milliseconds(250);
+
+    /// The maximum time to wait for any of the attempts to succeed
+    std::chrono::milliseconds timeout = std::chrono::seconds(30);
+
+    /// The options set on the sockets of all the attempts, e.g. opt::NoDelay
+    SocketOptions<IPProto::TCP> socketOptions;
+};
+
+/// Orders the addresses for connection attempts as described by RFC 8305, section 4
+///
+/// The families are interleaved, starting with the family of the first address. The order of the addresses
+/// of the same family is kept.
+std::vector<Address> interleaveAddressFamilies(const std::vector<Address>& addresses);
+
+/// Connects to the first of the addresses that accepts the connection, RFC 8305 (Happy Eyeballs) style
+///
+/// The addresses are attempted in the order of interleaveAddressFamilies(). The next address is attempted
+/// once the previous attempt fails or after the attempt delay, without cancelling the attempts in progress,
+/// so a broken address family costs just the attempt delay. The first connection established wins, the
+/// other attempts are abandoned.
+/// \returns The connected blocking socket.
+/// \throws Exception in case all the attempts failed or if none succeeded in time.
+Socket<IPProto::TCP> connectFirst(const std::vector<Address>& addresses,
+                                  const HappyEyeballsOptions& options = HappyEyeballsOptions());
+
+/// Resolves the host name to the addresses of both the families and connects to the first that accepts
+/// \see connectFirst()
+/// \throws Exception in case the name couldn't be resolved or if no connection succeeded.
+Socket<IPProto::TCP> connectHost(const std::string& hostname,
+                                 const Port port,
+                                 const HappyEyeballsOptions& options = HappyEyeballsOptions());
+
+/// Resolves the host name by the resolver, so the answers are cached, and connects to the first address
+/// that accepts, \see connectHost()
+Socket<IPProto::TCP> connectHost(Resolver& resolver,
+                                 const std::string& hostname,
+                                 const Port port,
+                                 const HappyEyeballsOptions& options = HappyEyeballsOptions());
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_HAPPYEYEBALLS_H_
@@ -0,0 +1,269 @@
+#ifndef CPPLIBSOCKET_IORING_H_
+#define CPPLIBSOCKET_IORING_H_
+
+#include "cpplibsocket/SocketCommon.h"
+#include "cpplibsocket/utils/Optional.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace cpplibsocket {
+
+/// Index of a socket handle registered with IoRing::registerFiles()
+struct FixedFile {
+    explicit FixedFile(const unsigned index_) noexcept
+        : index(index_) {}
+
+    unsigned index;
+};
+
+/// Target of an IoRing operation - either a plain socket handle or a registered (fixed) file
+class IoTarget {
+public:
+    IoTarget(const SocketHandle handle) noexcept
+        : mHandle(handle)
+        , mFixed(false) {}
+
+    IoTarget(const FixedFile file) noexcept
+        : mHandle(static_cast<int>(file.index))
+        , mFixed(true) {}
+
+    int handle() const noexcept { return mHandle; }
+
+    bool isFixed() const noexcept { return mFixed; }
+
+private:
+    int mHandle;
+    bool mFixed;
+};
+
+/// Result of an IoRing operation
+struct IoCompletion {
+    /// Number of bytes transferred, the accepted socket handle or 0 on success, negated errno on failure
+    SignedSize result;
+
+    /// Tells whether a multishot operation is going to produce more completions
+    bool more;
+
+    /// Identifier of the provided buffer the data was received into if the operation selected one
+    Optional<std::uint16_t> bufferId;
+
+    bool isError() const noexcept { return result < 0; }
+
+    int error() const noexcept { return isError() ? static_cast<int>(-result) : 0; }
+};
+
+/// io_uring based asynchronous socket I/O (Linux only)
+///
+/// Operations are queued into the submission ring and submitted in batches by submit() or poll(), which also
+/// dispatches the completions to their handlers. Buffers, messages and addresses passed to the operations
+/// have to stay valid until the completion handler is called.
+/// The ring is not thread-safe and is meant to be driven by a single thread.
+class IoRing final {
+public:
+    using OperationId = std::uint64_t;
+    using CompletionHandler = std::function<void(const IoCompletion&)>;
+
+    /// Set of equally sized buffers the kernel picks from when receiving data (provided buffer ring)
+    ///
+    /// Each buffer picked by the kernel is owned by the completion handler until it's given back by
+    /// recycle().
+    class BufferRing final {
+    public:
+        ~BufferRing() noexcept;
+
+        std::uint16_t groupId() const noexcept { return mGroupId; }
+
+        UnsignedSize bufferSize() const noexcept { return mBufferSize; }
+
+        std::uint16_t count() const noexcept { return mCount; }
+
+        /// Returns the buffer of the given identifier
+        Byte* data(const std::uint16_t bufferId) const noexcept {
+            ASSERT(bufferId < mCount);
+            return mBuffers + bufferId * mBufferSize;
+        }
+
+        /// Hands the buffer back to the kernel
+        void recycle(const std::uint16_t bufferId) noexcept;
+
+    private:
+        friend class IoRing;
+
+        BufferRing(const int ringFd,
+                   const std::uint16_t groupId,
+                   const std::uint16_t count,
+                   const UnsignedSize bufferSize);
+
+        BufferRing(const BufferRing&) = delete;
+        BufferRing& operator=(const BufferRing&) = delete;
+
+        void provide(const std::uint16_t bufferId) noexcept;
+
+        void publish() noexcept;
+
+        int mRingFd;
+        std::uint16_t mGroupId;
+        std::uint16_t mCount;
+        UnsignedSize mBufferSize;
+        io_uring_buf_ring* mRing = nullptr;
+        UnsignedSize mRingSize = 0;
+        Byte* mBuffers = nullptr;
+        std::uint16_t mTail = 0;
+    };
+
+    /// Creates the ring
+    /// \param entries The size of the submission queue. The completion queue is twice as large and also
+    /// limits the number of operations in flight.
+    /// \throws Exception in case the ring couldn't be set up.
+    explicit IoRing(const unsigned entries = 256);
+
+    ~IoRing() noexcept;
+
+    /// Accepts a connection
+    /// \param listener The listening socket.
+    /// \param handler Called with the accepted socket handle.
+    /// \param peer[out] Storage for the peer address or nullptr if unused.
+    OperationId accept(const IoTarget listener, CompletionHandler handler, Address* peer = nullptr);
+
+    /// Accepts connections until the operation fails or is cancelled
+    /// \param listener The listening socket.
+    /// \param handler Called with each accepted socket handle.
+    OperationId acceptMultishot(const IoTarget listener, CompletionHandler handler);
+
+    /// Connects the socket to the given address
+    OperationId connect(const IoTarget socket, const Address& address, CompletionHandler handler);
+
+    /// Sends data to the peer the socket is connected to
+    OperationId
+    send(const IoTarget socket, const Byte* data, const UnsignedSize size, CompletionHandler handler);
+
+    /// Receives data from the peer the socket is connected to
+    OperationId
+    receive(const IoTarget socket, Byte* data, const UnsignedSize maxSize, CompletionHandler handler);
+
+    /// Receives data into a buffer picked by the kernel from the given buffer ring
+    OperationId receive(const IoTarget socket, const BufferRing& buffers, CompletionHandler handler);
+
+    /// Receives data into buffers picked by the kernel until the operation fails or is cancelled
+    ///
+    /// Every completion carries the identifier of the buffer used, which has to be recycled afterwards.
+    OperationId receiveMultishot(const IoTarget socket, const BufferRing& buffers, CompletionHandler handler);
+
+    /// Sends a message, see sendmsg(2)
+    OperationId sendMessage(const IoTarget socket, const msghdr& message, CompletionHandler handler);
+
+    /// Receives a message, see recvmsg(2)
+    OperationId receiveMessage(const IoTarget socket, msghdr& message, CompletionHandler handler);
+
+    /// Requests a cancellation of the given operation
+    ///
+    /// The handler of the cancelled operation is called with -ECANCELED unless it completed already, in which
+    /// case nothing is cancelled, even if the slot of the operation was reused by another one since.
+    void cancel(const OperationId operation);
+
+    /// Registers the socket handles so they can be referred to by FixedFile, avoiding per operation file
+    /// reference counting in the kernel
+    /// \throws Exception in case there are already some files registered or if the registration fails.
+    void registerFiles(const SocketHandle* handles, const unsigned count);
+
+    /// Unregisters all the files registered by registerFiles()
+    void unregisterFiles();
+
+    /// Creates and registers a provided buffer ring
+    /// \param groupId The identifier of the buffer group, unique within this ring.
+    /// \param count The number of buffers, has to be a power of two.
+    /// \param bufferSize The size of each buffer.
+    /// \throws Exception in case the buffers couldn't be allocated or registered.
+    BufferRing&
+    addBufferRing(const std::uint16_t groupId, const std::uint16_t count, const UnsignedSize bufferSize);
+
+    /// Submits all the queued operations without waiting for their completion
+    /// \returns The number of operations submitted.
+    unsigned submit();
+
+    /// Submits the queued operations, waits for at least one completion and dispatches the completions
+    /// \param timeout The maximum time to wait. Negative timeout waits indefinitely.
+    /// \returns The number of completions dispatched.
+    template <typename TRep, typename TPeriod>
+    UnsignedSize poll(const std::chrono::duration<TRep, TPeriod> timeout) {
+        return pollImpl(timeout < timeout.zero()
+                            ? -1
+                            : std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+    }
+
+    /// Submits the queued operations, waits indefinitely for at least one completion and dispatches the
+    /// completions
+    UnsignedSize poll() { return pollImpl(-1); }
+
+    /// Returns the number of operations in flight
+    UnsignedSize pending() const noexcept { return mOperations.size() - mFreeOperations.size(); }
+
+private:
+    struct Operation {
+        CompletionHandler handler;
+        /// Incremented whenever the slot is released, so the identifiers of completed operations go stale
+        std::uint32_t generation = 0;
+        SockLenType addrLen;
+        Address address;
+    };
+
+    IoRing(const IoRing&) = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    void unmap() noexcept;
+
+    io_uring_sqe& prepare(const std::uint8_t opcode, const IoTarget target, const OperationId operation);
+
+    OperationId allocateOperation(CompletionHandler handler);
+
+    void releaseOperation(const OperationId operation) noexcept;
+
+    /// Returns the operation the identifier refers to, nullptr if the operation is no longer in flight
+    Operation* findOperation(const OperationId operation) noexcept;
+
+    int enter(const unsigned toSubmit, const unsigned minComplete, const long long timeoutNs);
+
+    UnsignedSize pollImpl(const long long timeoutNs);
+
+    UnsignedSize dispatch();
+
+    int mRingFd = -1;
+    unsigned mFeatures = 0;
+
+    void* mSqMap = nullptr;
+    UnsignedSize mSqMapSize = 0;
+    void* mCqMap = nullptr;
+    UnsignedSize mCqMapSize = 0;
+    io_uring_sqe* mSqes = nullptr;
+    UnsignedSize mSqesSize = 0;
+
+    unsigned* mSqHead = nullptr;
+    unsigned* mSqTail = nullptr;
+    unsigned* mSqArray = nullptr;
+    unsigned mSqMask = 0;
+    unsigned mSqEntries = 0;
+    unsigned mSqLocalTail = 0;
+    unsigned mSqSubmitted = 0;
+
+    unsigned* mCqHead = nullptr;
+    unsigned* mCqTail = nullptr;
+    io_uring_cqe* mCqes = nullptr;
+    unsigned mCqMask = 0;
+
+    bool mFilesRegistered = false;
+    std::vector<Operation> mOperations;
+    std::vector<std::uint32_t> mFreeOperations;
+    std::vector<std::unique_ptr<BufferRing>> mBufferRings;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_IORING_H_
@@ -0,0 +1,94 @@
+#ifndef CPPLIBSOCKET_LISTENERGROUP_H_
+#define CPPLIBSOCKET_LISTENERGROUP_H_
+
+#include "cpplibsocket/Socket.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cpplibsocket {
+
+/// Group of sockets bound to the same address and port with SO_REUSEPORT
+///
+/// The kernel balances the incoming connections (TCP) or datagrams (UDP) among the sockets of the group, so
+/// each shard can be served by its own worker thread without sharing a single accept or receive queue.
+/// The sockets are not shared between the shards, the group itself is not thread-safe.
+template <IPProto TIPProto>
+class ListenerGroup final {
+public:
+    using SocketType = Socket<TIPProto>;
+    using Iterator = typename std::vector<SocketType>::iterator;
+
+    /// Creates the shards and binds them to the given address
+    /// \param ipVersion The IP version of the sockets.
+    /// \param shards The number of sockets in the group, typically the number of worker threads.
+    /// \param ip The IP address to bind, empty to bind all interfaces.
+    /// \param port The port to bind. If the port is 0, any free local port will be used for all the shards.
+    /// \throws Exception in case shards is 0, if the sockets couldn't be created or bound.
+    ListenerGroup(const IPVer ipVersion, const unsigned shards, const std::string& ip, const Port port = 0)
+        : mPort(port) {
+        if (shards == 0) {
+            throw Exception(FUNC_NAME, "The group has to have at least one shard");
+        }
+        mSockets.reserve(shards);
+        for (unsigned i = 0; i < shards; ++i) {
+            SocketType socket(ipVersion);
+            socket.setReusePort();
+            mPort = socket.bind(ip, mPort);
+            mSockets.push_back(std::move(socket));
+        }
+    }
+
+    /// Starts listening on all the shards
+    ///
+    /// The shards join the kernel reuseport group in this order, which determines their indices for
+    /// steerByCpu().
+    /// \param backlogSize The listen queue size of each shard.
+    /// \throws Exception in case any of the shards couldn't start listening.
+    template <IPProto T = TIPProto, typename = typename std::enable_if<T == IPProto::TCP>::type>
+    void listen(const int backlogSize) {
+        for (SocketType& socket : mSockets) {
+            socket.listen(backlogSize);
+        }
+    }
+
+    /// Steers the connections and datagrams to the shard of the index equal to the CPU which handled them
+    /// by the network stack, modulo the number of shards (SO_ATTACH_REUSEPORT_CBPF, Linux only)
+    ///
+    /// Pinning the worker thread of each shard to the matching CPU then keeps the whole processing of a flow
+    /// on a single CPU. For TCP it has to be called after listen().
+    /// \throws Exception in case the program couldn't be attached.
+    void steerByCpu() {
+        ASSERT(!mSockets.empty());
+        if (!Platform::attachReusePortCpuSteering(mSockets.front().getSocketHandle(), size())) {
+            throw Exception(
+                FUNC_NAME, "Couldn't attach reuseport steering program - ", getLastErrorFormatted());
+        }
+    }
+
+    /// Returns the port all the shards are bound to
+    Port getPort() const noexcept { return mPort; }
+
+    unsigned size() const noexcept { return static_cast<unsigned>(mSockets.size()); }
+
+    SocketType& operator[](const unsigned shard) noexcept {
+        ASSERT(shard < mSockets.size());
+        return mSockets[shard];
+    }
+
+    Iterator begin() noexcept { return mSockets.begin(); }
+
+    Iterator end() noexcept { return mSockets.end(); }
+
+    /// Takes the ownership of all the shards, e.g. to move them to their worker threads
+    std::vector<SocketType> release() noexcept { return std::move(mSockets); }
+
+private:
+    Port mPort;
+    std::vector<SocketType> mSockets;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_LISTENERGROUP_H_
@@ -0,0 +1,186 @@
+#ifndef CPPLIBSOCKET_REACTOR_H_
+#define CPPLIBSOCKET_REACTOR_H_
+
+#include "cpplibsocket/SocketBase.h"
+#include "cpplibsocket/TimerWheel.h"
+#include "cpplibsocket/utils/Flags.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct epoll_event;
+
+namespace cpplibsocket {
+
+/// Readiness events reported by the Reactor
+enum class IOEvent : int { Readable, Writable, Error, HangUp };
+
+/// Determines how the readiness is reported for a registered handle
+///
+/// Level triggered handles are reported on every poll as long as they are ready. Edge triggered handles
+/// are only reported when their readiness changes, so the handler has to drain the socket until it
+/// reports WouldBlock.
+enum class TriggerMode : int { Level, Edge };
+
+/// epoll based readiness event loop (Linux only)
+///
+/// Dispatches readiness of registered socket handles to their handlers. Sockets can either be added with
+/// their ownership transferred to the reactor (\see add()), or just watched by their handle (\see watch()).
+/// Registrations may be added, modified and removed from within the handlers.
+/// Apart from stop(), the reactor is not thread-safe and is meant to be driven by a single thread.
+class Reactor final {
+public:
+    using Events = utils::Flags<IOEvent>;
+    using Handler = std::function<void(Events)>;
+
+    /// Creates the reactor
+    /// \param maxEvents The maximum number of events dispatched in a single poll.
+    /// \throws Exception in case the epoll instance couldn't be created.
+    explicit Reactor(const UnsignedSize maxEvents = 256);
+
+    ~Reactor() noexcept;
+
+    /// Registers a socket handle without taking the ownership of the socket
+    ///
+    /// The handle has to be unregistered with remove() before the socket is closed.
+    /// \param handle The socket handle to watch.
+    /// \param interest The events the handler is interested in. Error and HangUp are always reported.
+    /// \param handler The handler called whenever the handle is ready.
+    /// \param mode Whether the readiness is reported level or edge triggered.
+    /// \throws Exception in case the handle is already registered or if the registration fails.
+    void watch(const SocketHandle handle,
+               const Events interest,
+               Handler handler,
+               const TriggerMode mode = TriggerMode::Level);
+
+    /// Transfers the ownership of the socket to the reactor and registers it
+    ///
+    /// The socket is closed when it's removed from the reactor or when the reactor is destroyed.
+    /// \param socket The socket to take over.
+    /// \param interest The events the handler is interested in. Error and HangUp are always reported.
+    /// \param handler The handler called whenever the socket is ready.
+    /// \param mode Whether the readiness is reported level or edge triggered.
+    /// \returns Reference to the socket now owned by the reactor.
+    /// \throws Exception in case the socket is not open or if the registration fails.
+    template <typename TSocket>
+    TSocket& add(TSocket socket,
+                 const Events interest,
+                 std::function<void(TSocket&, Events)> handler,
+                 const TriggerMode mode = TriggerMode::Level) {
+        static_assert(std::is_base_of<SocketBase, TSocket>::value, "TSocket has to be a socket");
+        if (!socket.isOpen()) {
+            throw Exception(FUNC_NAME, "The socket is not open");
+        }
+        std::unique_ptr<TSocket> owned(new TSocket(std::move(socket)));
+        TSocket* raw = owned.get();
+        Registration& registration = registerHandle(
+            raw->getSocketHandle(),
+            interest,
+            [raw, handler = std::move(handler)](const Events events) { handler(*raw, events); },
+            mode);
+        registration.socket = std::move(owned);
+        return *raw;
+    }
+
+    /// Changes the events the handler of the given handle is interested in
+    /// \throws Exception in case the handle is not registered or if the modification fails.
+    void modify(const SocketHandle handle, const Events interest);
+
+    /// Unregisters the given handle
+    ///
+    /// If the reactor owns the socket, the socket is closed.
+    /// \throws Exception in case the handle is not registered.
+    void remove(const SocketHandle handle);
+
+    /// Unregisters the given handle and gives up the ownership of its socket
+    /// \returns The socket owned by the reactor or nullptr if the handle was just watched.
+    /// \throws Exception in case the handle is not registered.
+    std::unique_ptr<SocketBase> release(const SocketHandle handle);
+
+    /// Tells whether or not the given handle is registered
+    bool contains(const SocketHandle handle) const noexcept;
+
+    /// Returns the number of registered handles
+    UnsignedSize size() const noexcept { return mRegistrations.size(); }
+
+    /// Waits for the readiness of the registered handles and dispatches it to their handlers
+    /// \param timeout The maximum time to wait. Negative timeout waits indefinitely.
+    /// \returns The number of events dispatched.
+    /// \throws Exception in case waiting for the events fails. Exceptions thrown from the handlers are
+    /// propagated.
+    template <typename TRep, typename TPeriod>
+    UnsignedSize poll(const std::chrono::duration<TRep, TPeriod> timeout) {
+        return pollImpl(toTimeoutMs(timeout));
+    }
+
+    /// Waits indefinitely for the readiness of the registered handles and dispatches it to their handlers
+    /// \copydetails poll(const std::chrono::duration<TRep, TPeriod>)
+    UnsignedSize poll() { return pollImpl(-1); }
+
+    /// Dispatches the events until stop() is called
+    void run();
+
+    /// Dispatches the events and expires the timers until stop() is called
+    ///
+    /// The timeout of each poll is the time until the wheel needs to be advanced, so no timer file
+    /// descriptor is needed and re-arming the timers costs no system call.
+    void run(TimerWheel& timers);
+
+    /// Makes run() return after the currently dispatched events
+    ///
+    /// This function is thread-safe and may be called from any thread.
+    void stop() noexcept;
+
+private:
+    struct Registration {
+        SocketHandle handle;
+        Handler handler;
+        std::unique_ptr<SocketBase> socket;
+        TriggerMode mode;
+        bool active = true;
+    };
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    Registration& registerHandle(const SocketHandle handle,
+                                 const Events interest,
+                                 Handler handler,
+                                 const TriggerMode mode);
+
+    std::unique_ptr<Registration> unregisterHandle(const SocketHandle handle);
+
+    template <typename TRep, typename TPeriod>
+    static int toTimeoutMs(const std::chrono::duration<TRep, TPeriod> timeout) {
+        if (timeout < timeout.zero()) {
+            return -1;
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout);
+        if (ms < timeout) {
+            ++ms; // Round up so we don't spin on sub-millisecond timeouts
+        }
+        return static_cast<int>(
+            std::min<std::chrono::milliseconds::rep>(ms.count(), std::numeric_limits<int>::max()));
+    }
+
+    UnsignedSize pollImpl(const int timeoutMs);
+
+    int mEpollFd = -1;
+    int mWakeupFd = -1;
+    std::atomic<bool> mStopRequested{ false };
+    bool mDispatching = false;
+    UnsignedSize mMaxEvents;
+    std::unique_ptr<epoll_event[]> mEvents;
+    std::unordered_map<SocketHandle, std::unique_ptr<Registration>> mRegistrations;
+    std::vector<std::unique_ptr<Registration>> mRetired;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_REACTOR_H_
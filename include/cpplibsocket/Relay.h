@@ -0,0 +1,105 @@
+#ifndef CPPLIBSOCKET_RELAY_H_
+#define CPPLIBSOCKET_RELAY_H_
+
+#include "cpplibsocket/Reactor.h"
+#include "cpplibsocket/SocketTcp.h"
+
+namespace cpplibsocket {
+
+/// Configuration of a Relay
+struct RelayOptions {
+    /// The capacity requested for the pipe of each direction, which limits the data in flight before the
+    /// backpressure stops receiving, rounded up to a power of two pages by the system
+    UnsignedSize pipeCapacity = 256 * 1024;
+};
+
+/// Forwards data between two connected sockets in both directions without copying it (Linux only)
+///
+/// The data is moved from the receiving socket into a pipe and from the pipe into the sending socket with
+/// splice(), so it never enters user space. Each direction has its own pipe, which holds the data the
+/// destination can't take yet. While the pipe is full, the source is not read from, so a slow receiver
+/// slows down the sender on the other side instead of growing any buffer.
+///
+/// The end of the data received from one side is forwarded as a shutdown of sending (half-close) to the
+/// other side once the pipe is drained, the other direction keeps working until it ends as well.
+///
+/// The sockets are set non-blocking and the relay is pumped whenever either of them becomes ready, e.g.
+/// from a Reactor handler. The sockets have to outlive the relay, which isn't thread-safe.
+class Relay final {
+public:
+    using Options = RelayOptions;
+
+    /// Creates the relay between the sockets
+    /// \throws Exception in case either of the sockets is not open or if the pipes couldn't be created.
+    Relay(Socket<IPProto::TCP>& first, Socket<IPProto::TCP>& second, const Options& options = Options());
+
+    ~Relay() noexcept;
+
+    Relay(const Relay&) = delete;
+    Relay& operator=(const Relay&) = delete;
+
+    /// Forwards the data in both directions until the sockets would block
+    /// \returns The size of the data forwarded by this call or the first error of either socket, after
+    /// which the connections should be closed.
+    Expected<UnsignedSize, SocketError> pump() noexcept;
+
+    /// Tells whether or not both the directions ended and all the data was forwarded
+    bool finished() const noexcept { return mToSecond.finished() && mToFirst.finished(); }
+
+    /// Returns the size of the data forwarded from the first socket to the second one
+    UnsignedSize forwardedToSecond() const noexcept { return mToSecond.forwarded; }
+
+    /// Returns the size of the data forwarded from the second socket to the first one
+    UnsignedSize forwardedToFirst() const noexcept { return mToFirst.forwarded; }
+
+    /// Returns the size of the data received from the first socket and not yet sent to the second one
+    UnsignedSize bufferedToSecond() const noexcept { return mToSecond.buffered; }
+
+    /// Returns the size of the data received from the second socket and not yet sent to the first one
+    UnsignedSize bufferedToFirst() const noexcept { return mToFirst.buffered; }
+
+    /// Returns the events the first socket has to be watched for before pumping again
+    Reactor::Events firstInterest() const noexcept { return interest(mToSecond, mToFirst); }
+
+    /// Returns the events the second socket has to be watched for before pumping again
+    Reactor::Events secondInterest() const noexcept { return interest(mToFirst, mToSecond); }
+
+private:
+    /// One direction of the relay
+    struct Flow {
+        SocketHandle from = Platform::SOCKET_NULL;
+        SocketHandle to = Platform::SOCKET_NULL;
+        int pipe[2] = { -1, -1 };
+        UnsignedSize capacity = 0;
+        UnsignedSize buffered = 0;
+        UnsignedSize forwarded = 0;
+        bool ended = false;
+        bool shutDown = false;
+        /// The pipe may be full, it holds partially filled pages of the received data in its slots, so the
+        /// size of the data buffered doesn't tell
+        bool stalled = false;
+
+        bool finished() const noexcept { return ended && buffered == 0; }
+
+        /// Tells whether or not there's room in the pipe for data to be received
+        bool receiving() const noexcept { return !ended && !stalled && buffered < capacity; }
+    };
+
+    static void openPipe(Flow& flow, const UnsignedSize capacity);
+
+    static void closePipe(Flow& flow) noexcept;
+
+    /// Forwards the data of the flow until either of its ends would block
+    static Expected<UnsignedSize, SocketError> pump(Flow& flow) noexcept;
+
+    /// Returns the events of the socket that's the source of the outgoing flow and the destination of the
+    /// incoming one
+    static Reactor::Events interest(const Flow& outgoing, const Flow& incoming) noexcept;
+
+    Flow mToSecond;
+    Flow mToFirst;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_RELAY_H_
@@ -0,0 +1,183 @@
+#ifndef CPPLIBSOCKET_RESOLVER_H_
+#define CPPLIBSOCKET_RESOLVER_H_
+
+#include "cpplibsocket/SocketCommon.h"
+#include "cpplibsocket/utils/Expected.h"
+#include "cpplibsocket/utils/Optional.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cpplibsocket {
+
+/// Reason of a failed name resolution
+struct ResolveError {
+    enum class Status : int {
+        /// The name doesn't exist or has no address of the requested family, the result is cached
+        NotFound,
+
+        /// Temporary failure of the name server, the result is not cached
+        TemporaryFailure,
+
+        /// Any other failure, the result is not cached
+        Failure,
+
+        /// The resolver was destroyed before the lookup started
+        Cancelled
+    };
+
+    Status status;
+    std::string message;
+};
+
+/// All the addresses the name resolves to (with port 0), or the reason of the failure
+using ResolveResult = Expected<std::vector<Address>, ResolveError>;
+
+/// Source of the name resolution answers used by Resolver
+///
+/// Lookups are called concurrently from the resolver worker threads.
+class ResolverSource {
+public:
+    struct Answer {
+        ResolveResult result;
+
+        /// Time to live of the answer, NullOptional to use the resolver default
+        Optional<std::chrono::seconds> ttl;
+    };
+
+    virtual ~ResolverSource() = default;
+
+    /// Resolves the name to addresses of the given version, or of both versions if ipVersion is NullOptional
+    virtual Answer lookup(const std::string& hostname, const Optional<IPVer> ipVersion) = 0;
+};
+
+/// Source using the system resolver (getaddrinfo)
+///
+/// The system resolver doesn't report the record TTLs, so the resolver defaults apply.
+class SystemResolverSource final : public ResolverSource {
+public:
+    Answer lookup(const std::string& hostname, const Optional<IPVer> ipVersion) override;
+};
+
+/// Source answering from a hosts(5) formatted table
+class HostsResolverSource final : public ResolverSource {
+public:
+    /// Parses the table, lines with invalid addresses are skipped
+    explicit HostsResolverSource(std::istream& hosts);
+
+    /// Parses the given hosts file
+    /// \throws Exception in case the file couldn't be opened.
+    static std::unique_ptr<HostsResolverSource> fromFile(const std::string& path);
+
+    Answer lookup(const std::string& hostname, const Optional<IPVer> ipVersion) override;
+
+private:
+    std::unordered_map<std::string, std::vector<Address>> mHosts;
+};
+
+/// Configuration of Resolver
+struct ResolverOptions {
+    /// The number of worker threads
+    unsigned workers = 2;
+
+    /// Time to live of successful answers the source doesn't provide a TTL for
+    std::chrono::seconds defaultTtl = std::chrono::seconds(30);
+
+    /// Time to live of answers that the name doesn't exist
+    std::chrono::seconds negativeTtl = std::chrono::seconds(5);
+
+    /// The maximum number of cached answers
+    UnsignedSize maxEntries = 1024;
+};
+
+/// Asynchronous name resolver with a TTL-aware cache
+///
+/// Lookups run on a pool of worker threads. Concurrent lookups of the same name are coalesced into a single
+/// query of the source. Successful answers are cached for their TTL, answers that the name doesn't exist
+/// are cached for the negative TTL.
+class Resolver final {
+public:
+    using Callback = std::function<void(const ResolveResult&)>;
+    using Clock = std::chrono::steady_clock;
+    using Options = ResolverOptions;
+
+    /// Creates a resolver using the system resolver
+    Resolver();
+
+    /// \param source The source of the answers, SystemResolverSource if nullptr.
+    /// \param options The resolver configuration.
+    explicit Resolver(std::unique_ptr<ResolverSource> source, const Options& options = Options());
+
+    /// Waits for the lookups in progress, the queued ones are completed as cancelled
+    ~Resolver() noexcept;
+
+    /// Resolves the name asynchronously
+    ///
+    /// \param hostname The name to resolve.
+    /// \param callback Called with the result, either right away if the answer is cached, or from one of the
+    /// worker threads. An exception thrown by the callback propagates to the caller in the former case and is
+    /// discarded in the latter.
+    /// \param ipVersion The address family to resolve, NullOptional for both.
+    void resolve(const std::string& hostname,
+                 Callback callback,
+                 const Optional<IPVer> ipVersion = NullOptional);
+
+    /// Resolves the name asynchronously
+    std::future<ResolveResult> resolve(const std::string& hostname,
+                                       const Optional<IPVer> ipVersion = NullOptional);
+
+    /// Returns the cached answer if there is a valid one
+    Optional<ResolveResult> cached(const std::string& hostname,
+                                   const Optional<IPVer> ipVersion = NullOptional) const;
+
+    /// Drops all the cached answers
+    void clearCache();
+
+private:
+    struct CacheEntry {
+        ResolveResult result;
+        Clock::time_point expiry;
+    };
+
+    struct Query {
+        std::string hostname;
+        Optional<IPVer> ipVersion;
+        std::vector<Callback> callbacks;
+    };
+
+    Resolver(const Resolver&) = delete;
+    Resolver& operator=(const Resolver&) = delete;
+
+    static std::string makeKey(const std::string& hostname, const Optional<IPVer> ipVersion);
+
+    void work();
+
+    ResolverSource::Answer lookup(const std::string& hostname, const Optional<IPVer> ipVersion) noexcept;
+
+    void store(const std::string& key, const ResolverSource::Answer& answer);
+
+    std::unique_ptr<ResolverSource> mSource;
+    Options mOptions;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mQueued;
+    bool mStopping = false;
+    std::unordered_map<std::string, CacheEntry> mCache;
+    std::unordered_map<std::string, Query> mQueries;
+    std::deque<std::string> mQueue;
+    std::vector<std::thread> mWorkers;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_RESOLVER_H_
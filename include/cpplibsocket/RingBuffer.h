@@ -0,0 +1,85 @@
+#ifndef CPPLIBSOCKET_RINGBUFFER_H_
+#define CPPLIBSOCKET_RINGBUFFER_H_
+
+#include "cpplibsocket/SocketCommon.h"
+
+namespace cpplibsocket {
+
+/// Byte ring buffer whose memory is mapped twice back-to-back (Linux only)
+///
+/// The second mapping mirrors the first one, so both the data stored and the free space are always
+/// contiguous in memory, however the ring wraps around. Partial messages can be parsed in place and never
+/// have to be moved to the beginning of the buffer. The capacity is fixed, so is the memory footprint.
+/// The buffer is not thread-safe.
+class RingBuffer final {
+public:
+    /// Creates the buffer
+    /// \param capacity The minimum capacity, rounded up to a multiple of the page size.
+    /// \throws Exception in case the memory couldn't be mapped.
+    explicit RingBuffer(const UnsignedSize capacity);
+
+    ~RingBuffer() noexcept;
+
+    RingBuffer(RingBuffer&& other) noexcept;
+
+    RingBuffer& operator=(RingBuffer&& other) noexcept;
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    UnsignedSize capacity() const noexcept { return mCapacity; }
+
+    /// Returns the size of the data stored
+    UnsignedSize size() const noexcept { return mSize; }
+
+    /// Returns the size of the free space
+    UnsignedSize available() const noexcept { return mCapacity - mSize; }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+    bool full() const noexcept { return mSize == mCapacity; }
+
+    /// Returns the data stored, contiguous in memory
+    const Byte* data() const noexcept { return mData + mRead; }
+
+    /// Returns the beginning of the free space, contiguous in memory
+    Byte* space() noexcept { return mData + mRead + mSize; }
+
+    /// Returns the data stored as a piece of data to be sent
+    ConstBuffer readable() const noexcept { return { data(), size() }; }
+
+    /// Returns the free space as the storage for data to be received
+    MutableBuffer writable() noexcept { return { space(), available() }; }
+
+    /// Appends the given size of data written to the free space
+    void commit(const UnsignedSize size) noexcept {
+        ASSERT(size <= available());
+        mSize += size;
+    }
+
+    /// Drops the given size of data from the beginning of the data stored
+    void consume(const UnsignedSize size) noexcept {
+        ASSERT(size <= mSize);
+        mRead += size;
+        if (mRead >= mCapacity) {
+            mRead -= mCapacity;
+        }
+        mSize -= size;
+    }
+
+    /// Drops all the data stored
+    void clear() noexcept {
+        mRead = 0;
+        mSize = 0;
+    }
+
+private:
+    Byte* mData = nullptr;
+    UnsignedSize mCapacity = 0;
+    UnsignedSize mRead = 0;
+    UnsignedSize mSize = 0;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_RINGBUFFER_H_
@@ -3,5 +3,6 @@
 
 #include "cpplibsocket/SocketUdp.h"
 #include "cpplibsocket/SocketTcp.h"
+#include "cpplibsocket/SocketUnix.h"
 
 #endif // CPPLIBSOCKET_SOCKET_H_
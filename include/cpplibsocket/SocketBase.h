@@ -1,7 +1,9 @@
 #ifndef CPPLIBSOCKET_SOCKETBASE_H_
 #define CPPLIBSOCKET_SOCKETBASE_H_
 
+#include "cpplibsocket/BufferPool.h"
 #include "cpplibsocket/SocketCommon.h"
+#include "cpplibsocket/SocketOptions.h"
 #include "cpplibsocket/common/Assert.h"
 #include "cpplibsocket/utils/AnyOf.h"
 #include "cpplibsocket/utils/Expected.h"
@@ -9,6 +11,9 @@
 
 namespace cpplibsocket {
 
+/// Result of a successful tryConnect() of the connection-oriented sockets
+struct Connected {};
+
 /// Base for actual Socket specializations
 ///
 /// Contains basic functions for socket manipulations.
@@ -57,6 +62,13 @@ public:
     /// \throws Exception in case the socket is not open or if setting the property fails.
     void setBlocked(const bool blocked = true);
 
+    /// Shuts down the given directions of the connection, the socket stays open
+    ///
+    /// Shutting down TX sends EOF to the peer (half-close) while the data can still be received.
+    /// \param direction The directions to shut down.
+    /// \throws Exception in case the socket is not open or if the shutdown fails.
+    void shutdown(const utils::Flags<Direction> direction = Direction::TX | Direction::RX);
+
     /// Sets timeout for receiving data from the socket
     /// \param timeout The timeout to set.
     /// \direction The direction to set the timeout for.
@@ -75,8 +87,35 @@ public:
         }
     }
 
+    /// Allows multiple sockets to bind the same address and port (SO_REUSEPORT)
+    ///
+    /// The kernel balances the incoming connections or datagrams among all the sockets bound with this option
+    /// set, \see ListenerGroup. Has to be set before the socket is bound.
+    /// \throws Exception in case the socket is not open or if setting the property fails.
+    void setReusePort(const bool enabled = true);
+
+    /// Enables or disables zero-copy sends (SO_ZEROCOPY, Linux only)
+    ///
+    /// Zero-copy sends pin the user data instead of copying it into the kernel, so the data must not be
+    /// modified or released until the kernel notifies it's no longer in use (\see readZeroCopyCompletion()).
+    /// The notifications are delivered through the socket error queue, which reports the socket ready with
+    /// an error event (e.g. IOEvent::Error of the Reactor).
+    /// \throws Exception in case the socket is not open or if setting the property fails.
+    void setZeroCopy(const bool enabled = true);
+
+    /// Tells whether or not zero-copy sends are enabled
+    bool isZeroCopyEnabled() const noexcept { return mZeroCopyEnabled; }
+
+    /// Reads a notification about completed zero-copy sends without blocking
+    /// \returns The completion read or WouldBlock if there's no notification queued.
+    /// \throws Exception in case the socket is not open or if reading the notification fails.
+    Expected<ZeroCopyCompletion, WouldBlock> readZeroCopyCompletion();
+
     SocketHandle getSocketHandle() const noexcept { return mSocketHandle; }
 
+    /// Returns the IP version of the socket, IPV4 for the Unix domain sockets, which have none
+    IPVer getIpVersion() const noexcept { return mIpVersion; }
+
     Endpoint getEndpoint() const;
 
 protected:
@@ -96,9 +135,30 @@ protected:
     /// \throws Exception in case there was some error while creating the structure.
     Address createAddr(const std::string& hostIp, const Port port) const;
 
+    /// Sets the option, \see SocketOptions
+    /// \throws Exception in case the socket is not open, the option doesn't apply to the IP version of the
+    /// socket or if setting the option fails.
+    void setOption(const SocketOptionValue& option);
+
+    /// Sets all the options in order
+    /// \throws Exception in case any of the options couldn't be set.
+    void setOptions(const std::vector<SocketOptionValue>& options);
+
+    /// Returns the native value of the option, the value of the argument is ignored
+    /// \throws Exception in case the socket is not open, the option doesn't apply to the IP version of the
+    /// socket or if getting the option fails.
+    int getOption(const SocketOptionValue& option) const;
+
+    /// Sends the data without copying, \see setZeroCopy()
+    /// \param address The destination address or nullptr for connected sockets.
+    Expected<ZeroCopySend, WouldBlock>
+    sendZeroCopy(const Byte* data, const UnsignedSize size, const Address* address);
+
     SocketHandle mSocketHandle = Platform::SOCKET_NULL;
     IPProto mIpProtocol;
     IPVer mIpVersion;
+    bool mZeroCopyEnabled = false;
+    std::uint32_t mZeroCopyNextId = 0;
 
 private:
     SocketBase(const SocketBase&) = delete;
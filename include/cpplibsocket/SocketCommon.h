@@ -4,20 +4,27 @@
 #include "cpplibsocket/common/Assert.h"
 #include "cpplibsocket/common/Exception.h"
 #include "cpplibsocket/common/common.h"
+#include "cpplibsocket/utils/InlineString.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstring>
+#include <ostream>
+#include <string>
 #include <type_traits>
 
 #ifdef _WIN32
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
 #include <WS2tcpip.h>
+#include <afunix.h>
 #include <winsock2.h>
 #else
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #endif
 
 namespace cpplibsocket {
@@ -25,17 +32,20 @@ namespace cpplibsocket {
 #ifdef _WIN32
 using SockLenType = int;
 using SocketHandle = SOCKET;
+using FileHandle = HANDLE;
 using AddressFamily = ADDRESS_FAMILY;
 #else
 using SockLenType = socklen_t;
 using SocketHandle = int;
+using FileHandle = int;
 using AddressFamily = int;
 #endif
 
 using UnsignedSize = std::size_t;
 using SignedSize = typename std::make_signed<UnsignedSize>::type;
 
-enum class IPProto : int { TCP, UDP };
+/// The transport of a socket, the Unix* ones are the Unix domain (AF_UNIX) sockets of the respective type
+enum class IPProto : int { TCP, UDP, UnixStream, UnixDatagram, UnixSeqPacket };
 
 enum class IPVer : int { IPV4, IPV6 };
 
@@ -43,16 +53,94 @@ enum class Direction : int { TX, RX };
 
 struct WouldBlock {};
 
+/// Error of a socket operation
+///
+/// Carries just the native error code and its category. The message is only formatted when asked for, so
+/// the error is cheap to return from the data path.
+class SocketError {
+public:
+    enum class Category : int {
+        /// The operation would block on a non-blocking socket
+        WouldBlock,
+
+        /// The operation was interrupted by a signal
+        Interrupted,
+
+        /// A non-blocking connect was initiated and completes asynchronously
+        InProgress,
+
+        ConnectionReset,
+        ConnectionRefused,
+        ConnectionAborted,
+
+        /// The connection was shut down for writing
+        BrokenPipe,
+
+        TimedOut,
+        NotConnected,
+
+        /// The socket is not open
+        NotOpen,
+
+        /// Any other error, \see code()
+        Other
+    };
+
+    /// Creates the error from a native error code (errno or WSAGetLastError())
+    explicit SocketError(const int code) noexcept;
+
+    /// Returns the error of the last failed operation of the calling thread
+    static SocketError last() noexcept;
+
+    /// Returns the error reported by operations on sockets that are not open
+    static SocketError notOpen() noexcept;
+
+    /// Returns the error reported when no buffer could be taken from a BufferPool
+    static SocketError noBuffers() noexcept;
+
+    /// Returns the error reported when an operation doesn't complete in time
+    static SocketError timedOut() noexcept;
+
+    /// Returns the error reported when the address family doesn't apply to the socket
+    static SocketError unsupportedFamily() noexcept;
+
+    /// Returns the error reported when an argument is out of its range
+    static SocketError invalidArgument() noexcept;
+
+    int code() const noexcept { return mCode; }
+
+    Category category() const noexcept { return mCategory; }
+
+    bool isWouldBlock() const noexcept { return mCategory == Category::WouldBlock; }
+
+    /// Formats the error message
+    std::string message() const;
+
+    friend std::ostream& operator<<(std::ostream& o, const SocketError& error) {
+        return o << error.message();
+    }
+
+private:
+    int mCode;
+    Category mCategory;
+};
+
+/// Properties of sockets created by Socket<IPProto::TCP>::acceptMany()
+enum class AcceptFlag : int { NonBlocking, CloseOnExec };
+
+/// Textual representation of an IP address stored inline, so endpoints never allocate
+using IpString = utils::InlineString<INET6_ADDRSTRLEN>;
+
 struct Endpoint {
     Endpoint() noexcept = default;
 
-    Endpoint(const IPVer ipVer, std::string ipAddress, const Port port_) noexcept
+    Endpoint(const IPVer ipVer, const IpString& ipAddress, const Port port_) noexcept
         : ipVersion(ipVer)
-        , ip(std::move(ipAddress))
+        , ip(ipAddress)
         , port(port_) {}
 
     IPVer ipVersion;
-    std::string ip;
+    IpString ip;
     Port port;
 };
 
@@ -60,9 +148,72 @@ union Address {
     struct sockaddr sa;
     struct sockaddr_in sa_in;
     struct sockaddr_in6 sa_in6;
+    struct sockaddr_un sa_un;
     struct sockaddr_storage sa_stor;
 };
 
+/// A contiguous piece of data to be sent
+struct ConstBuffer {
+    const Byte* data;
+    UnsignedSize size;
+};
+
+/// A contiguous storage for data to be received
+struct MutableBuffer {
+    Byte* data;
+    UnsignedSize size;
+};
+
+/// Position within a sequence of buffers, \see Socket<IPProto::TCP>::sendAllv()
+struct BufferCursor {
+    /// Index of the buffer the transfer continues with
+    UnsignedSize buffer = 0;
+    /// Offset within that buffer
+    UnsignedSize offset = 0;
+};
+
+/// Identifies a zero-copy send, \see SocketBase::setZeroCopy()
+struct ZeroCopySend {
+    /// Identifier of the send, reported back by the ZeroCopyCompletion once the data is no longer in use
+    std::uint32_t id;
+    /// The size of the data sent
+    UnsignedSize sent;
+};
+
+/// Notification about zero-copy sends the kernel no longer needs the data of
+///
+/// Covers all the sends from \ref first to \ref last (inclusive, the identifiers may wrap around).
+struct ZeroCopyCompletion {
+    std::uint32_t first;
+    std::uint32_t last;
+    /// The kernel copied the data anyway (e.g. on loopback or if the device doesn't support it), so the
+    /// zero-copy send brought no benefit for these sends.
+    bool copied;
+
+    /// Tells whether or not the given send is covered by this completion
+    bool covers(const std::uint32_t id) const noexcept { return id - first <= last - first; }
+};
+
+/// A datagram to be sent by Socket<IPProto::UDP>::sendBatch()
+struct OutgoingDatagram {
+    const Byte* data;
+    UnsignedSize size;
+    /// The destination or nullptr to send to the peer of a connected socket
+    const Address* address;
+    /// [out] The size of the data sent
+    UnsignedSize sent;
+};
+
+/// Storage for a datagram received by Socket<IPProto::UDP>::receiveBatch()
+struct IncomingDatagram {
+    Byte* data;
+    UnsignedSize maxSize;
+    /// [out] The size of the data received
+    UnsignedSize size;
+    /// [out] The address the datagram was sent from
+    Address source;
+};
+
 inline IPVer toIPVer(const int nativeIpVersion) {
     switch (nativeIpVersion) {
     case AF_INET:
@@ -85,6 +236,35 @@ inline SockLenType getAddrSize(const IPVer ipVersion) {
     }
 }
 
+/// Returns the size of the address given its family
+///
+/// The size of a Unix domain address covers the path including its terminating NUL byte, or the abstract
+/// name (the leading NUL byte followed by the name up to the first NUL byte), as the size of an abstract
+/// address is a part of the name.
+inline SockLenType getAddrSize(const sockaddr* addr) {
+    switch (addr->sa_family) {
+    case AF_INET:
+        return sizeof(sockaddr_in);
+    case AF_INET6:
+        return sizeof(sockaddr_in6);
+    case AF_UNIX: {
+        const char* path = reinterpret_cast<const sockaddr_un*>(addr)->sun_path;
+        const UnsignedSize maxLength = sizeof(sockaddr_un::sun_path);
+        const UnsignedSize length = path[0] == '\0' ? 1 + ::strnlen(path + 1, maxLength - 1)
+                                                     : std::min(::strnlen(path, maxLength) + 1, maxLength);
+        return static_cast<SockLenType>(offsetof(sockaddr_un, sun_path) + length);
+    }
+    default:
+        throw Exception(FUNC_NAME, "Address family ", addr->sa_family, " is not supported");
+    }
+}
+
+/// Tells whether or not the protocol is one of the Unix domain sockets
+constexpr bool isUnixProtocol(const IPProto protocol) noexcept {
+    return protocol == IPProto::UnixStream || protocol == IPProto::UnixDatagram ||
+           protocol == IPProto::UnixSeqPacket;
+}
+
 inline AddressFamily toNativeDomain(const IPVer ipVersion) {
     switch (ipVersion) {
     case IPVer::IPV4:
@@ -103,6 +283,12 @@ inline int toNativeType(const IPProto protocol) {
         return SOCK_STREAM;
     case IPProto::UDP:
         return SOCK_DGRAM;
+    case IPProto::UnixStream:
+        return SOCK_STREAM;
+    case IPProto::UnixDatagram:
+        return SOCK_DGRAM;
+    case IPProto::UnixSeqPacket:
+        return SOCK_SEQPACKET;
     default:
         MISSING_CASE_LABEL;
         throw Exception(FUNC_NAME, "Invalid IP protocol passed: ", static_cast<int>(protocol));
@@ -115,6 +301,10 @@ inline int toNativeProtocol(const IPProto protocol) {
         return IPPROTO_TCP;
     case IPProto::UDP:
         return IPPROTO_UDP;
+    case IPProto::UnixStream:
+    case IPProto::UnixDatagram:
+    case IPProto::UnixSeqPacket:
+        return 0;
     default:
         MISSING_CASE_LABEL;
         throw Exception(FUNC_NAME, "Invalid IP protocol passed: ", static_cast<int>(protocol));
@@ -135,8 +325,64 @@ namespace Platform {
 
     SignedSize receiveFrom(SocketHandle socket, Byte* data, const UnsignedSize size, sockaddr* addr);
 
+    /// Sends the data as datagrams of the segment size, the last one may be shorter, split by the kernel
+    /// (UDP GSO) where supported, otherwise sent one by one
+    /// \returns The size of the data sent or -1 in case of an error.
+    SignedSize sendToSegmented(SocketHandle socket,
+                               const Byte* data,
+                               const UnsignedSize size,
+                               const UnsignedSize segmentSize,
+                               const sockaddr* addr);
+
+    /// Receives a datagram, or datagrams of the same source coalesced by the kernel (UDP GRO)
+    /// \param segmentSize [out] The size of the coalesced datagrams, the size of the data received if the
+    /// datagram wasn't coalesced.
+    SignedSize receiveFromCoalesced(
+        SocketHandle socket, Byte* data, const UnsignedSize size, sockaddr* addr, UnsignedSize* segmentSize);
+
+    /// Receives the data without removing it from the socket and without blocking, even on blocking sockets
+    SignedSize peek(SocketHandle socket, Byte* data, const UnsignedSize size);
+
+    /// The maximum number of buffers transferred by a single sendv() or receivev() call
+    static constexpr UnsignedSize MAX_BUFFER_COUNT = 64;
+
+    SignedSize sendv(SocketHandle socket, const ConstBuffer* buffers, const UnsignedSize count);
+
+    SignedSize receivev(SocketHandle socket, const MutableBuffer* buffers, const UnsignedSize count);
+
+    /// The maximum number of datagrams transferred by a single sendBatch() or receiveBatch() call
+    static constexpr UnsignedSize MAX_BATCH_SIZE = 64;
+
+    SignedSize sendBatch(SocketHandle socket, OutgoingDatagram* datagrams, const UnsignedSize count);
+
+    SignedSize receiveBatch(SocketHandle socket, IncomingDatagram* datagrams, const UnsignedSize count);
+
     bool setBlocked(SocketHandle socket, const bool blocked = true);
 
+    bool setZeroCopy(SocketHandle socket, const bool enabled);
+
+    bool setOption(SocketHandle socket, const int level, const int name, const int value);
+
+    bool getOption(SocketHandle socket, const int level, const int name, int* value);
+
+    /// Shuts down sending, receiving or both, the peer receives EOF once sending is shut down
+    bool shutdown(SocketHandle socket, const bool send, const bool receive);
+
+    bool setReusePort(SocketHandle socket, const bool enabled);
+
+    /// Attaches a program distributing the packets and connections of the reuseport group the socket belongs
+    /// to by the index of the CPU handling them, modulo the group size (Linux only)
+    bool attachReusePortCpuSteering(SocketHandle socket, const unsigned groupSize);
+
+    /// Sends the data without copying it into the kernel
+    /// \param addr The destination address or nullptr for connected sockets.
+    SignedSize
+    sendZeroCopy(SocketHandle socket, const Byte* data, const UnsignedSize size, const sockaddr* addr);
+
+    /// Reads a single zero-copy notification from the socket error queue
+    /// \returns 1 if a notification was read, -1 in case of an error (EWOULDBLOCK if there's none).
+    SignedSize readZeroCopyCompletion(SocketHandle socket, ZeroCopyCompletion* completion);
+
     template <typename TRep, typename TPeriod>
     bool
     setTimeout(SocketHandle socket, const int direction, const std::chrono::duration<TRep, TPeriod> timeout) {
@@ -152,14 +398,67 @@ namespace Platform {
 #endif
     }
 
+    /// Opens a socket, the IP version is ignored for the Unix domain sockets
     SocketHandle openSocket(const IPProto ipProtocol, const IPVer ipVersion);
 
+    /// Creates a pair of connected Unix domain sockets (Linux only)
+    /// \returns true on success, false in case of an error.
+    bool socketPair(const IPProto ipProtocol, SocketHandle* sockets);
+
+    /// Initiates a connection, on non-blocking sockets the error is EINPROGRESS on all platforms
+    bool connect(SocketHandle socket, const sockaddr* addr, const SockLenType addrSize);
+
+    /// Waits until any of the sockets is writable or failed, e.g. until their connections complete
+    /// \param ready [out] Tells for each of the sockets whether or not it's ready.
+    /// \param timeoutMs The maximum time to wait, negative to wait indefinitely.
+    /// \returns The number of sockets ready, 0 if the time ran out or -1 in case of an error.
+    int waitWritable(const SocketHandle* sockets, bool* ready, const UnsignedSize count, const int timeoutMs);
+
+    /// Accepts a connection, setting the properties of the new socket atomically where possible
+    SocketHandle accept(SocketHandle socket,
+                        Address* peer,
+                        const bool nonBlocking = false,
+                        const bool closeOnExec = false);
+
     bool closeSocket(SocketHandle socket);
 
+    /// Opens the file for reading
+    /// \returns The handle of the file or FILE_NULL in case of an error.
+    FileHandle openFile(const std::string& path);
+
+    bool closeFile(FileHandle file);
+
+    /// Sends a part of the file without copying it through user space where the platform allows it
+    /// \returns The size of the data sent, 0 at the end of the file or -1 in case of an error.
+    SignedSize
+    sendFile(SocketHandle socket, FileHandle file, const std::uint64_t offset, const UnsignedSize size);
+
+    /// Moves data from a socket or a pipe into the pipe without copying it and without blocking on the pipe
+    /// (Linux only)
+    ///
+    /// Unlike spliceFromPipe(), SIGPIPE isn't suppressed, so the read end of the pipe has to be kept open.
+    /// \returns The size of the data moved, 0 at the end of the data or -1 in case of an error.
+    SignedSize spliceToPipe(const int from, const int pipe, const UnsignedSize size);
+
+    /// Moves data from the pipe to a socket without copying it and without blocking on the pipe (Linux only)
+    /// \returns The size of the data moved or -1 in case of an error.
+    SignedSize spliceFromPipe(const int pipe, const SocketHandle socket, const UnsignedSize size);
+
+    /// Allocates zero-filled memory directly from the system
+    /// \param hugePages Tells whether or not to try backing the memory by huge pages, which requires the size
+    /// to be a multiple of the huge page size.
+    /// \param mappedHugePages [out] Tells whether or not the memory is backed by huge pages.
+    /// \returns The memory or nullptr in case of an error.
+    void* mapMemory(const UnsignedSize size, const bool hugePages, bool* mappedHugePages);
+
+    bool unmapMemory(void* memory, const UnsignedSize size);
+
 #ifdef _WIN32
     static constexpr SocketHandle SOCKET_NULL = INVALID_SOCKET;
+    static const FileHandle FILE_NULL = INVALID_HANDLE_VALUE;
 #else
     static constexpr SocketHandle SOCKET_NULL = -1;
+    static constexpr FileHandle FILE_NULL = -1;
 #endif
 
 } // namespace Platform
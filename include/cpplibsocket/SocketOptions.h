@@ -0,0 +1,217 @@
+#ifndef CPPLIBSOCKET_SOCKETOPTIONS_H_
+#define CPPLIBSOCKET_SOCKETOPTIONS_H_
+
+#include "cpplibsocket/SocketCommon.h"
+
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#endif
+
+namespace cpplibsocket {
+
+/// Typed socket options, \see Socket<IPProto::TCP>::setOption() and Socket<IPProto::UDP>::setOption()
+///
+/// Each option describes its native level and name, the type of its value and the kinds of sockets it applies
+/// to. Using an option with a socket of a protocol it doesn't apply to fails to compile, the IP version is
+/// checked when the option is set. Options specific to some platforms are only defined on those platforms.
+namespace opt {
+
+    namespace detail {
+        template <typename TValue,
+                  int TLevel,
+                  int TName,
+                  bool TTcp = true,
+                  bool TUdp = true,
+                  bool TIPv4 = true,
+                  bool TIPv6 = true>
+        struct Option {
+            using ValueType = TValue;
+            static constexpr int LEVEL = TLevel;
+            static constexpr int NAME = TName;
+            static constexpr bool TCP = TTcp;
+            static constexpr bool UDP = TUdp;
+            static constexpr bool IPV4 = TIPv4;
+            static constexpr bool IPV6 = TIPv6;
+
+            /// The Unix domain sockets take just the socket level options of the IP sockets of their type
+            static constexpr bool appliesTo(const IPProto protocol) noexcept {
+                switch (protocol) {
+                case IPProto::TCP:
+                    return TCP;
+                case IPProto::UDP:
+                    return UDP;
+                case IPProto::UnixDatagram:
+                    return LEVEL == SOL_SOCKET && UDP;
+                default:
+                    return LEVEL == SOL_SOCKET && TCP;
+                }
+            }
+
+            static constexpr bool appliesTo(const IPVer ipVersion) noexcept {
+                return ipVersion == IPVer::IPV4 ? IPV4 : IPV6;
+            }
+        };
+
+        constexpr int toNative(const bool value) noexcept { return value ? 1 : 0; }
+
+        constexpr int toNative(const int value) noexcept { return value; }
+
+        inline int toNative(const std::chrono::seconds value) noexcept {
+            return static_cast<int>(value.count());
+        }
+
+        template <typename TValue>
+        TValue fromNative(const int value) noexcept;
+
+        template <>
+        inline bool fromNative<bool>(const int value) noexcept {
+            return value != 0;
+        }
+
+        template <>
+        inline int fromNative<int>(const int value) noexcept {
+            return value;
+        }
+
+        template <>
+        inline std::chrono::seconds fromNative<std::chrono::seconds>(const int value) noexcept {
+            return std::chrono::seconds(value);
+        }
+
+        template <typename T, typename = void>
+        struct IsOption : std::false_type {};
+
+        template <typename T>
+        struct IsOption<T, decltype(static_cast<void>(T::optionName()))> : std::true_type {};
+    } // namespace detail
+
+#define CPPLIBSOCKET_OPTION(name, option, ...)                                                               \
+    struct name : detail::Option<__VA_ARGS__> {                                                              \
+        static constexpr const char* optionName() noexcept { return #option; }                               \
+    }
+
+    /// SO_REUSEADDR
+    CPPLIBSOCKET_OPTION(ReuseAddr, SO_REUSEADDR, bool, SOL_SOCKET, SO_REUSEADDR);
+
+    /// SO_SNDBUF - the size of the send buffer in bytes, Linux reports twice the size set
+    CPPLIBSOCKET_OPTION(SndBuf, SO_SNDBUF, int, SOL_SOCKET, SO_SNDBUF);
+
+    /// SO_RCVBUF - the size of the receive buffer in bytes, Linux reports twice the size set
+    CPPLIBSOCKET_OPTION(RcvBuf, SO_RCVBUF, int, SOL_SOCKET, SO_RCVBUF);
+
+    /// SO_KEEPALIVE
+    CPPLIBSOCKET_OPTION(KeepAlive, SO_KEEPALIVE, bool, SOL_SOCKET, SO_KEEPALIVE, true, false);
+
+    /// TCP_NODELAY - disables the Nagle's algorithm
+    CPPLIBSOCKET_OPTION(NoDelay, TCP_NODELAY, bool, IPPROTO_TCP, TCP_NODELAY, true, false);
+
+#ifdef TCP_KEEPIDLE
+    /// TCP_KEEPIDLE - the idle time before the first keepalive probe is sent
+    CPPLIBSOCKET_OPTION(KeepIdle, TCP_KEEPIDLE, std::chrono::seconds, IPPROTO_TCP, TCP_KEEPIDLE, true, false);
+#endif
+
+#ifdef TCP_KEEPINTVL
+    /// TCP_KEEPINTVL - the interval between keepalive probes
+    CPPLIBSOCKET_OPTION(
+        KeepInterval, TCP_KEEPINTVL, std::chrono::seconds, IPPROTO_TCP, TCP_KEEPINTVL, true, false);
+#endif
+
+#ifdef TCP_KEEPCNT
+    /// TCP_KEEPCNT - the number of unanswered keepalive probes before the connection is dropped
+    CPPLIBSOCKET_OPTION(KeepCount, TCP_KEEPCNT, int, IPPROTO_TCP, TCP_KEEPCNT, true, false);
+#endif
+
+#ifdef TCP_NOTSENT_LOWAT
+    /// TCP_NOTSENT_LOWAT - the amount of unsent data in bytes above which the socket is not writable
+    CPPLIBSOCKET_OPTION(NotSentLowAt, TCP_NOTSENT_LOWAT, int, IPPROTO_TCP, TCP_NOTSENT_LOWAT, true, false);
+#endif
+
+#ifdef __linux__
+    /// TCP_CORK - holds partial frames back until uncorked or until 200 ms pass
+    CPPLIBSOCKET_OPTION(Cork, TCP_CORK, bool, IPPROTO_TCP, TCP_CORK, true, false);
+
+    /// TCP_QUICKACK - sends ACKs immediately, the kernel may turn it off again later
+    CPPLIBSOCKET_OPTION(QuickAck, TCP_QUICKACK, bool, IPPROTO_TCP, TCP_QUICKACK, true, false);
+
+    /// SO_PRIORITY - the priority of the packets sent, used by the queueing disciplines
+    CPPLIBSOCKET_OPTION(Priority, SO_PRIORITY, int, SOL_SOCKET, SO_PRIORITY);
+#endif
+
+#ifdef UDP_SEGMENT
+    /// UDP_SEGMENT - the size of the datagrams the data sent is split into by the kernel (UDP GSO), 0 to
+    /// disable, \see Socket<IPProto::UDP>::sendToSegmented()
+    CPPLIBSOCKET_OPTION(UdpSegment, UDP_SEGMENT, int, IPPROTO_UDP, UDP_SEGMENT, false, true);
+#endif
+
+#ifdef UDP_GRO
+    /// UDP_GRO - lets the kernel coalesce the datagrams received (UDP GRO), \see
+    /// Socket<IPProto::UDP>::receiveFromCoalesced()
+    CPPLIBSOCKET_OPTION(UdpGro, UDP_GRO, bool, IPPROTO_UDP, UDP_GRO, false, true);
+#endif
+
+    /// IP_TOS - the type of service (DSCP and ECN) of the IPv4 packets sent
+    CPPLIBSOCKET_OPTION(Tos, IP_TOS, int, IPPROTO_IP, IP_TOS, true, true, true, false);
+
+#ifdef IPV6_TCLASS
+    /// IPV6_TCLASS - the traffic class (DSCP and ECN) of the IPv6 packets sent
+    CPPLIBSOCKET_OPTION(TrafficClass, IPV6_TCLASS, int, IPPROTO_IPV6, IPV6_TCLASS, true, true, false, true);
+#endif
+
+    /// IPV6_V6ONLY - restricts the socket to IPv6, disabling IPv4-mapped addresses
+    CPPLIBSOCKET_OPTION(V6Only, IPV6_V6ONLY, bool, IPPROTO_IPV6, IPV6_V6ONLY, true, true, false, true);
+
+#undef CPPLIBSOCKET_OPTION
+
+} // namespace opt
+
+/// Socket option with its value converted to the native representation
+struct SocketOptionValue {
+    int level;
+    int name;
+    int value;
+    bool ipv4;
+    bool ipv6;
+    const char* optionName;
+};
+
+/// Set of options applied to a socket at once, e.g. when it's created or accepted
+///
+/// The options are applied in the order they were set.
+template <IPProto TIPProto>
+class SocketOptions final {
+public:
+    /// Adds the option to the set
+    template <typename TOption>
+    SocketOptions& set(const typename TOption::ValueType value) {
+        mValues.push_back(makeValue<TOption>(value));
+        return *this;
+    }
+
+    const std::vector<SocketOptionValue>& values() const noexcept { return mValues; }
+
+    /// Validates the option at compile time and converts its value to the native representation
+    template <typename TOption>
+    static SocketOptionValue makeValue(const typename TOption::ValueType value) noexcept {
+        static_assert(opt::detail::IsOption<TOption>::value, "Not a socket option, see the opt namespace");
+        static_assert(TOption::appliesTo(TIPProto), "The option doesn't apply to sockets of this protocol");
+        return { TOption::LEVEL,
+                 TOption::NAME,
+                 opt::detail::toNative(value),
+                 TOption::IPV4,
+                 TOption::IPV6,
+                 TOption::optionName() };
+    }
+
+private:
+    std::vector<SocketOptionValue> mValues;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_SOCKETOPTIONS_H_
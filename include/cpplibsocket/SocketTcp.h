@@ -3,8 +3,16 @@
 
 #include "cpplibsocket/SocketBase.h"
 
+#include <vector>
+
 namespace cpplibsocket {
 
+struct AcceptedSocket;
+
+#ifdef __linux__
+class RingBuffer;
+#endif
+
 /// RAII TCP Socket wrapper
 ///
 /// Provides a simple interface for TCP socket manipulation
@@ -14,6 +22,36 @@ public:
     /// Creates a TCP socket with the given IP version
     Socket(const IPVer ipVersion);
 
+    /// Creates a TCP socket with the given IP version and sets the options
+    /// \throws Exception in case the socket couldn't be created or if any of the options couldn't be set.
+    Socket(const IPVer ipVersion, const SocketOptions<IPProto::TCP>& options);
+
+    /// Sets the option, e.g. setOption<opt::NoDelay>(true)
+    /// \throws Exception in case the socket is not open, the option doesn't apply to the IP version of the
+    /// socket or if setting the option fails.
+    template <typename TOption>
+    void setOption(const typename TOption::ValueType value) {
+        SocketBase::setOption(SocketOptions<IPProto::TCP>::makeValue<TOption>(value));
+    }
+
+    /// Sets all the options in order
+    /// \throws Exception in case any of the options couldn't be set.
+    void setOptions(const SocketOptions<IPProto::TCP>& options) { SocketBase::setOptions(options.values()); }
+
+    /// Returns the value of the option, e.g. getOption<opt::RcvBuf>()
+    /// \throws Exception in case the socket is not open, the option doesn't apply to the IP version of the
+    /// socket or if getting the option fails.
+    template <typename TOption>
+    typename TOption::ValueType getOption() const {
+        const int value = SocketBase::getOption(SocketOptions<IPProto::TCP>::makeValue<TOption>({}));
+        return opt::detail::fromNative<typename TOption::ValueType>(value);
+    }
+
+    /// Takes the ownership of an already open socket handle, e.g. one accepted through IoRing
+    /// \param ipVersion The IP version of the socket.
+    /// \param socketHandle The handle to take over. It will be closed along with the returned socket.
+    static Socket adopt(const IPVer ipVersion, const SocketHandle socketHandle) noexcept;
+
     /// Initiates a connection to a server
     /// \param address The address to connect to.
     /// \throws Exception in case the socket is not open or if there was some error while connecting to the
@@ -27,6 +65,35 @@ public:
     /// peer.
     void connect(const std::string& hostIp, const Port hostPort);
 
+    /// Connects to a server, giving up once the timeout elapses
+    ///
+    /// The connection is initiated without blocking and then waited for at most the given time, so an
+    /// unreachable peer doesn't block for the whole SYN retry period of the kernel. The socket is blocking
+    /// afterwards. If the time runs out, the connection attempt stays pending and the socket should be
+    /// closed.
+    /// \param address The address to connect to.
+    /// \param timeout The maximum time to wait for the connection.
+    /// \throws Exception in case the socket is not open, if the connection failed or timed out.
+    void connect(const Address& address, const std::chrono::milliseconds timeout);
+
+    /// Connects to a server, giving up once the timeout elapses, without throwing
+    /// \copydetails connect(const Address&, const std::chrono::milliseconds)
+    /// \returns Connected or the error, SocketError::timedOut() if the time ran out.
+    Expected<Connected, SocketError> tryConnect(const Address& address,
+                                                const std::chrono::milliseconds timeout) const noexcept;
+
+    /// Initiates a connection to a server without throwing, \see connect()
+    ///
+    /// On a non-blocking socket the connection is established asynchronously, which is reported as an error
+    /// of the InProgress category. Once the socket becomes writable, connectResult() tells the outcome.
+    /// \param address The address to connect to.
+    /// \returns Connected or the error.
+    Expected<Connected, SocketError> tryConnect(const Address& address) const noexcept;
+
+    /// Returns the outcome of a connection initiated asynchronously by tryConnect()
+    /// \returns Connected or the error the connection failed with.
+    Expected<Connected, SocketError> connectResult() const noexcept;
+
     /// Starts listening for incoming connections
     /// \param backlogSize Hint to the socket determining the maximum number of outstanding connections in the
     /// socket's listen queue.
@@ -39,6 +106,26 @@ public:
     /// \throws Exception in case the socket is not open or if the accept failed for whatever reason.
     Expected<Socket, WouldBlock> accept() const;
 
+    /// Accepts a client connection without throwing, \see accept()
+    /// \returns A socket of the client connected or the error.
+    Expected<Socket, SocketError> tryAccept() const noexcept;
+
+    /// Accepts all the pending client connections up to the given count
+    ///
+    /// The connections are accepted until the listen queue is drained (the listening socket has to be
+    /// non-blocking for that) or until maxCount connections are accepted. The peer address is captured by
+    /// the accept itself and the properties are set atomically with accept4(), so no further system calls
+    /// are needed per connection.
+    /// \param maxCount The maximum number of connections to accept.
+    /// \param flags The properties of the accepted sockets.
+    /// \returns The accepted sockets along with their peer addresses, empty if no connection is pending.
+    /// \throws Exception in case the socket is not open or if the first accept fails for whatever reason.
+    /// Errors following a successful accept end the batch and are reported by the next call.
+    std::vector<AcceptedSocket>
+    acceptMany(const UnsignedSize maxCount,
+               const utils::Flags<AcceptFlag> flags = AcceptFlag::NonBlocking |
+                                                      AcceptFlag::CloseOnExec) const;
+
     /// Sends data to the peer the socket is connected to
     /// \param data The data to send.
     /// \param size The data size.
@@ -46,6 +133,10 @@ public:
     /// \throws Exception in case the socket is not open or if there was some error while sending the data.
     Expected<UnsignedSize, WouldBlock> send(const Byte* data, const UnsignedSize size) const;
 
+    /// Sends data to the peer the socket is connected to without throwing, \see send()
+    /// \returns The size of the data sent or the error.
+    Expected<UnsignedSize, SocketError> trySend(const Byte* data, const UnsignedSize size) const noexcept;
+
     /// Receives data from peer the socket is connected to
     /// \param data The destination for the received data.
     /// \param The maximum size of data we can receive at this time.
@@ -55,10 +146,189 @@ public:
     /// the data.
     Expected<UnsignedSize, WouldBlock> receive(Byte* data, const UnsignedSize maxSize) const;
 
+    /// Receives data from the peer the socket is connected to without throwing, \see receive()
+    /// \returns The size of the data received or the error.
+    Expected<UnsignedSize, SocketError> tryReceive(Byte* data, const UnsignedSize maxSize) const noexcept;
+
+    /// Receives data from the peer without removing it from the socket and without blocking
+    ///
+    /// Works the same on blocking sockets, which makes it suitable for checking whether an idle connection
+    /// was closed by the peer: 0 is returned then, WouldBlock if the connection is idle and intact.
+    /// \returns The size of the data available or the error.
+    Expected<UnsignedSize, SocketError> tryPeek(Byte* data, const UnsignedSize maxSize) const noexcept;
+
+    /// Receives data from the peer the socket is connected to into a buffer taken from the pool
+    ///
+    /// The buffer is only held while there's data to process, so idle connections don't need a receive
+    /// buffer of their own. If there's no data to receive, the buffer goes right back to the pool.
+    /// \param pool The pool to take the buffer from.
+    /// \param maxSize The maximum size of data we can receive at this time.
+    /// \returns If no error occurred, the buffer with its size set to the size of the data received is
+    /// returned. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open, if no buffer could be taken from the pool or if
+    /// there was some error while receiving the data.
+    Expected<PooledBuffer, WouldBlock> receive(BufferPool& pool, const UnsignedSize maxSize) const;
+
+    /// Receives data into a buffer taken from the pool without throwing, \see receive()
+    /// \returns The buffer holding the data received or the error, SocketError::noBuffers() if no buffer
+    /// could be taken from the pool.
+    Expected<PooledBuffer, SocketError>
+    tryReceive(BufferPool& pool, const UnsignedSize maxSize) const noexcept;
+
+    /// Sends data to the peer the socket is connected to without copying it, \see setZeroCopy()
+    ///
+    /// The data must stay intact until a ZeroCopyCompletion covering the returned identifier is read.
+    /// \param data The data to send.
+    /// \param size The data size.
+    /// \returns If no error occurred, the identifier of the send and the size of the data sent is returned.
+    /// If no data was sent, there will be no completion for the returned identifier. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open, zero-copy sends are not enabled or if there was some
+    /// error while sending the data.
+    Expected<ZeroCopySend, WouldBlock> sendZeroCopy(const Byte* data, const UnsignedSize size);
+
+    /// Sends data gathered from multiple buffers to the peer the socket is connected to
+    ///
+    /// The buffers are sent in a single call as if they were one contiguous buffer. At most
+    /// Platform::MAX_BUFFER_COUNT buffers are sent by a single call.
+    /// \param buffers The buffers to send.
+    /// \param count The number of buffers.
+    /// \returns If no error occurred, the total size of the data sent is returned, which may be less than
+    /// the total size of the buffers. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while sending the data.
+    Expected<UnsignedSize, WouldBlock> sendv(const ConstBuffer* buffers, const UnsignedSize count) const;
+
+    /// Sends data gathered from multiple buffers without throwing, \see sendv()
+    /// \returns The total size of the data sent or the error.
+    Expected<UnsignedSize, SocketError>
+    trySendv(const ConstBuffer* buffers, const UnsignedSize count) const noexcept;
+
+    /// Receives data from the peer the socket is connected to, scattering it into multiple buffers
+    ///
+    /// The buffers are filled in order. At most Platform::MAX_BUFFER_COUNT buffers are filled by a single
+    /// call.
+    /// \param buffers The destinations for the received data.
+    /// \param count The number of buffers.
+    /// \returns If no error occurred, the total size of the data received is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while receiving
+    /// the data.
+    Expected<UnsignedSize, WouldBlock> receivev(const MutableBuffer* buffers, const UnsignedSize count) const;
+
+    /// Receives data into multiple buffers without throwing, \see receivev()
+    /// \returns The total size of the data received or the error.
+    Expected<UnsignedSize, SocketError>
+    tryReceivev(const MutableBuffer* buffers, const UnsignedSize count) const noexcept;
+
+#ifdef __linux__
+    /// Receives data into the free space of the ring buffer, \see receive()
+    ///
+    /// The data received is committed to the ring, the free space is contiguous so a single call fills as
+    /// much of it as there's data available.
+    /// \param ring The ring to receive into.
+    /// \returns If no error occurred, the size of the data received is returned (0 if the peer closed the
+    /// connection). An error is returned otherwise.
+    /// \throws Exception in case the socket is not open, the ring is full or if there was some error while
+    /// receiving the data.
+    Expected<UnsignedSize, WouldBlock> receiveInto(RingBuffer& ring) const;
+
+    /// Receives data into the ring buffer without throwing, \see receiveInto()
+    /// \returns The size of the data received or the error, SocketError::noBuffers() if the ring is full.
+    Expected<UnsignedSize, SocketError> tryReceiveInto(RingBuffer& ring) const noexcept;
+
+    /// Sends the data stored in the ring buffer, \see send()
+    ///
+    /// The data sent is consumed from the ring.
+    /// \param ring The ring to send from.
+    /// \returns If no error occurred, the size of the data sent is returned. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while sending the data.
+    Expected<UnsignedSize, WouldBlock> sendFrom(RingBuffer& ring) const;
+
+    /// Sends the data stored in the ring buffer without throwing, \see sendFrom()
+    /// \returns The size of the data sent or the error.
+    Expected<UnsignedSize, SocketError> trySendFrom(RingBuffer& ring) const noexcept;
+#endif
+
+    /// Sends all the data, retrying after partial sends and interruptions
+    ///
+    /// On a non-blocking socket the transfer stops with WouldBlock once the send buffer is full. The
+    /// progress is kept in sent, so the call can be repeated with the same arguments after the socket
+    /// becomes writable.
+    /// \param data The data to send.
+    /// \param size The data size.
+    /// \param sent[in,out] The size of the data already sent, 0 when starting a new transfer.
+    /// \returns The size of the data sent by this call or the error. The transfer is complete when sent
+    /// reaches size.
+    Expected<UnsignedSize, SocketError>
+    sendAll(const Byte* data, const UnsignedSize size, UnsignedSize& sent) const noexcept;
+
+    /// Sends a part of the file, retrying after partial sends and interruptions, \see sendAll()
+    ///
+    /// The data is sent by sendfile(), straight from the page cache, so it isn't copied through user space.
+    /// On a non-blocking socket the progress is kept in sent, so the call can be repeated with the same
+    /// arguments after the socket becomes writable.
+    /// \param file The file to send from, its own position is neither used nor changed.
+    /// \param offset The offset in the file the part starts at.
+    /// \param size The size of the part.
+    /// \param sent[in,out] The size of the data already sent, 0 when starting a new transfer.
+    /// \returns The size of the data sent by this call or the error. If sent is less than size on success,
+    /// the file ended.
+    Expected<UnsignedSize, SocketError> sendFile(const FileHandle file,
+                                                 const std::uint64_t offset,
+                                                 const UnsignedSize size,
+                                                 UnsignedSize& sent) const noexcept;
+
+    /// Sends a part of the file at the given path, \see sendFile()
+    ///
+    /// The file is opened for the call only, a transfer resumed on a non-blocking socket opens it again.
+    /// \returns The size of the data sent by this call or the error, including failing to open the file.
+    Expected<UnsignedSize, SocketError> sendFile(const std::string& path,
+                                                 const std::uint64_t offset,
+                                                 const UnsignedSize size,
+                                                 UnsignedSize& sent) const noexcept;
+
+    /// Receives exactly the given size of data, retrying after partial receives and interruptions
+    ///
+    /// On a non-blocking socket the transfer stops with WouldBlock once there's no more data queued. The
+    /// progress is kept in received, so the call can be repeated with the same arguments after the socket
+    /// becomes readable.
+    /// \param data The destination for the received data.
+    /// \param size The size of data to receive.
+    /// \param received[in,out] The size of the data already received, 0 when starting a new transfer.
+    /// \returns The size of the data received by this call or the error. If received is less than size on
+    /// success, the peer closed the connection.
+    Expected<UnsignedSize, SocketError>
+    receiveExact(Byte* data, const UnsignedSize size, UnsignedSize& received) const noexcept;
+
+    /// Sends all the data gathered from multiple buffers, \see sendAll()
+    /// \param buffers The buffers to send.
+    /// \param count The number of buffers.
+    /// \param cursor[in,out] The position the transfer continues from, default when starting a new
+    /// transfer. The transfer is complete when the cursor reaches count.
+    /// \returns The size of the data sent by this call or the error.
+    Expected<UnsignedSize, SocketError>
+    sendAllv(const ConstBuffer* buffers, const UnsignedSize count, BufferCursor& cursor) const noexcept;
+
+    /// Fills all the buffers with received data, \see receiveExact()
+    /// \param buffers The destinations for the received data.
+    /// \param count The number of buffers.
+    /// \param cursor[in,out] The position the transfer continues from, default when starting a new
+    /// transfer. If the cursor doesn't reach count on success, the peer closed the connection.
+    /// \returns The size of the data received by this call or the error.
+    Expected<UnsignedSize, SocketError> receiveExactv(const MutableBuffer* buffers,
+                                                      const UnsignedSize count,
+                                                      BufferCursor& cursor) const noexcept;
+
 private:
     Socket(const IPVer ipVersion, const SocketHandle clientSocketHandle) noexcept;
 };
 
+/// Socket accepted by Socket<IPProto::TCP>::acceptMany() along with the address of its peer
+struct AcceptedSocket {
+    Socket<IPProto::TCP> socket;
+    Address peer;
+};
+
 } // namespace cpplibsocket
 
 #endif // CPPLIBSOCKET_SOCKETTCP_H_
@@ -14,6 +14,31 @@ public:
     /// Creates a UDP socket with the given IP version
     Socket(const IPVer ipVersion);
 
+    /// Creates a UDP socket with the given IP version and sets the options
+    /// \throws Exception in case the socket couldn't be created or if any of the options couldn't be set.
+    Socket(const IPVer ipVersion, const SocketOptions<IPProto::UDP>& options);
+
+    /// Sets the option, e.g. setOption<opt::NoDelay>(true)
+    /// \throws Exception in case the socket is not open, the option doesn't apply to the IP version of the
+    /// socket or if setting the option fails.
+    template <typename TOption>
+    void setOption(const typename TOption::ValueType value) {
+        SocketBase::setOption(SocketOptions<IPProto::UDP>::makeValue<TOption>(value));
+    }
+
+    /// Sets all the options in order
+    /// \throws Exception in case any of the options couldn't be set.
+    void setOptions(const SocketOptions<IPProto::UDP>& options) { SocketBase::setOptions(options.values()); }
+
+    /// Returns the value of the option, e.g. getOption<opt::RcvBuf>()
+    /// \throws Exception in case the socket is not open, the option doesn't apply to the IP version of the
+    /// socket or if getting the option fails.
+    template <typename TOption>
+    typename TOption::ValueType getOption() const {
+        const int value = SocketBase::getOption(SocketOptions<IPProto::UDP>::makeValue<TOption>({}));
+        return opt::detail::fromNative<typename TOption::ValueType>(value);
+    }
+
     /// Sends data to the given IP address and port
     /// \param data The data to send.
     /// \param size The data size.
@@ -23,6 +48,12 @@ public:
     Expected<UnsignedSize, WouldBlock>
     sendTo(const Byte* data, const UnsignedSize size, const Address& address);
 
+    /// Sends data to the given address without throwing, \see sendTo()
+    /// \returns The size of the data sent or the error, SocketError::unsupportedFamily() if the address is
+    /// not an IP address.
+    Expected<UnsignedSize, SocketError>
+    trySendTo(const Byte* data, const UnsignedSize size, const Address& address) noexcept;
+
     /// Sends data to the given IP address and port
     /// \param data The data to send.
     /// \param size The data size.
@@ -33,6 +64,45 @@ public:
     Expected<UnsignedSize, WouldBlock>
     sendTo(const Byte* data, const UnsignedSize size, const std::string& hostIp, const Port hostPort);
 
+    /// Sends data to the given address without copying it, \see setZeroCopy()
+    ///
+    /// The data must stay intact until a ZeroCopyCompletion covering the returned identifier is read.
+    /// \param data The data to send.
+    /// \param size The data size.
+    /// \param address The address the data will be sent to.
+    /// \returns If no error occurred, the identifier of the send and the size of the data sent is returned.
+    /// An error is returned otherwise.
+    /// \throws Exception in case the socket is not open, zero-copy sends are not enabled or if there was some
+    /// error while sending the data.
+    Expected<ZeroCopySend, WouldBlock>
+    sendToZeroCopy(const Byte* data, const UnsignedSize size, const Address& address);
+
+    /// Sends the data as multiple datagrams of the segment size in a single call
+    ///
+    /// The data is split into the datagrams by the kernel (UDP GSO), so the stack is traversed once for all
+    /// of them rather than once per datagram. The last datagram may be shorter. Linux limits a single call
+    /// to 64 datagrams and to the maximum size of a datagram in total. Where the offload isn't available,
+    /// including the Linux kernels or devices that reject it, the datagrams are sent one by one.
+    /// \param data The data to send.
+    /// \param size The data size.
+    /// \param segmentSize The size of the datagrams, from 1 to 65535.
+    /// \param address The address the data will be sent to.
+    /// \returns If no error occurred, the size of the data sent is returned. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open, the segment size is out of range or if there was
+    /// some error while sending the data.
+    Expected<UnsignedSize, WouldBlock> sendToSegmented(const Byte* data,
+                                                       const UnsignedSize size,
+                                                       const UnsignedSize segmentSize,
+                                                       const Address& address);
+
+    /// Sends the data as multiple datagrams without throwing, \see sendToSegmented()
+    /// \returns The size of the data sent or the error, SocketError::invalidArgument() if the segment size is
+    /// out of range and SocketError::unsupportedFamily() if the address is not an IP address.
+    Expected<UnsignedSize, SocketError> trySendToSegmented(const Byte* data,
+                                                           const UnsignedSize size,
+                                                           const UnsignedSize segmentSize,
+                                                           const Address& address) noexcept;
+
     /// Receives data from the given IP address and port
     /// \param data The destination for the received data.
     /// \param The maximum size of data we can receive at this time.
@@ -43,6 +113,105 @@ public:
     /// \param source[out] Storage for the source endpoint or nullptr if unused.
     Expected<UnsignedSize, WouldBlock>
     receiveFrom(Byte* data, const UnsignedSize maxSize, Endpoint* source = nullptr);
+
+    /// Receives data along with the raw address of the sender
+    ///
+    /// Unlike the Endpoint overload, the source address isn't formatted, so this function never allocates.
+    /// Use utils::getEndpoint() to format the address only when needed.
+    /// \param data The destination for the received data.
+    /// \param maxSize The maximum size of data we can receive at this time.
+    /// \param source[out] Storage for the source address.
+    /// \returns If no error occurred, the size of the data received is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while receiving
+    /// the data.
+    Expected<UnsignedSize, WouldBlock> receiveFrom(Byte* data, const UnsignedSize maxSize, Address& source);
+
+    /// Receives data along with the raw address of the sender without throwing, \see receiveFrom()
+    /// \returns The size of the data received or the error.
+    Expected<UnsignedSize, SocketError>
+    tryReceiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) noexcept;
+
+    /// Receives a datagram, or multiple datagrams of the same sender coalesced by the kernel
+    ///
+    /// The datagrams are coalesced (UDP GRO) once enabled by opt::UdpGro, the whole burst is then received
+    /// by a single call. All the datagrams coalesced are of the segment size, except for the last one which
+    /// may be shorter. The buffer should hold the maximum size of a datagram, the data that doesn't fit is
+    /// lost.
+    /// \param data The destination for the received data.
+    /// \param maxSize The maximum size of data we can receive at this time.
+    /// \param source[out] Storage for the source address.
+    /// \param segmentSize[out] The size of the datagrams coalesced, the size of the data received if there's
+    /// just one.
+    /// \returns If no error occurred, the size of the data received is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while receiving
+    /// the data.
+    Expected<UnsignedSize, WouldBlock> receiveFromCoalesced(Byte* data,
+                                                            const UnsignedSize maxSize,
+                                                            Address& source,
+                                                            UnsignedSize& segmentSize);
+
+    /// Receives coalesced datagrams without throwing, \see receiveFromCoalesced()
+    /// \returns The size of the data received or the error.
+    Expected<UnsignedSize, SocketError> tryReceiveFromCoalesced(Byte* data,
+                                                                const UnsignedSize maxSize,
+                                                                Address& source,
+                                                                UnsignedSize& segmentSize) noexcept;
+
+    /// Receives data along with the raw address of the sender into a buffer taken from the pool
+    ///
+    /// If there's no datagram to receive, the buffer goes right back to the pool.
+    /// \param pool The pool to take the buffer from.
+    /// \param maxSize The maximum size of data we can receive at this time.
+    /// \param source[out] Storage for the source address.
+    /// \returns If no error occurred, the buffer with its size set to the size of the data received is
+    /// returned. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open, if no buffer could be taken from the pool or if
+    /// there was some error while receiving the data.
+    Expected<PooledBuffer, WouldBlock>
+    receiveFrom(BufferPool& pool, const UnsignedSize maxSize, Address& source);
+
+    /// Receives data into a buffer taken from the pool without throwing, \see receiveFrom()
+    /// \returns The buffer holding the data received or the error, SocketError::noBuffers() if no buffer
+    /// could be taken from the pool.
+    Expected<PooledBuffer, SocketError>
+    tryReceiveFrom(BufferPool& pool, const UnsignedSize maxSize, Address& source) noexcept;
+
+    /// Sends multiple datagrams at once
+    ///
+    /// At most Platform::MAX_BATCH_SIZE datagrams are sent by a single call.
+    /// \param datagrams The datagrams to send. The size of the data sent is stored into each datagram sent.
+    /// \param count The number of datagrams.
+    /// \returns If no error occurred, the number of datagrams sent is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while sending the first
+    /// datagram.
+    Expected<UnsignedSize, WouldBlock> sendBatch(OutgoingDatagram* datagrams, const UnsignedSize count);
+
+    /// Sends multiple datagrams at once without throwing, \see sendBatch()
+    /// \returns The number of datagrams sent or the error, SocketError::unsupportedFamily() if any of the
+    /// addresses is not an IP address.
+    Expected<UnsignedSize, SocketError>
+    trySendBatch(OutgoingDatagram* datagrams, const UnsignedSize count) noexcept;
+
+    /// Receives multiple datagrams at once
+    ///
+    /// Waits only for the first datagram (unless the socket is non-blocking), the rest of the storage is
+    /// filled only with the datagrams already queued. At most Platform::MAX_BATCH_SIZE datagrams are received
+    /// by a single call.
+    /// \param datagrams The storage for the datagrams received.
+    /// \param count The number of datagrams the storage can hold.
+    /// \returns If no error occurred, the number of datagrams received is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while receiving the
+    /// data.
+    Expected<UnsignedSize, WouldBlock> receiveBatch(IncomingDatagram* datagrams, const UnsignedSize count);
+
+    /// Receives multiple datagrams at once without throwing, \see receiveBatch()
+    /// \returns The number of datagrams received or the error.
+    Expected<UnsignedSize, SocketError>
+    tryReceiveBatch(IncomingDatagram* datagrams, const UnsignedSize count) noexcept;
 };
 
 } // namespace cpplibsocket
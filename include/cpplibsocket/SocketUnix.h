@@ -0,0 +1,264 @@
+#ifndef CPPLIBSOCKET_SOCKETUNIX_H_
+#define CPPLIBSOCKET_SOCKETUNIX_H_
+
+#include "cpplibsocket/SocketBase.h"
+
+#include <string>
+#include <utility>
+
+namespace cpplibsocket {
+
+/// Base of the Unix domain (AF_UNIX) sockets, \see Socket<IPProto::UnixStream>,
+/// Socket<IPProto::UnixDatagram> and Socket<IPProto::UnixSeqPacket>
+///
+/// Unix domain sockets connect processes of the same host without going through the network stack, so
+/// they're considerably cheaper than loopback TCP or UDP. The sockets are addressed either by a filesystem
+/// path (utils::createUnixAddr()) or by a name in the abstract namespace (utils::createAbstractAddr(), Linux
+/// only). They have no IP version, getEndpoint() doesn't apply to them, getPath() and getPeerPath() do.
+/// The operations the type of the socket doesn't support are exposed by the specializations which do.
+template <IPProto TIPProto>
+class UnixSocketBase : public SocketBase {
+public:
+    /// Sets the option, e.g. setOption<opt::SndBuf>(1 << 20)
+    ///
+    /// Only the socket level options apply to the Unix domain sockets.
+    /// \throws Exception in case the socket is not open or if setting the option fails.
+    template <typename TOption>
+    void setOption(const typename TOption::ValueType value) {
+        SocketBase::setOption(SocketOptions<TIPProto>::template makeValue<TOption>(value));
+    }
+
+    /// Sets all the options in order
+    /// \throws Exception in case any of the options couldn't be set.
+    void setOptions(const SocketOptions<TIPProto>& options) { SocketBase::setOptions(options.values()); }
+
+    /// Returns the value of the option, e.g. getOption<opt::RcvBuf>()
+    /// \throws Exception in case the socket is not open or if getting the option fails.
+    template <typename TOption>
+    typename TOption::ValueType getOption() const {
+        const int value = SocketBase::getOption(SocketOptions<TIPProto>::template makeValue<TOption>({}));
+        return opt::detail::fromNative<typename TOption::ValueType>(value);
+    }
+
+    /// Creates a pair of sockets connected to each other (socketpair(), Linux only)
+    ///
+    /// The sockets are unnamed, which suits the communication with a child process or between threads.
+    /// \throws Exception in case the sockets couldn't be created.
+    static std::pair<Socket<TIPProto>, Socket<TIPProto>> pair();
+
+    /// Assigns the Unix domain address to the socket
+    /// \throws Exception in case the socket is not open or if the binding fails.
+    void bind(const Address& address);
+
+    /// Binds the socket to the filesystem path
+    ///
+    /// The socket file is created by the binding and has to not exist yet. It isn't removed when the socket
+    /// is closed, the owner of the path is responsible for removing it.
+    /// \throws Exception in case the socket is not open, the path is invalid or if the binding fails.
+    void bind(const std::string& path);
+
+    /// Binds the socket to the name in the abstract namespace (Linux only), \see utils::createAbstractAddr()
+    /// \throws Exception in case the socket is not open, the name is invalid or if the binding fails.
+    void bindAbstract(const std::string& name);
+
+    /// Returns the path the socket is bound to, \see utils::getUnixPath()
+    /// \throws Exception in case the socket is not open or if getting the address fails.
+    std::string getPath() const;
+
+    /// Returns the path of the peer the socket is connected to, \see utils::getUnixPath()
+    /// \throws Exception in case the socket is not open, not connected or if getting the address fails.
+    std::string getPeerPath() const;
+
+    /// Connects to the socket bound to the address
+    ///
+    /// A datagram socket sends to and receives from the address only afterwards.
+    /// \throws Exception in case the socket is not open or if the connection fails.
+    void connect(const Address& address);
+
+    /// Connects to the socket bound to the filesystem path, \see connect()
+    /// \throws Exception in case the socket is not open, the path is invalid or if the connection fails.
+    void connect(const std::string& path);
+
+    /// Connects to the socket bound to the address without throwing, \see connect()
+    ///
+    /// Unlike TCP, a connection to a listening socket with a full backlog fails on a non-blocking socket
+    /// with WouldBlock instead of completing asynchronously.
+    /// \returns Connected or the error, SocketError::unsupportedFamily() if the address is not a Unix domain
+    /// address.
+    Expected<Connected, SocketError> tryConnect(const Address& address) const noexcept;
+
+    /// Sends data to the peer the socket is connected to
+    /// \param data The data to send.
+    /// \param size The data size.
+    /// \returns If no error occurred, the size of the data sent is returned. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while sending the data.
+    Expected<UnsignedSize, WouldBlock> send(const Byte* data, const UnsignedSize size) const;
+
+    /// Sends data to the peer the socket is connected to without throwing, \see send()
+    /// \returns The size of the data sent or the error.
+    Expected<UnsignedSize, SocketError> trySend(const Byte* data, const UnsignedSize size) const noexcept;
+
+    /// Receives data from the peer the socket is connected to
+    ///
+    /// The datagram and seqpacket sockets receive a single message per call, the part of the message that
+    /// doesn't fit is lost.
+    /// \param data The destination for the received data.
+    /// \param maxSize The maximum size of data we can receive at this time.
+    /// \returns If no error occurred, the size of the data received is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while receiving
+    /// the data.
+    Expected<UnsignedSize, WouldBlock> receive(Byte* data, const UnsignedSize maxSize) const;
+
+    /// Receives data from the peer the socket is connected to without throwing, \see receive()
+    /// \returns The size of the data received or the error.
+    Expected<UnsignedSize, SocketError> tryReceive(Byte* data, const UnsignedSize maxSize) const noexcept;
+
+    /// Sends all the data, retrying after partial sends and interruptions
+    /// \see Socket<IPProto::TCP>::sendAll()
+    Expected<UnsignedSize, SocketError>
+    sendAll(const Byte* data, const UnsignedSize size, UnsignedSize& sent) const noexcept;
+
+    /// Receives exactly the given size of data, retrying after partial receives and interruptions
+    /// \see Socket<IPProto::TCP>::receiveExact()
+    Expected<UnsignedSize, SocketError>
+    receiveExact(Byte* data, const UnsignedSize size, UnsignedSize& received) const noexcept;
+
+protected:
+    /// Creates an unbound socket
+    /// \throws Exception in case there were some problems while opening the socket.
+    UnixSocketBase();
+
+    /// Creates a socket from an already open socket handle
+    explicit UnixSocketBase(const SocketHandle socketHandle) noexcept;
+
+    /// Starts listening for incoming connections
+    /// \param backlogSize Hint to the socket determining the maximum number of outstanding connections in the
+    /// socket's listen queue.
+    /// \throws Exception in case the socket is not open or if there was some error while starting the
+    /// listening.
+    void listen(const int backlogSize);
+
+    /// Accepts a client connection
+    /// \returns A socket of the client connected
+    /// \throws Exception in case the socket is not open or if the accept failed for whatever reason.
+    Expected<Socket<TIPProto>, WouldBlock> accept() const;
+
+    /// Accepts a client connection without throwing, \see accept()
+    /// \returns A socket of the client connected or the error.
+    Expected<Socket<TIPProto>, SocketError> tryAccept() const noexcept;
+
+    /// Sends a datagram to the given address
+    /// \param data The data to send.
+    /// \param size The data size.
+    /// \param address The address the data will be sent to.
+    /// \returns If no error occurred, the size of the data sent is returned. An error is returned otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while sending the data.
+    Expected<UnsignedSize, WouldBlock>
+    sendTo(const Byte* data, const UnsignedSize size, const Address& address) const;
+
+    /// Sends a datagram to the given address without throwing, \see sendTo()
+    /// \returns The size of the data sent or the error, SocketError::unsupportedFamily() if the address is
+    /// not a Unix domain address.
+    Expected<UnsignedSize, SocketError>
+    trySendTo(const Byte* data, const UnsignedSize size, const Address& address) const noexcept;
+
+    /// Receives a datagram along with the address of the sender
+    ///
+    /// The address of a sender that isn't bound is unnamed, such a sender can't be replied to.
+    /// \param data The destination for the received data.
+    /// \param maxSize The maximum size of data we can receive at this time.
+    /// \param source[out] Storage for the source address.
+    /// \returns If no error occurred, the size of the data received is returned. An error is returned
+    /// otherwise.
+    /// \throws Exception in case the socket is not open or if there was some error while receiving
+    /// the data.
+    Expected<UnsignedSize, WouldBlock>
+    receiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) const;
+
+    /// Receives a datagram along with the address of the sender without throwing, \see receiveFrom()
+    /// \returns The size of the data received or the error.
+    Expected<UnsignedSize, SocketError>
+    tryReceiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) const noexcept;
+
+private:
+    // The IP addressing doesn't apply to the Unix domain sockets
+    using SocketBase::bindAll;
+    using SocketBase::getEndpoint;
+};
+
+/// RAII Unix domain stream socket wrapper
+///
+/// A reliable byte stream, the counterpart of Socket<IPProto::TCP>.
+template <>
+class Socket<IPProto::UnixStream> : public UnixSocketBase<IPProto::UnixStream> {
+public:
+    /// Creates an unbound Unix domain stream socket
+    Socket();
+
+    /// Creates an unbound Unix domain stream socket and sets the options
+    /// \throws Exception in case the socket couldn't be created or if any of the options couldn't be set.
+    explicit Socket(const SocketOptions<IPProto::UnixStream>& options);
+
+    using UnixSocketBase::accept;
+    using UnixSocketBase::listen;
+    using UnixSocketBase::tryAccept;
+
+private:
+    friend class UnixSocketBase<IPProto::UnixStream>;
+
+    explicit Socket(const SocketHandle socketHandle) noexcept;
+};
+
+/// RAII Unix domain datagram socket wrapper
+///
+/// Unlike UDP, the datagrams are reliable and kept in order, a sender blocks while the receive queue of the
+/// destination is full. Linux only.
+template <>
+class Socket<IPProto::UnixDatagram> : public UnixSocketBase<IPProto::UnixDatagram> {
+public:
+    /// Creates an unbound Unix domain datagram socket
+    Socket();
+
+    /// Creates an unbound Unix domain datagram socket and sets the options
+    /// \throws Exception in case the socket couldn't be created or if any of the options couldn't be set.
+    explicit Socket(const SocketOptions<IPProto::UnixDatagram>& options);
+
+    using UnixSocketBase::receiveFrom;
+    using UnixSocketBase::sendTo;
+    using UnixSocketBase::tryReceiveFrom;
+    using UnixSocketBase::trySendTo;
+
+private:
+    friend class UnixSocketBase<IPProto::UnixDatagram>;
+
+    explicit Socket(const SocketHandle socketHandle) noexcept;
+};
+
+/// RAII Unix domain sequenced-packet socket wrapper
+///
+/// Connection-oriented like the stream socket, but the boundaries of the messages are kept, each receive
+/// returns a single message. Linux only.
+template <>
+class Socket<IPProto::UnixSeqPacket> : public UnixSocketBase<IPProto::UnixSeqPacket> {
+public:
+    /// Creates an unbound Unix domain sequenced-packet socket
+    Socket();
+
+    /// Creates an unbound Unix domain sequenced-packet socket and sets the options
+    /// \throws Exception in case the socket couldn't be created or if any of the options couldn't be set.
+    explicit Socket(const SocketOptions<IPProto::UnixSeqPacket>& options);
+
+    using UnixSocketBase::accept;
+    using UnixSocketBase::listen;
+    using UnixSocketBase::tryAccept;
+
+private:
+    friend class UnixSocketBase<IPProto::UnixSeqPacket>;
+
+    explicit Socket(const SocketHandle socketHandle) noexcept;
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_SOCKETUNIX_H_
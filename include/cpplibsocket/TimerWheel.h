@@ -0,0 +1,160 @@
+#ifndef CPPLIBSOCKET_TIMERWHEEL_H_
+#define CPPLIBSOCKET_TIMERWHEEL_H_
+
+#include "cpplibsocket/SocketCommon.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace cpplibsocket {
+
+class TimerWheel;
+
+namespace detail {
+
+    /// Link of a circular doubly linked list of timers
+    struct TimerLink {
+        TimerLink* prev = this;
+        TimerLink* next = this;
+    };
+
+} // namespace detail
+
+/// Configuration of a TimerWheel
+struct TimerWheelOptions {
+    /// The granularity of the deadlines, the deadlines are rounded up to a multiple of it
+    std::chrono::steady_clock::duration resolution = std::chrono::milliseconds(1);
+};
+
+/// Deadline scheduled by a TimerWheel, e.g. an idle timeout or a read deadline of a connection
+///
+/// The timer is owned by the user, typically embedded in the state of the connection, so arming and
+/// re-arming it never allocates. Destroying an armed timer cancels it.
+class Timer final : private detail::TimerLink {
+public:
+    using Callback = std::function<void()>;
+
+    /// \param callback The function called once the deadline passes.
+    explicit Timer(Callback callback = Callback())
+        : mCallback(std::move(callback)) {}
+
+    ~Timer() noexcept { cancel(); }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    void setCallback(Callback callback) { mCallback = std::move(callback); }
+
+    /// Tells whether or not the timer is scheduled and hasn't expired yet
+    bool isArmed() const noexcept { return mWheel != nullptr; }
+
+    /// Cancels the timer, does nothing if it isn't armed
+    void cancel() noexcept;
+
+private:
+    friend class TimerWheel;
+
+    Callback mCallback;
+    TimerWheel* mWheel = nullptr;
+    std::uint64_t mExpiry = 0;
+    unsigned mList = 0;
+};
+
+/// Hierarchical timing wheel scheduling thousands of timers from a single event loop
+///
+/// Scheduling, re-scheduling and cancelling a timer are O(1) and involve no system call, which makes it
+/// suitable for deadlines re-armed on every message, unlike the socket timeouts (\see
+/// SocketBase::setTimeout()). The wheel has LEVELS levels of SLOTS slots, each level covering SLOTS times
+/// the span of the level below, timers are moved to the lower levels as their deadlines approach. Timers
+/// due beyond the span of the wheel are parked in its last slot and rescheduled when it's reached.
+///
+/// The wheel is driven by advance(), timeUntilNext() tells the timeout of the next poll of the event loop,
+/// \see Reactor::run(TimerWheel&). The wheel is not thread-safe.
+class TimerWheel final {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Options = TimerWheelOptions;
+
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1U << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    /// \param options The configuration of the wheel.
+    /// \param now The current time, the ticks of the wheel are counted from it.
+    /// \throws Exception in case the resolution is not positive.
+    explicit TimerWheel(const Options& options = Options(), const Clock::time_point now = Clock::now());
+
+    /// Disarms all the timers scheduled
+    ~TimerWheel() noexcept;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /// Schedules the timer, re-scheduling it if it's already armed, even by another wheel
+    /// \param timer The timer, it has to outlive its scheduling.
+    /// \param deadline The time the timer expires at, rounded up to the resolution. Deadlines already passed
+    /// expire on the next advance(), or on the current one if scheduled from a callback.
+    void schedule(Timer& timer, const Clock::time_point deadline) noexcept;
+
+    /// Schedules the timer to expire after the given time, \see schedule()
+    template <typename TRep, typename TPeriod>
+    void scheduleAfter(Timer& timer, const std::chrono::duration<TRep, TPeriod> timeout) noexcept {
+        schedule(timer, Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout));
+    }
+
+    /// Expires all the timers due at the given time, calling their callbacks
+    ///
+    /// The callbacks may schedule, cancel and destroy any of the timers, including their own.
+    /// \returns The number of timers expired.
+    /// \throws Exceptions thrown from the callbacks, the timers not expired yet stay scheduled.
+    UnsignedSize advance(const Clock::time_point now = Clock::now());
+
+    /// Returns the time until the wheel needs to be advanced next
+    ///
+    /// The time may be shorter than the time until the next deadline, as timers due far in the future are
+    /// moved to the lower levels on the way.
+    /// \returns The time, zero if some timer is due already and negative if no timer is scheduled.
+    Clock::duration timeUntilNext(const Clock::time_point now = Clock::now()) const noexcept;
+
+    /// Returns the number of timers scheduled
+    UnsignedSize size() const noexcept { return mSize; }
+
+    bool empty() const noexcept { return mSize == 0; }
+
+private:
+    friend class Timer;
+
+    using List = detail::TimerLink;
+
+    // The list of timers already due follows the slots of all the levels
+    static constexpr unsigned DUE_LIST = LEVELS * SLOTS;
+
+    static constexpr std::uint64_t NO_TICK = ~std::uint64_t(0);
+
+    /// Links the timer into the list its expiry belongs to, relative to the current tick
+    void link(Timer& timer) noexcept;
+
+    void unlink(Timer& timer) noexcept;
+
+    /// Returns the tick of the next slot start with some timers, NO_TICK if there are no timers
+    std::uint64_t nextTick() const noexcept;
+
+    /// Moves the timers of the slot starting at the current tick to the lower levels
+    void cascade(const unsigned level) noexcept;
+
+    /// Expires the timers of the given list
+    UnsignedSize expire(List& list);
+
+    Clock::time_point mStart;
+    Clock::duration mResolution;
+    std::uint64_t mTick = 0;
+    UnsignedSize mSize = 0;
+    std::array<List, LEVELS * SLOTS + 1> mLists;
+    std::array<std::uint64_t, LEVELS> mOccupied = {};
+};
+
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_TIMERWHEEL_H_
@@ -1,51 +1,123 @@
 #ifndef ENDIAN_H_
 #define ENDIAN_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
-
 class Endian {
 public:
     // TODO: Add another endians (ARM uses bi-endian .. for example)
     enum class Type { Little, Big, Unknown };
 
-    static Type getNative() {
-        return getInstance().mNativeEndian;
+    /// The byte order of the target, known at compile time
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    static constexpr Type NATIVE = Type::Little;
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr Type NATIVE = Type::Big;
+#elif defined(_WIN32)
+    static constexpr Type NATIVE = Type::Little;
+#else
+    static constexpr Type NATIVE = Type::Unknown;
+#endif
+
+    static constexpr Type getNative() noexcept { return NATIVE; }
+
+    template <typename T>
+    static T convertToNative(const T& value, const Type sourceEndian) noexcept {
+        return sourceEndian == getNative() ? value : inverseEndian(value);
     }
 
     template <typename T>
-    static T convertToNative(const T& value, const Type sourceEndian) {
-        return getInstance().convertToNativeImpl(value, sourceEndian);
+    static T convertNativeTo(const T& value, const Type targetEndian) noexcept {
+        return convertToNative(value, targetEndian);
+    }
+
+    /// Converts an array of values from the given byte order to the native one
+    ///
+    /// Integers and floating point numbers of 2, 4 and 8 bytes are converted by SIMD kernels where the CPU
+    /// supports them (SSSE3, AVX2). The conversion may be done in place, otherwise the arrays must not
+    /// overlap.
+    template <typename T>
+    static void convertToNative(const T* source,
+                                T* destination,
+                                const std::size_t count,
+                                const Type sourceEndian) noexcept {
+        static_assert(std::is_arithmetic<T>::value, "Only arrays of numbers can be converted");
+        static_assert(sizeof(T) == 1 || HasSwappableSize<T>::value, "Only numbers of up to 8 bytes");
+        if (sourceEndian == getNative() || sizeof(T) == 1) {
+            if (source != destination) {
+                std::memcpy(destination, source, count * sizeof(T));
+            }
+            return;
+        }
+        swapBytes(source, destination, count * sizeof(T), sizeof(T));
     }
 
+    /// Converts an array of values from the native byte order to the given one, \see convertToNative()
     template <typename T>
-    static T convertNativeTo(const T& value, const Type targetEndian) {
-        return getInstance().convertNativeToImpl(value, targetEndian);
+    static void convertNativeTo(const T* source,
+                                T* destination,
+                                const std::size_t count,
+                                const Type targetEndian) noexcept {
+        convertToNative(source, destination, count, targetEndian);
+    }
+
+    static constexpr std::uint16_t byteSwap(const std::uint16_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap16(value);
+#else
+        return static_cast<std::uint16_t>((value << 8) | (value >> 8));
+#endif
+    }
+
+    static constexpr std::uint32_t byteSwap(const std::uint32_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(value);
+#else
+        return ((value & 0x000000ffu) << 24) | ((value & 0x0000ff00u) << 8) | ((value & 0x00ff0000u) >> 8) |
+               ((value & 0xff000000u) >> 24);
+#endif
+    }
+
+    static constexpr std::uint64_t byteSwap(const std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(value);
+#else
+        return (std::uint64_t(byteSwap(static_cast<std::uint32_t>(value))) << 32) |
+               byteSwap(static_cast<std::uint32_t>(value >> 32));
+#endif
     }
 
 private:
-    Endian()
-        : mNativeEndian(findOutNativeEndian()) {}
+    template <std::size_t TSize>
+    struct UnsignedOfSize {};
 
-    static const Endian& getInstance() {
-        static Endian instance;
-        return instance;
+    template <typename T>
+    using HasSwappableSize = std::integral_constant<bool,
+                                                    sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8>;
+
+    template <typename T>
+    static T inverseEndian(const T& value) noexcept {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values");
+        return inverseEndian(value, HasSwappableSize<T>());
     }
 
-    static Type findOutNativeEndian() {
-        const uint32_t testValue = 0x00000001;
-        if(*(reinterpret_cast<const char*>(&testValue) + 3) & 0x01) {
-            return Type::Big;
-        } else if(*(reinterpret_cast<const char*>(&testValue)) & 0x01) {
-            return Type::Little;
-        } else {
-            return Type::Unknown;
-        }
+    // Values of 2, 4 and 8 bytes are swapped as a whole by a single instruction
+    template <typename T>
+    static T inverseEndian(const T& value, std::true_type) noexcept {
+        using Bits = typename UnsignedOfSize<sizeof(T)>::type;
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        bits = byteSwap(bits);
+        T result;
+        std::memcpy(&result, &bits, sizeof(T));
+        return result;
     }
 
-    template <typename T, typename std::enable_if<std::is_trivially_default_constructible<T>::value, char>::type = 0>
-    static T inverseEndian(const T& value) {
+    template <typename T>
+    static T inverseEndian(const T& value, std::false_type) noexcept {
         const std::size_t typeSize = sizeof(T);
 
         const char* ptrSrc = reinterpret_cast<const char*>(&value);
@@ -60,21 +132,26 @@ private:
         return result;
     }
 
-    template <typename T>
-    static T convertToNativeImpl(const T& value, const Type sourceEndian) {
-        if(sourceEndian == getNative()) {
-            return value;
-        } else {
-            return inverseEndian(value);
-        }
-    }
+    /// Reverses the bytes of each of the values of the given width (2, 4 or 8) in the data
+    static void swapBytes(const void* source,
+                          void* destination,
+                          const std::size_t size,
+                          const std::size_t width) noexcept;
+};
 
-    template <typename T>
-    static T convertNativeToImpl(const T& value, const Type targetEndian) {
-        return convertToNativeImpl(value, targetEndian);
-    }
+template <>
+struct Endian::UnsignedOfSize<2> {
+    using type = std::uint16_t;
+};
+
+template <>
+struct Endian::UnsignedOfSize<4> {
+    using type = std::uint32_t;
+};
 
-    Type mNativeEndian;
+template <>
+struct Endian::UnsignedOfSize<8> {
+    using type = std::uint64_t;
 };
 
 #endif
@@ -0,0 +1,265 @@
+#ifndef CPPLIBSOCKET_UTILS_ADDRESSPARSER_H_
+#define CPPLIBSOCKET_UTILS_ADDRESSPARSER_H_
+
+#include "cpplibsocket/SocketCommon.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace cpplibsocket {
+namespace utils {
+
+    /// Raw IP address in network byte order
+    struct IpBytes {
+        IPVer ipVersion = IPVer::IPV4;
+        std::uint8_t bytes[16] = {};
+    };
+
+    namespace detail {
+        constexpr int hexValue(const char c) noexcept {
+            return (c >= '0' && c <= '9')   ? c - '0'
+                   : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                   : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                            : -1;
+        }
+
+        constexpr bool isDigit(const char c) noexcept { return c >= '0' && c <= '9'; }
+    } // namespace detail
+
+    /// Parses an IPv4 address in the dotted-decimal notation
+    ///
+    /// Only the strict form of four decimal octets without leading zeros is accepted.
+    /// \param str The string to parse, doesn't have to be null-terminated.
+    /// \param size The size of the string.
+    /// \param out[out] The parsed address in network byte order.
+    /// \returns true if the whole string is a valid IPv4 address, false otherwise.
+    constexpr bool parseIPv4(const char* str, const std::size_t size, std::uint8_t* out) noexcept {
+        std::size_t pos = 0;
+        for (int octet = 0; octet < 4; ++octet) {
+            if (octet > 0) {
+                if (pos >= size || str[pos] != '.') {
+                    return false;
+                }
+                ++pos;
+            }
+            const std::size_t start = pos;
+            unsigned value = 0;
+            while (pos < size && detail::isDigit(str[pos]) && pos - start < 3) {
+                value = value * 10 + static_cast<unsigned>(str[pos] - '0');
+                ++pos;
+            }
+            const std::size_t digits = pos - start;
+            if (digits == 0 || value > 255 || (digits > 1 && str[start] == '0')) {
+                return false;
+            }
+            out[octet] = static_cast<std::uint8_t>(value);
+        }
+        return pos == size;
+    }
+
+    /// Parses an IPv6 address in the textual form described by RFC 4291 section 2.2
+    ///
+    /// Zero compression ("::") and embedded IPv4 addresses are supported, zone identifiers are not.
+    /// \param str The string to parse, doesn't have to be null-terminated.
+    /// \param size The size of the string.
+    /// \param out[out] The parsed address in network byte order.
+    /// \returns true if the whole string is a valid IPv6 address, false otherwise.
+    constexpr bool parseIPv6(const char* str, const std::size_t size, std::uint8_t* out) noexcept {
+        std::uint8_t bytes[16] = {};
+        int filled = 0;
+        int compressedAt = -1;
+        std::size_t pos = 0;
+        if (size >= 2 && str[0] == ':' && str[1] == ':') {
+            compressedAt = 0;
+            pos = 2;
+        } else if (size >= 1 && str[0] == ':') {
+            return false;
+        }
+        while (pos < size) {
+            if (filled == 16) {
+                return false;
+            }
+            const std::size_t start = pos;
+            unsigned value = 0;
+            while (pos < size && pos - start < 4) {
+                const int digit = detail::hexValue(str[pos]);
+                if (digit < 0) {
+                    break;
+                }
+                value = (value << 4) | static_cast<unsigned>(digit);
+                ++pos;
+            }
+            if (pos < size && str[pos] == '.') {
+                // An embedded IPv4 address may only form the last 32 bits
+                if (filled > 12 || !parseIPv4(str + start, size - start, bytes + filled)) {
+                    return false;
+                }
+                filled += 4;
+                break;
+            }
+            if (pos == start) {
+                return false;
+            }
+            bytes[filled++] = static_cast<std::uint8_t>(value >> 8);
+            bytes[filled++] = static_cast<std::uint8_t>(value & 0xff);
+            if (pos == size) {
+                break;
+            }
+            if (str[pos] != ':') {
+                return false;
+            }
+            ++pos;
+            if (pos < size && str[pos] == ':') {
+                if (compressedAt != -1) {
+                    return false;
+                }
+                compressedAt = filled;
+                ++pos;
+            } else if (pos == size) {
+                return false; // Trailing single colon
+            }
+        }
+
+        if (compressedAt == -1) {
+            if (filled != 16) {
+                return false;
+            }
+        } else {
+            if (filled == 16) {
+                return false; // "::" has to stand for at least one group
+            }
+            const int tail = filled - compressedAt;
+            for (int i = 0; i < tail; ++i) {
+                bytes[15 - i] = bytes[filled - 1 - i];
+            }
+            for (int i = compressedAt; i < 16 - tail; ++i) {
+                bytes[i] = 0;
+            }
+        }
+        for (int i = 0; i < 16; ++i) {
+            out[i] = bytes[i];
+        }
+        return true;
+    }
+
+    /// Parses a numeric IP address of the given version without any allocation
+    /// \returns true if the whole string is a valid address of the given version, false otherwise.
+    constexpr bool
+    parseIp(const IPVer ipVersion, const char* str, const std::size_t size, IpBytes& out) noexcept {
+        out.ipVersion = ipVersion;
+        return ipVersion == IPVer::IPV4 ? parseIPv4(str, size, out.bytes) : parseIPv6(str, size, out.bytes);
+    }
+
+    /// Parses a decimal port number
+    constexpr bool parsePort(const char* str, const std::size_t size, Port& out) noexcept {
+        if (size == 0 || size > 5) {
+            return false;
+        }
+        unsigned value = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!detail::isDigit(str[i])) {
+                return false;
+            }
+            value = value * 10 + static_cast<unsigned>(str[i] - '0');
+        }
+        if (value > 65535) {
+            return false;
+        }
+        out = static_cast<Port>(value);
+        return true;
+    }
+
+    /// IP address and port parsed at compile time, \see literals::operator""_addr
+    class StaticAddress final {
+    public:
+        constexpr StaticAddress(const IpBytes& ip, const Port port) noexcept
+            : mIp(ip)
+            , mPort(port) {}
+
+        constexpr IPVer ipVersion() const noexcept { return mIp.ipVersion; }
+
+        constexpr const IpBytes& ip() const noexcept { return mIp; }
+
+        constexpr Port port() const noexcept { return mPort; }
+
+        /// Creates the native address structure
+        Address toAddress() const noexcept {
+            Address addr = {};
+            if (mIp.ipVersion == IPVer::IPV4) {
+                addr.sa_in.sin_family = AF_INET;
+                addr.sa_in.sin_port = htons(mPort);
+                std::memcpy(&addr.sa_in.sin_addr, mIp.bytes, 4);
+            } else {
+                addr.sa_in6.sin6_family = AF_INET6;
+                addr.sa_in6.sin6_port = htons(mPort);
+                std::memcpy(&addr.sa_in6.sin6_addr, mIp.bytes, 16);
+            }
+            return addr;
+        }
+
+        operator Address() const noexcept { return toAddress(); }
+
+    private:
+        IpBytes mIp;
+        Port mPort;
+    };
+
+    struct InvalidAddressLiteral {};
+
+    /// Parses an endpoint in one of the forms "1.2.3.4", "1.2.3.4:80", "::1" or "[::1]:80"
+    /// \throws InvalidAddressLiteral if the string is not a valid endpoint. If used in a constexpr context,
+    /// the compilation fails with this error.
+    constexpr StaticAddress parseStaticAddress(const char* str, const std::size_t size) {
+        IpBytes ip;
+        Port port = 0;
+        if (size > 0 && str[0] == '[') {
+            std::size_t close = 1;
+            while (close < size && str[close] != ']') {
+                ++close;
+            }
+            if (close == size || !parseIp(IPVer::IPV6, str + 1, close - 1, ip)) {
+                throw InvalidAddressLiteral();
+            }
+            if (close + 1 != size &&
+                (str[close + 1] != ':' || !parsePort(str + close + 2, size - close - 2, port))) {
+                throw InvalidAddressLiteral();
+            }
+            return StaticAddress(ip, port);
+        }
+
+        std::size_t colons = 0;
+        std::size_t lastColon = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (str[i] == ':') {
+                ++colons;
+                lastColon = i;
+            }
+        }
+        if (colons > 1) {
+            if (!parseIp(IPVer::IPV6, str, size, ip)) {
+                throw InvalidAddressLiteral();
+            }
+        } else if (colons == 1) {
+            if (!parseIp(IPVer::IPV4, str, lastColon, ip) ||
+                !parsePort(str + lastColon + 1, size - lastColon - 1, port)) {
+                throw InvalidAddressLiteral();
+            }
+        } else if (!parseIp(IPVer::IPV4, str, size, ip)) {
+            throw InvalidAddressLiteral();
+        }
+        return StaticAddress(ip, port);
+    }
+
+} // namespace utils
+
+namespace literals {
+
+    /// Creates an address parsed at compile time, e.g. "10.0.0.1:8125"_addr or "[::1]:80"_addr
+    constexpr utils::StaticAddress operator"" _addr(const char* str, const std::size_t size) {
+        return utils::parseStaticAddress(str, size);
+    }
+
+} // namespace literals
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_UTILS_ADDRESSPARSER_H_
@@ -6,10 +6,14 @@
 #include <iostream>
 
 inline std::ostream& operator<<(std::ostream& o, const cpplibsocket::Endpoint& endpoint) {
-    o << (endpoint.ipVersion == cpplibsocket::IPVer::IPV4
-              ? (endpoint.ip.empty() ? "0.0.0.0" : endpoint.ip)
-              : (endpoint.ip.empty() ? "[::/0]" : ("[" + endpoint.ip + "]")))
-      << ':' << endpoint.port;
+    if (endpoint.ipVersion == cpplibsocket::IPVer::IPV4) {
+        o << (endpoint.ip.empty() ? "0.0.0.0" : endpoint.ip.c_str());
+    } else if (endpoint.ip.empty()) {
+        o << "[::/0]";
+    } else {
+        o << '[' << endpoint.ip << ']';
+    }
+    o << ':' << endpoint.port;
     return o;
 }
 
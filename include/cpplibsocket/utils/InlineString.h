@@ -0,0 +1,87 @@
+#ifndef CPPLIBSOCKET_UTILS_INLINESTRING_H_
+#define CPPLIBSOCKET_UTILS_INLINESTRING_H_
+
+#include "cpplibsocket/common/Exception.h"
+#include "cpplibsocket/common/common.h"
+
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace cpplibsocket {
+namespace utils {
+
+    /// Null-terminated string of a limited length stored inline, without any heap allocation
+    ///
+    /// The object is trivially copyable.
+    template <std::size_t TCapacity>
+    class InlineString final {
+    public:
+        InlineString() noexcept
+            : mSize(0) {
+            mData[0] = '\0';
+        }
+
+        /// \throws Exception in case the string is longer than TCapacity.
+        InlineString(const char* str)
+            : InlineString(str, std::strlen(str)) {}
+
+        /// \throws Exception in case the string is longer than TCapacity.
+        InlineString(const std::string& str)
+            : InlineString(str.data(), str.size()) {}
+
+        /// \throws Exception in case the string is longer than TCapacity.
+        InlineString(const char* str, const std::size_t size)
+            : mSize(size) {
+            if (size > TCapacity) {
+                throw Exception(FUNC_NAME, "String of length ", size, " exceeds the capacity of ", TCapacity);
+            }
+            std::memcpy(mData, str, size);
+            mData[size] = '\0';
+        }
+
+        const char* c_str() const noexcept { return mData; }
+
+        const char* data() const noexcept { return mData; }
+
+        std::size_t size() const noexcept { return mSize; }
+
+        bool empty() const noexcept { return mSize == 0; }
+
+        static constexpr std::size_t capacity() noexcept { return TCapacity; }
+
+        /// Creates a std::string copy of this string
+        std::string str() const { return std::string(mData, mSize); }
+
+        operator std::string() const { return str(); }
+
+        friend bool operator==(const InlineString& lhs, const InlineString& rhs) noexcept {
+            return lhs.mSize == rhs.mSize && std::memcmp(lhs.mData, rhs.mData, lhs.mSize) == 0;
+        }
+
+        friend bool operator==(const InlineString& lhs, const char* rhs) noexcept {
+            return std::strcmp(lhs.mData, rhs) == 0;
+        }
+
+        friend bool operator==(const InlineString& lhs, const std::string& rhs) noexcept {
+            return lhs.mSize == rhs.size() && std::memcmp(lhs.mData, rhs.data(), lhs.mSize) == 0;
+        }
+
+        template <typename T>
+        friend bool operator!=(const InlineString& lhs, const T& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+        friend std::ostream& operator<<(std::ostream& o, const InlineString& str) {
+            return o.write(str.mData, static_cast<std::streamsize>(str.mSize));
+        }
+
+    private:
+        std::size_t mSize;
+        char mData[TCapacity + 1];
+    };
+
+} // namespace utils
+} // namespace cpplibsocket
+
+#endif // CPPLIBSOCKET_UTILS_INLINESTRING_H_
@@ -94,14 +94,35 @@ namespace utils {
 
     Address getAddressFromFd(SocketHandle socket);
 
+    /// Returns the address of the peer the socket is connected to
+    /// \throws Exception in case the socket is not connected.
+    Address getPeerAddressFromFd(SocketHandle socket);
+
     Endpoint getEndpoint(const Address& address);
 
     Endpoint getEndpoint(SocketHandle socket);
 
+    /// Returns the time left until the deadline as a poll timeout in milliseconds, rounded up
+    int remainingTimeoutMs(const std::chrono::steady_clock::time_point deadline) noexcept;
+
     Address createAddr(const Endpoint& endpoint);
 
     Address createAddr(const IPVer ipVersion, const std::string& ipAddress, const Port port);
 
+    /// Creates a Unix domain address of the filesystem path
+    /// \throws Exception in case the path is empty, too long or if it contains a NUL byte.
+    Address createUnixAddr(const std::string& path);
+
+    /// Creates a Unix domain address in the abstract namespace (Linux only), which isn't bound to any file
+    /// and disappears along with the last socket bound to it
+    /// \param name The name without the leading NUL byte, e.g. "my-service".
+    /// \throws Exception in case the name is empty, too long or if it contains a NUL byte.
+    Address createAbstractAddr(const std::string& name);
+
+    /// Returns the path of the Unix domain address, the name prefixed by '@' for the abstract ones, or an
+    /// empty string for an unbound (unnamed) socket
+    std::string getUnixPath(const Address& address);
+
     static constexpr NullOptionalT UnspecIPVer = NullOptional;
 
     Optional<Address> resolveHostname(const std::string& hostname,
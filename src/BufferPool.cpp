@@ -0,0 +1,343 @@
+#include "cpplibsocket/BufferPool.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace cpplibsocket {
+
+namespace {
+
+    // The most common huge page size (x86-64, AArch64 with 4 KiB pages)
+    constexpr UnsignedSize HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    UnsignedSize roundUp(const UnsignedSize value, const UnsignedSize multiple) noexcept {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+} // namespace
+
+namespace detail {
+
+    class BufferPoolState final : public std::enable_shared_from_this<BufferPoolState> {
+    public:
+        struct SizeClass {
+            UnsignedSize bufferSize;
+            /// The length of the memory mapped for a chunk, the tail not fitting a whole buffer is unused
+            UnsignedSize chunkSize;
+            /// The number of buffers carved from a chunk
+            UnsignedSize chunkBuffers;
+            /// The number of buffers allocated, the free list has the capacity for all of them, so giving the
+            /// buffers back never allocates
+            UnsignedSize count;
+            std::vector<BufferHeader*> free;
+        };
+
+        struct Chunk {
+            void* memory;
+            UnsignedSize size;
+            std::unique_ptr<BufferHeader[]> headers;
+        };
+
+        BufferPoolState(const std::uint64_t id_, const BufferPoolOptions& options_)
+            : id(id_)
+            , options(options_) {}
+
+        BufferPoolState(const BufferPoolState&) = delete;
+        BufferPoolState& operator=(const BufferPoolState&) = delete;
+
+        ~BufferPoolState() noexcept {
+            for (const Chunk& chunk : chunks) {
+                const bool unmapped = Platform::unmapMemory(chunk.memory, chunk.size);
+                ASSERT(unmapped);
+                (void)unmapped;
+            }
+        }
+
+        /// Moves up to count free buffers of the class to the end of the list, allocating a chunk if needed
+        /// \returns False if no buffer could be moved, with the reason in the error.
+        bool take(const std::uint32_t sizeClass,
+                  std::vector<BufferHeader*>& list,
+                  const UnsignedSize count,
+                  const char** error) noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<BufferHeader*>& free = classes[sizeClass].free;
+            if (free.empty() && !allocateChunk(sizeClass, error)) {
+                return false;
+            }
+            const UnsignedSize taken = std::min(count, free.size());
+            list.insert(list.end(), free.end() - taken, free.end());
+            free.resize(free.size() - taken);
+            return true;
+        }
+
+        /// Takes a single free buffer of the class, bypassing the thread caches
+        BufferHeader* takeOne(const std::uint32_t sizeClass, const char** error) noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<BufferHeader*>& free = classes[sizeClass].free;
+            if (free.empty() && !allocateChunk(sizeClass, error)) {
+                return nullptr;
+            }
+            BufferHeader* header = free.back();
+            free.pop_back();
+            return header;
+        }
+
+        /// Moves the buffers from the given position to the end of the list back to the pool
+        void give(const std::uint32_t sizeClass,
+                  std::vector<BufferHeader*>& list,
+                  const std::vector<BufferHeader*>::iterator from) noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<BufferHeader*>& free = classes[sizeClass].free;
+            free.insert(free.end(), from, list.end());
+            list.erase(from, list.end());
+        }
+
+        /// Gives a single buffer back to the pool, bypassing the thread caches
+        void giveOne(BufferHeader* header) noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            classes[header->sizeClass].free.push_back(header);
+        }
+
+        const std::uint64_t id;
+        const BufferPoolOptions options;
+        std::vector<SizeClass> classes;
+        std::atomic<UnsignedSize> allocated{ 0 };
+        std::atomic<bool> hugePages{ false };
+
+    private:
+        bool allocateChunk(const std::uint32_t sizeClass, const char** error) noexcept {
+            SizeClass& buffers = classes[sizeClass];
+            const UnsignedSize allocatedNow = allocated.load(std::memory_order_relaxed);
+            if (options.maxMemory != 0 && allocatedNow + buffers.chunkSize > options.maxMemory) {
+                *error = "The memory limit of the pool was reached";
+                return false;
+            }
+            const UnsignedSize count = buffers.chunkBuffers;
+            try {
+                chunks.reserve(chunks.size() + 1);
+                buffers.free.reserve(buffers.count + count);
+                Chunk chunk{ nullptr, buffers.chunkSize, std::unique_ptr<BufferHeader[]>() };
+                chunk.headers.reset(new BufferHeader[count]);
+                bool mappedHugePages = false;
+                chunk.memory = Platform::mapMemory(chunk.size, options.hugePages, &mappedHugePages);
+                if (!chunk.memory) {
+                    *error = "Couldn't allocate the memory";
+                    return false;
+                }
+                Byte* data = static_cast<Byte*>(chunk.memory);
+                // Pushed in reverse, so the buffers are taken in the address order
+                for (UnsignedSize i = count; i-- > 0;) {
+                    BufferHeader& header = chunk.headers[i];
+                    header.data = data + i * buffers.bufferSize;
+                    header.capacity = buffers.bufferSize;
+                    header.size = 0;
+                    header.pool = this;
+                    header.sizeClass = sizeClass;
+                    header.references.store(0, std::memory_order_relaxed);
+                    buffers.free.push_back(&header);
+                }
+                chunks.push_back(std::move(chunk));
+                buffers.count += count;
+                allocated.store(allocatedNow + buffers.chunkSize, std::memory_order_relaxed);
+                if (mappedHugePages) {
+                    hugePages.store(true, std::memory_order_relaxed);
+                }
+                return true;
+            } catch (const std::bad_alloc&) {
+                *error = "Couldn't allocate the buffer headers";
+                return false;
+            }
+        }
+
+        std::mutex mutex;
+        std::vector<Chunk> chunks;
+    };
+
+} // namespace detail
+
+namespace {
+
+    // Free buffers of a single pool cached by a thread
+    struct ThreadCache {
+        std::uint64_t poolId;
+        std::weak_ptr<detail::BufferPoolState> pool;
+        std::vector<std::vector<detail::BufferHeader*>> classes;
+
+        void flush(detail::BufferPoolState& state) noexcept {
+            for (std::uint32_t i = 0; i < classes.size(); ++i) {
+                state.give(i, classes[i], classes[i].begin());
+            }
+        }
+    };
+
+    // The caches of all the pools used by a thread, given back to the pools still alive when the thread exits
+    class ThreadCaches final {
+    public:
+        ~ThreadCaches() noexcept {
+            for (ThreadCache& cache : mCaches) {
+                if (const std::shared_ptr<detail::BufferPoolState> state = cache.pool.lock()) {
+                    cache.flush(*state);
+                }
+            }
+        }
+
+        /// Returns the cache of the pool, nullptr if there's none
+        ThreadCache* find(const std::uint64_t poolId) noexcept {
+            // Typically a thread uses just one or two pools, so the search is short
+            for (ThreadCache& cache : mCaches) {
+                if (cache.poolId == poolId) {
+                    return &cache;
+                }
+            }
+            return nullptr;
+        }
+
+        /// Returns the cache of the pool, creating it if needed, nullptr if it couldn't be created
+        ThreadCache* get(detail::BufferPoolState& state) noexcept {
+            if (ThreadCache* cache = find(state.id)) {
+                return cache;
+            }
+            // The caches of destroyed pools only hold dangling pointers to their memory
+            mCaches.erase(std::remove_if(mCaches.begin(),
+                                         mCaches.end(),
+                                         [](const ThreadCache& cache) { return cache.pool.expired(); }),
+                          mCaches.end());
+            try {
+                ThreadCache cache{ state.id, state.shared_from_this(), {} };
+                cache.classes.resize(state.classes.size());
+                // One more than the capacity, the overflow is detected after the buffer is pushed
+                for (std::vector<detail::BufferHeader*>& list : cache.classes) {
+                    list.reserve(state.options.threadCacheSize + 1);
+                }
+                mCaches.push_back(std::move(cache));
+            } catch (const std::bad_alloc&) {
+                return nullptr;
+            }
+            return &mCaches.back();
+        }
+
+        void erase(const std::uint64_t poolId) noexcept {
+            const auto matches = [poolId](const ThreadCache& cache) { return cache.poolId == poolId; };
+            mCaches.erase(std::remove_if(mCaches.begin(), mCaches.end(), matches), mCaches.end());
+        }
+
+    private:
+        std::vector<ThreadCache> mCaches;
+    };
+
+    thread_local ThreadCaches tThreadCaches;
+
+    std::atomic<std::uint64_t> gNextPoolId{ 0 };
+
+    detail::BufferHeader* takeBuffer(detail::BufferPoolState& state,
+                                     const UnsignedSize size,
+                                     const char** error) noexcept {
+        const auto sizeClass = std::lower_bound(
+            state.classes.begin(),
+            state.classes.end(),
+            size,
+            [](const detail::BufferPoolState::SizeClass& buffers, const UnsignedSize value) {
+                return buffers.bufferSize < value;
+            });
+        if (sizeClass == state.classes.end()) {
+            *error = "The size exceeds the largest buffer class";
+            return nullptr;
+        }
+        const std::uint32_t index = static_cast<std::uint32_t>(sizeClass - state.classes.begin());
+
+        detail::BufferHeader* header = nullptr;
+        ThreadCache* cache = state.options.threadCacheSize != 0 ? tThreadCaches.get(state) : nullptr;
+        if (cache) {
+            std::vector<detail::BufferHeader*>& list = cache->classes[index];
+            // Refilled by half of the capacity, so the next releases don't overflow the cache right away
+            if (list.empty() && !state.take(index, list, (state.options.threadCacheSize + 1) / 2, error)) {
+                return nullptr;
+            }
+            header = list.back();
+            list.pop_back();
+        } else {
+            header = state.takeOne(index, error);
+            if (!header) {
+                return nullptr;
+            }
+        }
+        header->size = size;
+        header->references.store(1, std::memory_order_relaxed);
+        return header;
+    }
+
+} // namespace
+
+void detail::releaseBuffer(BufferHeader* header) noexcept {
+    BufferPoolState& state = *header->pool;
+    ThreadCache* cache = state.options.threadCacheSize != 0 ? tThreadCaches.get(state) : nullptr;
+    if (!cache) {
+        state.giveOne(header);
+        return;
+    }
+    std::vector<BufferHeader*>& list = cache->classes[header->sizeClass];
+    list.push_back(header);
+    if (list.size() > state.options.threadCacheSize) {
+        state.give(header->sizeClass, list, list.begin() + state.options.threadCacheSize / 2);
+    }
+}
+
+BufferPool::BufferPool(const Options& options)
+    : mState(std::make_shared<detail::BufferPoolState>(gNextPoolId.fetch_add(1, std::memory_order_relaxed),
+                                                       options)) {
+    std::vector<UnsignedSize> sizes = options.bufferSizes;
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    if (sizes.empty() || sizes.front() == 0) {
+        throw Exception(FUNC_NAME, "The buffer sizes have to be non-zero");
+    }
+    if (options.chunkSize == 0) {
+        throw Exception(FUNC_NAME, "The chunk size has to be non-zero");
+    }
+    for (const UnsignedSize bufferSize : sizes) {
+        UnsignedSize chunkSize = roundUp(std::max(options.chunkSize, bufferSize), bufferSize);
+        if (options.hugePages) {
+            chunkSize = roundUp(chunkSize, HUGE_PAGE_SIZE);
+        }
+        mState->classes.push_back({ bufferSize, chunkSize, chunkSize / bufferSize, 0, {} });
+    }
+}
+
+BufferPool::~BufferPool() noexcept {
+    flushThreadCache();
+}
+
+PooledBuffer BufferPool::acquire(const UnsignedSize size) {
+    const char* error = nullptr;
+    detail::BufferHeader* header = takeBuffer(*mState, size, &error);
+    if (!header) {
+        throw Exception(FUNC_NAME, "Couldn't take a buffer of size ", size, " - ", error);
+    }
+    return PooledBuffer(header);
+}
+
+PooledBuffer BufferPool::tryAcquire(const UnsignedSize size) noexcept {
+    const char* error = nullptr;
+    return PooledBuffer(takeBuffer(*mState, size, &error));
+}
+
+UnsignedSize BufferPool::maxBufferSize() const noexcept {
+    return mState->classes.back().bufferSize;
+}
+
+UnsignedSize BufferPool::allocatedMemory() const noexcept {
+    return mState->allocated.load(std::memory_order_relaxed);
+}
+
+bool BufferPool::usesHugePages() const noexcept {
+    return mState->hugePages.load(std::memory_order_relaxed);
+}
+
+void BufferPool::flushThreadCache() noexcept {
+    if (ThreadCache* cache = tThreadCaches.find(mState->id)) {
+        cache->flush(*mState);
+        tThreadCaches.erase(mState->id);
+    }
+}
+
+} // namespace cpplibsocket
@@ -0,0 +1,281 @@
+#include "cpplibsocket/ConnectionPool.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <algorithm>
+
+namespace cpplibsocket {
+
+ConnectionPool::HostKey::HostKey(const Address& address)
+    : family(address.sa.sa_family)
+    , port(0)
+    , scope(0)
+    , ip() {
+    switch (family) {
+    case AF_INET:
+        port = address.sa_in.sin_port;
+        std::memcpy(ip.data(), &address.sa_in.sin_addr, sizeof(address.sa_in.sin_addr));
+        break;
+    case AF_INET6:
+        port = address.sa_in6.sin6_port;
+        scope = address.sa_in6.sin6_scope_id;
+        std::memcpy(ip.data(), &address.sa_in6.sin6_addr, sizeof(address.sa_in6.sin6_addr));
+        break;
+    default:
+        throw Exception(FUNC_NAME, "Address family ", family, " is not supported");
+    }
+}
+
+bool ConnectionPool::HostKey::operator==(const HostKey& other) const noexcept {
+    return family == other.family && port == other.port && scope == other.scope && ip == other.ip;
+}
+
+std::size_t ConnectionPool::HostKeyHash::operator()(const HostKey& key) const noexcept {
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ULL;
+    const auto mix = [&hash](const Byte byte) noexcept {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for (const Byte byte : key.ip) {
+        mix(byte);
+    }
+    mix(static_cast<Byte>(key.port));
+    mix(static_cast<Byte>(key.port >> 8));
+    mix(static_cast<Byte>(key.family));
+    mix(static_cast<Byte>(key.scope));
+    return static_cast<std::size_t>(hash);
+}
+
+ConnectionPool::ConnectionPool(const Options& options)
+    : mOptions(options) {}
+
+ConnectionPool::~ConnectionPool() noexcept = default;
+
+ConnectionPool::Lease ConnectionPool::acquire(const Address& address) {
+    return acquireUntil(address, nullptr);
+}
+
+ConnectionPool::Lease ConnectionPool::acquireUntil(const Address& address,
+                                                   const Clock::time_point* deadline) {
+    const HostKey key(address);
+    std::unique_lock<std::mutex> lock(mMutex);
+    std::unique_ptr<Host>& entry = mHosts[key];
+    if (!entry) {
+        entry.reset(new Host());
+    }
+    Host& host = *entry;
+    while (true) {
+        if (!host.idle.empty()) {
+            IdleConnection idle = std::move(host.idle.back());
+            host.idle.pop_back();
+            // Checked without the lock, the connection is neither idle nor leased in the meantime
+            lock.unlock();
+            if (Clock::now() - idle.since <= mOptions.idleTimeout && isHealthy(idle.socket)) {
+                return Lease(*this, host, std::move(idle.socket), true);
+            }
+            try {
+                idle.socket.close();
+            } catch (const Exception&) {
+            }
+            lock.lock();
+            --host.connections;
+            continue;
+        }
+        if (mOptions.maxPerHost == 0 || host.connections < mOptions.maxPerHost) {
+            break;
+        }
+        if (!deadline) {
+            host.released.wait(lock);
+        } else if (host.released.wait_until(lock, *deadline) == std::cv_status::timeout) {
+            const Endpoint endpoint = utils::getEndpoint(address);
+            throw Exception(FUNC_NAME,
+                            "Timed out waiting for a connection to ",
+                            endpoint.ip,
+                            ":",
+                            endpoint.port,
+                            " to be returned");
+        }
+    }
+    // The slot is reserved while connecting, so the limit holds
+    ++host.connections;
+    lock.unlock();
+    try {
+        Socket<IPProto::TCP> socket(toIPVer(address.sa.sa_family), mOptions.socketOptions);
+        if (!deadline) {
+            socket.connect(address);
+            return Lease(*this, host, std::move(socket), false);
+        }
+        // The deadline also bounds the connecting, an unreachable host would block for the SYN retries
+        const std::chrono::milliseconds timeout(utils::remainingTimeoutMs(*deadline));
+        const Expected<Connected, SocketError> connected = socket.tryConnect(address, timeout);
+        if (!connected) {
+            const Endpoint endpoint = utils::getEndpoint(address);
+            if (connected.error().category() == SocketError::Category::TimedOut) {
+                throw Exception(FUNC_NAME, "Timed out connecting to ", endpoint.ip, ":", endpoint.port);
+            }
+            throw Exception(
+                FUNC_NAME, "Couldn't connect to ", endpoint.ip, ":", endpoint.port, " - ", connected.error());
+        }
+        return Lease(*this, host, std::move(socket), false);
+    } catch (...) {
+        lock.lock();
+        --host.connections;
+        host.released.notify_one();
+        throw;
+    }
+}
+
+UnsignedSize ConnectionPool::evictIdle(const Clock::time_point now) {
+    struct Candidate {
+        Host* host;
+        IdleConnection idle;
+        bool healthy;
+    };
+    std::vector<Candidate> candidates;
+    std::vector<Socket<IPProto::TCP>> evicted;
+    std::unique_lock<std::mutex> lock(mMutex);
+    UnsignedSize total = 0;
+    for (const auto& entry : mHosts) {
+        total += entry.second->idle.size();
+    }
+    // Reserved up front, so no connection is lost if the allocation fails
+    candidates.reserve(total);
+    evicted.reserve(total);
+    for (auto& entry : mHosts) {
+        Host& host = *entry.second;
+        const UnsignedSize connections = host.connections;
+        for (IdleConnection& idle : host.idle) {
+            if (now - idle.since <= mOptions.idleTimeout) {
+                candidates.push_back({ &host, std::move(idle), false });
+            } else {
+                evicted.push_back(std::move(idle.socket));
+                --host.connections;
+            }
+        }
+        host.idle.clear();
+        if (host.connections != connections) {
+            host.released.notify_all();
+        }
+    }
+
+    // Checked without the lock, the connections are neither idle nor leased in the meantime
+    lock.unlock();
+    for (Candidate& candidate : candidates) {
+        candidate.healthy = isHealthy(candidate.idle.socket);
+    }
+    lock.lock();
+
+    // The healthy connections go back ahead of those returned in the meantime, which are more recent
+    Host* host = nullptr;
+    UnsignedSize position = 0;
+    for (Candidate& candidate : candidates) {
+        if (candidate.host != host) {
+            host = candidate.host;
+            position = 0;
+            // Wakes the waiters up for both the connections put back and the slots freed
+            host->released.notify_all();
+        }
+        if (candidate.healthy) {
+            try {
+                host->idle.insert(host->idle.begin() + static_cast<std::ptrdiff_t>(position),
+                                  std::move(candidate.idle));
+                ++position;
+                continue;
+            } catch (const std::bad_alloc&) {
+            }
+        }
+        evicted.push_back(std::move(candidate.idle.socket));
+        --host->connections;
+    }
+    lock.unlock();
+    // The evicted connections are closed once the lock is released
+    return evicted.size();
+}
+
+UnsignedSize ConnectionPool::idleCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    UnsignedSize count = 0;
+    for (const auto& entry : mHosts) {
+        count += entry.second->idle.size();
+    }
+    return count;
+}
+
+UnsignedSize ConnectionPool::size(const Address& address) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto found = mHosts.find(HostKey(address));
+    return found == mHosts.end() ? 0 : found->second->connections;
+}
+
+void ConnectionPool::release(Host& host, Socket<IPProto::TCP> socket, const bool reusable) noexcept {
+    if (!reusable || !socket.isOpen()) {
+        if (socket.isOpen()) {
+            try {
+                socket.close();
+            } catch (const Exception&) {
+            }
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        --host.connections;
+        host.released.notify_one();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    try {
+        host.idle.push_back({ std::move(socket), Clock::now() });
+    } catch (const std::bad_alloc&) {
+        --host.connections; // Closed by the destructor of the socket
+    }
+    host.released.notify_one();
+}
+
+bool ConnectionPool::isHealthy(const Socket<IPProto::TCP>& socket) noexcept {
+    // An idle connection has nothing to read, EOF means the peer closed it and data means the previous
+    // response wasn't read completely
+    Byte byte;
+    const Expected<UnsignedSize, SocketError> peeked = socket.tryPeek(&byte, 1);
+    return !peeked && peeked.error().isWouldBlock();
+}
+
+ConnectionPool::Lease::Lease(ConnectionPool& pool,
+                             Host& host,
+                             Socket<IPProto::TCP> socket,
+                             const bool reused) noexcept
+    : mPool(&pool)
+    , mHost(&host)
+    , mSocket(std::move(socket))
+    , mReused(reused) {}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : mPool(other.mPool)
+    , mHost(other.mHost)
+    , mSocket(std::move(other.mSocket))
+    , mReused(other.mReused) {
+    other.mPool = nullptr;
+}
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    release();
+    mPool = other.mPool;
+    mHost = other.mHost;
+    mSocket = std::move(other.mSocket);
+    mReused = other.mReused;
+    other.mPool = nullptr;
+    return *this;
+}
+
+void ConnectionPool::Lease::release() noexcept {
+    if (mPool) {
+        mPool->release(*mHost, std::move(mSocket), true);
+        mPool = nullptr;
+    }
+}
+
+void ConnectionPool::Lease::discard() noexcept {
+    if (mPool) {
+        mPool->release(*mHost, std::move(mSocket), false);
+        mPool = nullptr;
+    }
+}
+
+} // namespace cpplibsocket
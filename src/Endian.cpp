@@ -0,0 +1,151 @@
+#include "cpplibsocket/common/Endian.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CPPLIBSOCKET_ENDIAN_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+// Compiles the kernel for the given instruction set regardless of the target of the rest of the library,
+// the kernels are only called when the CPU supports it
+#define CPPLIBSOCKET_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CPPLIBSOCKET_TARGET(isa)
+#endif
+
+namespace {
+
+using Kernel = void (*)(const unsigned char*, unsigned char*, std::size_t, std::size_t);
+
+template <typename T>
+void swapScalar(const unsigned char* source, unsigned char* destination, const std::size_t size) noexcept {
+    for (std::size_t i = 0; i < size; i += sizeof(T)) {
+        T value;
+        std::memcpy(&value, source + i, sizeof(T));
+        value = Endian::byteSwap(value);
+        std::memcpy(destination + i, &value, sizeof(T));
+    }
+}
+
+void swapScalar(const unsigned char* source,
+                unsigned char* destination,
+                const std::size_t size,
+                const std::size_t width) noexcept {
+    switch (width) {
+    case 2:
+        swapScalar<std::uint16_t>(source, destination, size);
+        break;
+    case 4:
+        swapScalar<std::uint32_t>(source, destination, size);
+        break;
+    case 8:
+        swapScalar<std::uint64_t>(source, destination, size);
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef CPPLIBSOCKET_ENDIAN_X86
+
+/// Returns the shuffle mask reversing the bytes of each value of the given width within 16 bytes
+CPPLIBSOCKET_TARGET("ssse3") __m128i shuffleMask(const std::size_t width) noexcept {
+    alignas(16) unsigned char mask[16];
+    for (std::size_t i = 0; i < sizeof(mask); ++i) {
+        mask[i] = static_cast<unsigned char>(i / width * width + (width - 1 - i % width));
+    }
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+CPPLIBSOCKET_TARGET("ssse3")
+void swapSsse3(const unsigned char* source,
+               unsigned char* destination,
+               const std::size_t size,
+               const std::size_t width) noexcept {
+    const __m128i mask = shuffleMask(width);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_shuffle_epi8(value, mask));
+    }
+    swapScalar(source + i, destination + i, size - i, width);
+}
+
+CPPLIBSOCKET_TARGET("avx2")
+void swapAvx2(const unsigned char* source,
+              unsigned char* destination,
+              const std::size_t size,
+              const std::size_t width) noexcept {
+    // The shuffle works within the 128-bit lanes, which never split a value
+    const __m256i mask = _mm256_broadcastsi128_si256(shuffleMask(width));
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 32));
+        __m256i* const out = reinterpret_cast<__m256i*>(destination + i);
+        _mm256_storeu_si256(out, _mm256_shuffle_epi8(low, mask));
+        _mm256_storeu_si256(out + 1, _mm256_shuffle_epi8(high, mask));
+    }
+    for (; i + 32 <= size; i += 32) {
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_shuffle_epi8(value, mask));
+    }
+    swapScalar(source + i, destination + i, size - i, width);
+}
+
+#ifdef _MSC_VER
+bool supportsAvx2() noexcept {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+}
+
+bool supportsSsse3() noexcept {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+}
+#else
+bool supportsAvx2() noexcept {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+bool supportsSsse3() noexcept {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+#endif
+
+#endif // CPPLIBSOCKET_ENDIAN_X86
+
+Kernel selectKernel() noexcept {
+#ifdef CPPLIBSOCKET_ENDIAN_X86
+    if (supportsAvx2()) {
+        return swapAvx2;
+    }
+    if (supportsSsse3()) {
+        return swapSsse3;
+    }
+#endif
+    return swapScalar;
+}
+
+} // namespace
+
+void Endian::swapBytes(const void* source,
+                       void* destination,
+                       const std::size_t size,
+                       const std::size_t width) noexcept {
+    static const Kernel kernel = selectKernel();
+    kernel(static_cast<const unsigned char*>(source), static_cast<unsigned char*>(destination), size, width);
+}
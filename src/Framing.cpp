@@ -0,0 +1,176 @@
+#include "cpplibsocket/Framing.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace cpplibsocket {
+
+namespace {
+
+    void validate(const FramingOptions& options) {
+        switch (options.prefixSize) {
+        case 1:
+        case 2:
+        case 4:
+        case 8:
+            break;
+        default:
+            throw Exception(FUNC_NAME, "Invalid prefix size ", options.prefixSize);
+        }
+        if (options.byteOrder == Endian::Type::Unknown) {
+            throw Exception(FUNC_NAME, "The byte order of the prefix has to be known");
+        }
+    }
+
+    /// Returns the largest payload size the prefix can hold, limited by the maximum frame size
+    UnsignedSize maxPayloadSize(const FramingOptions& options) noexcept {
+        if (options.prefixSize >= sizeof(std::uint64_t)) {
+            return options.maxFrameSize;
+        }
+        const std::uint64_t prefixMax = (std::uint64_t(1) << (8 * options.prefixSize)) - 1;
+        return static_cast<UnsignedSize>(std::min<std::uint64_t>(prefixMax, options.maxFrameSize));
+    }
+
+    // Byte by byte, so the prefix needs no alignment, the compilers turn the loops into a load or store and
+    // a byte swap
+
+    std::uint64_t readPrefix(const Byte* data, const FramingOptions& options) noexcept {
+        std::uint64_t value = 0;
+        if (options.byteOrder == Endian::Type::Big) {
+            for (unsigned i = 0; i < options.prefixSize; ++i) {
+                value = (value << 8) | data[i];
+            }
+        } else {
+            for (unsigned i = 0; i < options.prefixSize; ++i) {
+                value |= std::uint64_t(data[i]) << (8 * i);
+            }
+        }
+        return value;
+    }
+
+    void writePrefix(std::uint64_t value, Byte* data, const FramingOptions& options) noexcept {
+        if (options.byteOrder == Endian::Type::Big) {
+            for (unsigned i = options.prefixSize; i-- > 0; value >>= 8) {
+                data[i] = static_cast<Byte>(value);
+            }
+        } else {
+            for (unsigned i = 0; i < options.prefixSize; ++i, value >>= 8) {
+                data[i] = static_cast<Byte>(value);
+            }
+        }
+    }
+
+} // namespace
+
+FrameDecoder::FrameDecoder(const Options& options)
+    : mOptions(options) {
+    validate(mOptions);
+}
+
+DecodedFrame FrameDecoder::decode(const Byte* data, const UnsignedSize size) const noexcept {
+    const UnsignedSize prefixSize = mOptions.prefixSize;
+    if (size < prefixSize) {
+        return { DecodedFrame::Status::Incomplete, { nullptr, 0 }, prefixSize };
+    }
+    const std::uint64_t payloadSize = readPrefix(data, mOptions);
+    if (payloadSize > mOptions.maxFrameSize) {
+        const UnsignedSize declared = static_cast<UnsignedSize>(
+            std::min<std::uint64_t>(payloadSize, std::numeric_limits<UnsignedSize>::max()));
+        return { DecodedFrame::Status::TooLarge, { nullptr, 0 }, declared };
+    }
+    const UnsignedSize frameSize = prefixSize + static_cast<UnsignedSize>(payloadSize);
+    if (size < frameSize) {
+        return { DecodedFrame::Status::Incomplete, { nullptr, 0 }, frameSize };
+    }
+    return { DecodedFrame::Status::Complete,
+             { data + prefixSize, static_cast<UnsignedSize>(payloadSize) },
+             frameSize };
+}
+
+FrameEncoder::FrameEncoder(const Options& options)
+    : mOptions(options) {
+    validate(mOptions);
+}
+
+void FrameEncoder::add(const Byte* payload, const UnsignedSize size) {
+    if (size > maxPayloadSize(mOptions)) {
+        throw Exception(FUNC_NAME, "The payload of size ", size, " exceeds the maximum frame size");
+    }
+    const UnsignedSize offset = mPrefixes.size();
+    mPrefixes.resize(offset + mOptions.prefixSize);
+    writePrefix(size, mPrefixes.data() + offset, mOptions);
+    // The prefixes may have been moved by the resize, they're pointed to when the buffers are needed
+    mBuffers.push_back({ nullptr, mOptions.prefixSize });
+    mBuffers.push_back({ payload, size });
+    mBuffersValid = false;
+}
+
+const std::vector<ConstBuffer>& FrameEncoder::buffers() noexcept {
+    if (!mBuffersValid) {
+        for (UnsignedSize i = 0; i < mBuffers.size(); i += 2) {
+            mBuffers[i].data = mPrefixes.data() + i / 2 * mOptions.prefixSize;
+        }
+        mBuffersValid = true;
+    }
+    return mBuffers;
+}
+
+Expected<UnsignedSize, SocketError> FrameEncoder::flush(const Socket<IPProto::TCP>& socket) noexcept {
+    const std::vector<ConstBuffer>& frames = buffers();
+    const Expected<UnsignedSize, SocketError> sent = socket.sendAllv(frames.data(), frames.size(), mCursor);
+    if (mCursor.buffer == frames.size()) {
+        clear();
+    }
+    return sent;
+}
+
+void FrameEncoder::clear() noexcept {
+    mPrefixes.clear();
+    mBuffers.clear();
+    mCursor = BufferCursor();
+    mBuffersValid = true;
+}
+
+FrameReader::FrameReader(const Options& options, const UnsignedSize capacity)
+    : mDecoder(options)
+    , mBuffer(std::max<UnsignedSize>(capacity, options.prefixSize)) {}
+
+Expected<UnsignedSize, SocketError> FrameReader::receive(const Socket<IPProto::TCP>& socket) {
+    // The size of the frame at the beginning, or of its prefix if it's not received yet
+    const DecodedFrame frame = mDecoder.decode(mBuffer.data() + mBegin, size());
+    const UnsignedSize needed = frame.status == DecodedFrame::Status::Incomplete ? frame.size : 0;
+    if (mBuffer.size() - mBegin < needed || mEnd == mBuffer.size()) {
+        std::copy(mBuffer.begin() + mBegin, mBuffer.begin() + mEnd, mBuffer.begin());
+        mEnd -= mBegin;
+        mBegin = 0;
+        if (mBuffer.size() < needed) {
+            mBuffer.resize(needed);
+        }
+    }
+    if (mEnd == mBuffer.size()) {
+        // Filled with complete frames that weren't consumed by next()
+        return makeUnexpected(SocketError::noBuffers());
+    }
+    const Expected<UnsignedSize, SocketError> received =
+        socket.tryReceive(mBuffer.data() + mEnd, mBuffer.size() - mEnd);
+    if (received) {
+        mEnd += *received;
+    }
+    return received;
+}
+
+DecodedFrame FrameReader::next() noexcept {
+    const DecodedFrame frame = mDecoder.decode(mBuffer.data() + mBegin, size());
+    if (frame.status == DecodedFrame::Status::Complete) {
+        mBegin += frame.size;
+        if (mBegin == mEnd) {
+            // The payload stays intact until the next receive(), which can now start at the beginning
+            mBegin = 0;
+            mEnd = 0;
+        }
+    }
+    return frame;
+}
+
+} // namespace cpplibsocket
@@ -0,0 +1,156 @@
+#include "cpplibsocket/HappyEyeballs.h"
+#include "cpplibsocket/utils/EndpointPrint.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+namespace cpplibsocket {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Attempt {
+        Socket<IPProto::TCP> socket;
+        Address address;
+    };
+
+    std::vector<Address> withPort(std::vector<Address> addresses, const Port port) {
+        for (Address& address : addresses) {
+            utils::setPort(address, port);
+        }
+        return addresses;
+    }
+
+} // namespace
+
+std::vector<Address> interleaveAddressFamilies(const std::vector<Address>& addresses) {
+    if (addresses.empty()) {
+        return {};
+    }
+    const AddressFamily first = addresses.front().sa.sa_family;
+    std::vector<Address> preferred;
+    std::vector<Address> other;
+    for (const Address& address : addresses) {
+        (address.sa.sa_family == first ? preferred : other).push_back(address);
+    }
+    std::vector<Address> ordered;
+    ordered.reserve(addresses.size());
+    for (std::size_t i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+        if (i < preferred.size()) {
+            ordered.push_back(preferred[i]);
+        }
+        if (i < other.size()) {
+            ordered.push_back(other[i]);
+        }
+    }
+    return ordered;
+}
+
+Socket<IPProto::TCP>
+connectFirst(const std::vector<Address>& addresses, const HappyEyeballsOptions& options) {
+    const std::vector<Address> ordered = interleaveAddressFamilies(addresses);
+    if (ordered.empty()) {
+        throw Exception(FUNC_NAME, "No address to connect to");
+    }
+    const Clock::time_point deadline = Clock::now() + options.timeout;
+    std::vector<Attempt> pending;
+    // Sized for all the attempts up front, so waiting for them doesn't allocate on every round
+    std::vector<SocketHandle> handles;
+    handles.reserve(ordered.size());
+    std::unique_ptr<bool[]> ready(new bool[ordered.size()]);
+    std::ostringstream errors;
+    const auto fail = [&errors](const Address& address, const std::string& reason) {
+        errors << (errors.tellp() > 0 ? ", " : "") << utils::getEndpoint(address) << " - " << reason;
+    };
+
+    std::size_t next = 0;
+    Clock::time_point nextAttemptAt = Clock::now();
+    while (true) {
+        const Clock::time_point now = Clock::now();
+        if (now >= deadline) {
+            throw Exception(FUNC_NAME, "Timed out connecting to any of the addresses");
+        }
+        if (next < ordered.size() && (pending.empty() || now >= nextAttemptAt)) {
+            const Address& address = ordered[next++];
+            try {
+                Socket<IPProto::TCP> socket(toIPVer(address.sa.sa_family), options.socketOptions);
+                socket.setBlocked(false);
+                const Expected<Connected, SocketError> connected = socket.tryConnect(address);
+                if (connected) {
+                    socket.setBlocked(true);
+                    return socket;
+                }
+                if (connected.error().category() != SocketError::Category::InProgress) {
+                    fail(address, connected.error().message());
+                    continue;
+                }
+                pending.push_back({ std::move(socket), address });
+                nextAttemptAt = now + options.attemptDelay;
+            } catch (const Exception& e) {
+                fail(address, e.what());
+            }
+            continue;
+        }
+        if (pending.empty()) {
+            throw Exception(FUNC_NAME, "Couldn't connect to any of the addresses: ", errors.str());
+        }
+
+        const Clock::time_point waitUntil =
+            next < ordered.size() ? std::min(nextAttemptAt, deadline) : deadline;
+        handles.clear();
+        for (const Attempt& attempt : pending) {
+            handles.push_back(attempt.socket.getSocketHandle());
+        }
+        const int polled = Platform::waitWritable(
+            handles.data(), ready.get(), pending.size(), utils::remainingTimeoutMs(waitUntil));
+        if (polled < 0) {
+            const SocketError error = SocketError::last();
+            if (error.category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            throw Exception(FUNC_NAME, "Couldn't wait for the connections - ", error.message());
+        }
+        // Backwards, so the indices of the attempts yet to be checked stay valid while erasing
+        for (std::size_t i = pending.size(); i-- > 0;) {
+            if (!ready[i]) {
+                continue;
+            }
+            const Expected<Connected, SocketError> connected = pending[i].socket.connectResult();
+            if (connected) {
+                Socket<IPProto::TCP> socket = std::move(pending[i].socket);
+                socket.setBlocked(true);
+                return socket; // The other attempts are closed along with the pending ones
+            }
+            fail(pending[i].address, connected.error().message());
+            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i));
+            // A failure doesn't have to wait for the attempt delay
+            nextAttemptAt = Clock::now();
+        }
+    }
+}
+
+Socket<IPProto::TCP>
+connectHost(const std::string& hostname, const Port port, const HappyEyeballsOptions& options) {
+    SystemResolverSource source;
+    const ResolveResult resolved = source.lookup(hostname, NullOptional).result;
+    if (!resolved) {
+        throw Exception(FUNC_NAME, "Couldn't resolve ", hostname, " - ", resolved.error().message);
+    }
+    return connectFirst(withPort(*resolved, port), options);
+}
+
+Socket<IPProto::TCP> connectHost(Resolver& resolver,
+                                 const std::string& hostname,
+                                 const Port port,
+                                 const HappyEyeballsOptions& options) {
+    const ResolveResult resolved = resolver.resolve(hostname).get();
+    if (!resolved) {
+        throw Exception(FUNC_NAME, "Couldn't resolve ", hostname, " - ", resolved.error().message);
+    }
+    return connectFirst(withPort(*resolved, port), options);
+}
+
+} // namespace cpplibsocket
@@ -0,0 +1,458 @@
+#include "cpplibsocket/IoRing.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <ctime>
+
+namespace cpplibsocket {
+
+namespace {
+
+    // user_data of operations whose completions are not dispatched (e.g. cancellation requests)
+    constexpr IoRing::OperationId IGNORED_OPERATION = ~IoRing::OperationId(0);
+
+    // An operation identifier holds the slot of the operation in the low half and its generation in the high
+    // half, so the identifier of a completed operation doesn't refer to the next operation in the slot
+    std::uint32_t slotOf(const IoRing::OperationId operation) noexcept {
+        return static_cast<std::uint32_t>(operation);
+    }
+
+    std::uint32_t generationOf(const IoRing::OperationId operation) noexcept {
+        return static_cast<std::uint32_t>(operation >> 32);
+    }
+
+    int ioUringSetup(const unsigned entries, io_uring_params* params) {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int ioUringEnter(const int fd,
+                     const unsigned toSubmit,
+                     const unsigned minComplete,
+                     const unsigned flags,
+                     const void* arg,
+                     const UnsignedSize argSize) {
+        return static_cast<int>(
+            ::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+    }
+
+    int ioUringRegister(const int fd, const unsigned opcode, const void* arg, const unsigned count) {
+        return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    template <typename T>
+    T* offsetPtr(void* base, const std::uint32_t offset) {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+    }
+
+    void* mapRing(const int fd, const UnsignedSize size, const off_t offset) {
+        void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+        if (map == MAP_FAILED) {
+            throw Exception(FUNC_NAME, "Couldn't map io_uring - ", getLastErrorFormatted());
+        }
+        return map;
+    }
+
+} // namespace
+
+IoRing::BufferRing::BufferRing(const int ringFd,
+                               const std::uint16_t groupId,
+                               const std::uint16_t count,
+                               const UnsignedSize bufferSize)
+    : mRingFd(ringFd)
+    , mGroupId(groupId)
+    , mCount(count)
+    , mBufferSize(bufferSize) {
+    if (count == 0 || (count & (count - 1)) != 0) {
+        throw Exception(FUNC_NAME, "The number of buffers has to be a power of two, got ", count);
+    }
+    if (bufferSize == 0 || bufferSize > std::numeric_limits<std::uint32_t>::max()) {
+        throw Exception(FUNC_NAME, "Invalid buffer size ", bufferSize);
+    }
+
+    mRingSize = count * sizeof(io_uring_buf);
+    void* ring = ::mmap(nullptr, mRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        throw Exception(FUNC_NAME, "Couldn't allocate buffer ring - ", getLastErrorFormatted());
+    }
+    mRing = static_cast<io_uring_buf_ring*>(ring);
+
+    const UnsignedSize buffersSize = count * bufferSize;
+    void* buffers = ::mmap(nullptr, buffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffers == MAP_FAILED) {
+        const std::string error = getLastErrorFormatted();
+        ::munmap(mRing, mRingSize);
+        throw Exception(FUNC_NAME, "Couldn't allocate buffers - ", error);
+    }
+    mBuffers = static_cast<Byte*>(buffers);
+
+    io_uring_buf_reg registration = {};
+    registration.ring_addr = reinterpret_cast<std::uint64_t>(mRing);
+    registration.ring_entries = count;
+    registration.bgid = groupId;
+    if (ioUringRegister(mRingFd, IORING_REGISTER_PBUF_RING, &registration, 1) == -1) {
+        const std::string error = getLastErrorFormatted();
+        ::munmap(mBuffers, buffersSize);
+        ::munmap(mRing, mRingSize);
+        throw Exception(FUNC_NAME, "Couldn't register buffer ring ", groupId, " - ", error);
+    }
+
+    for (std::uint16_t id = 0; id < count; ++id) {
+        provide(id);
+    }
+    publish();
+}
+
+IoRing::BufferRing::~BufferRing() noexcept {
+    io_uring_buf_reg registration = {};
+    registration.bgid = mGroupId;
+    ioUringRegister(mRingFd, IORING_UNREGISTER_PBUF_RING, &registration, 1);
+    ::munmap(mBuffers, mCount * mBufferSize);
+    ::munmap(mRing, mRingSize);
+}
+
+void IoRing::BufferRing::recycle(const std::uint16_t bufferId) noexcept {
+    provide(bufferId);
+    publish();
+}
+
+void IoRing::BufferRing::provide(const std::uint16_t bufferId) noexcept {
+    // Not using io_uring_buf_ring::bufs as its flexible array emulation is offset when compiled as C++
+    io_uring_buf& buffer = reinterpret_cast<io_uring_buf*>(mRing)[mTail & (mCount - 1)];
+    buffer.addr = reinterpret_cast<std::uint64_t>(data(bufferId));
+    buffer.len = static_cast<std::uint32_t>(mBufferSize);
+    buffer.bid = bufferId;
+    ++mTail;
+}
+
+void IoRing::BufferRing::publish() noexcept {
+    __atomic_store_n(&mRing->tail, mTail, __ATOMIC_RELEASE);
+}
+
+IoRing::IoRing(const unsigned entries) {
+    io_uring_params params = {};
+    mRingFd = ioUringSetup(entries, &params);
+    if (mRingFd == -1) {
+        throw Exception(FUNC_NAME, "Couldn't set up io_uring - ", getLastErrorFormatted());
+    }
+    mFeatures = params.features;
+
+    try {
+        mSqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        mCqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (mFeatures & IORING_FEAT_SINGLE_MMAP) {
+            mSqMapSize = mCqMapSize = std::max(mSqMapSize, mCqMapSize);
+        }
+        mSqMap = mapRing(mRingFd, mSqMapSize, IORING_OFF_SQ_RING);
+        mCqMap = (mFeatures & IORING_FEAT_SINGLE_MMAP) ? mSqMap
+                                                       : mapRing(mRingFd, mCqMapSize, IORING_OFF_CQ_RING);
+        mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        mSqes = static_cast<io_uring_sqe*>(mapRing(mRingFd, mSqesSize, IORING_OFF_SQES));
+    } catch (...) {
+        unmap();
+        throw;
+    }
+
+    mSqHead = offsetPtr<unsigned>(mSqMap, params.sq_off.head);
+    mSqTail = offsetPtr<unsigned>(mSqMap, params.sq_off.tail);
+    mSqArray = offsetPtr<unsigned>(mSqMap, params.sq_off.array);
+    mSqMask = *offsetPtr<unsigned>(mSqMap, params.sq_off.ring_mask);
+    mSqEntries = params.sq_entries;
+    mSqLocalTail = mSqSubmitted = *mSqTail;
+
+    mCqHead = offsetPtr<unsigned>(mCqMap, params.cq_off.head);
+    mCqTail = offsetPtr<unsigned>(mCqMap, params.cq_off.tail);
+    mCqes = offsetPtr<io_uring_cqe>(mCqMap, params.cq_off.cqes);
+    mCqMask = *offsetPtr<unsigned>(mCqMap, params.cq_off.ring_mask);
+
+    // In-flight operations are bound by the completion queue size so it can never overflow
+    mOperations.resize(params.cq_entries);
+    mFreeOperations.reserve(params.cq_entries);
+    for (std::uint32_t slot = params.cq_entries; slot > 0; --slot) {
+        mFreeOperations.push_back(slot - 1);
+    }
+}
+
+IoRing::~IoRing() noexcept {
+    mBufferRings.clear();
+    unmap();
+}
+
+IoRing::OperationId IoRing::accept(const IoTarget listener, CompletionHandler handler, Address* peer) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_ACCEPT, listener, id);
+    if (peer) {
+        Operation& operation = mOperations[slotOf(id)];
+        operation.addrLen = sizeof(Address);
+        sqe.addr = reinterpret_cast<std::uint64_t>(&peer->sa);
+        sqe.addr2 = reinterpret_cast<std::uint64_t>(&operation.addrLen);
+    }
+    return id;
+}
+
+IoRing::OperationId IoRing::acceptMultishot(const IoTarget listener, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_ACCEPT, listener, id);
+    sqe.ioprio |= IORING_ACCEPT_MULTISHOT;
+    return id;
+}
+
+IoRing::OperationId
+IoRing::connect(const IoTarget socket, const Address& address, CompletionHandler handler) {
+    // Before the operation and the entry are taken, so an invalid address doesn't leave them behind
+    const SockLenType addrLen = getAddrSize(&address.sa);
+    const OperationId id = allocateOperation(std::move(handler));
+    Operation& operation = mOperations[slotOf(id)];
+    operation.address = address;
+    io_uring_sqe& sqe = prepare(IORING_OP_CONNECT, socket, id);
+    sqe.addr = reinterpret_cast<std::uint64_t>(&operation.address.sa);
+    sqe.off = static_cast<std::uint64_t>(addrLen);
+    return id;
+}
+
+IoRing::OperationId
+IoRing::send(const IoTarget socket, const Byte* data, const UnsignedSize size, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_SEND, socket, id);
+    sqe.addr = reinterpret_cast<std::uint64_t>(data);
+    sqe.len =
+        static_cast<std::uint32_t>(std::min<UnsignedSize>(size, std::numeric_limits<std::uint32_t>::max()));
+    return id;
+}
+
+IoRing::OperationId
+IoRing::receive(const IoTarget socket, Byte* data, const UnsignedSize maxSize, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_RECV, socket, id);
+    sqe.addr = reinterpret_cast<std::uint64_t>(data);
+    sqe.len = static_cast<std::uint32_t>(
+        std::min<UnsignedSize>(maxSize, std::numeric_limits<std::uint32_t>::max()));
+    return id;
+}
+
+IoRing::OperationId
+IoRing::receive(const IoTarget socket, const BufferRing& buffers, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_RECV, socket, id);
+    sqe.flags |= IOSQE_BUFFER_SELECT;
+    sqe.buf_group = buffers.groupId();
+    return id;
+}
+
+IoRing::OperationId
+IoRing::receiveMultishot(const IoTarget socket, const BufferRing& buffers, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_RECV, socket, id);
+    sqe.ioprio |= IORING_RECV_MULTISHOT;
+    sqe.flags |= IOSQE_BUFFER_SELECT;
+    sqe.buf_group = buffers.groupId();
+    return id;
+}
+
+IoRing::OperationId
+IoRing::sendMessage(const IoTarget socket, const msghdr& message, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_SENDMSG, socket, id);
+    sqe.addr = reinterpret_cast<std::uint64_t>(&message);
+    sqe.len = 1;
+    return id;
+}
+
+IoRing::OperationId
+IoRing::receiveMessage(const IoTarget socket, msghdr& message, CompletionHandler handler) {
+    const OperationId id = allocateOperation(std::move(handler));
+    io_uring_sqe& sqe = prepare(IORING_OP_RECVMSG, socket, id);
+    sqe.addr = reinterpret_cast<std::uint64_t>(&message);
+    sqe.len = 1;
+    return id;
+}
+
+void IoRing::cancel(const OperationId operation) {
+    if (!findOperation(operation)) {
+        return;
+    }
+    io_uring_sqe& sqe = prepare(IORING_OP_ASYNC_CANCEL, IoTarget(-1), IGNORED_OPERATION);
+    sqe.addr = operation;
+}
+
+void IoRing::registerFiles(const SocketHandle* handles, const unsigned count) {
+    if (mFilesRegistered) {
+        throw Exception(FUNC_NAME, "Files are already registered");
+    }
+    if (ioUringRegister(mRingFd, IORING_REGISTER_FILES, handles, count) == -1) {
+        throw Exception(FUNC_NAME, "Couldn't register files - ", getLastErrorFormatted());
+    }
+    mFilesRegistered = true;
+}
+
+void IoRing::unregisterFiles() {
+    if (!mFilesRegistered) {
+        throw Exception(FUNC_NAME, "No files are registered");
+    }
+    if (ioUringRegister(mRingFd, IORING_UNREGISTER_FILES, nullptr, 0) == -1) {
+        throw Exception(FUNC_NAME, "Couldn't unregister files - ", getLastErrorFormatted());
+    }
+    mFilesRegistered = false;
+}
+
+IoRing::BufferRing&
+IoRing::addBufferRing(const std::uint16_t groupId, const std::uint16_t count, const UnsignedSize bufferSize) {
+    mBufferRings.emplace_back(new BufferRing(mRingFd, groupId, count, bufferSize));
+    return *mBufferRings.back();
+}
+
+unsigned IoRing::submit() {
+    const unsigned toSubmit = mSqLocalTail - mSqSubmitted;
+    if (toSubmit == 0) {
+        return 0;
+    }
+    const int submitted = enter(toSubmit, 0, -1);
+    if (submitted == -1) {
+        throw Exception(FUNC_NAME, "Couldn't submit operations - ", getLastErrorFormatted());
+    }
+    return static_cast<unsigned>(submitted);
+}
+
+void IoRing::unmap() noexcept {
+    if (mSqes) {
+        ::munmap(mSqes, mSqesSize);
+    }
+    if (mCqMap && mCqMap != mSqMap) {
+        ::munmap(mCqMap, mCqMapSize);
+    }
+    if (mSqMap) {
+        ::munmap(mSqMap, mSqMapSize);
+    }
+    ::close(mRingFd);
+}
+
+io_uring_sqe& IoRing::prepare(const std::uint8_t opcode, const IoTarget target, const OperationId operation) {
+    if (mSqLocalTail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) >= mSqEntries) {
+        try {
+            submit();
+        } catch (...) {
+            releaseOperation(operation);
+            throw;
+        }
+        if (mSqLocalTail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) >= mSqEntries) {
+            releaseOperation(operation);
+            throw Exception(FUNC_NAME, "The submission queue is full");
+        }
+    }
+    const unsigned index = mSqLocalTail & mSqMask;
+    io_uring_sqe& sqe = mSqes[index];
+    sqe = {};
+    sqe.opcode = opcode;
+    sqe.fd = target.handle();
+    if (target.isFixed()) {
+        sqe.flags |= IOSQE_FIXED_FILE;
+    }
+    sqe.user_data = operation;
+    mSqArray[index] = index;
+    ++mSqLocalTail; // Published to the kernel by enter() once the entry is filled in
+    return sqe;
+}
+
+IoRing::OperationId IoRing::allocateOperation(CompletionHandler handler) {
+    if (mFreeOperations.empty()) {
+        throw Exception(FUNC_NAME, "Too many operations in flight");
+    }
+    const std::uint32_t slot = mFreeOperations.back();
+    Operation& operation = mOperations[slot];
+    operation.handler = std::move(handler);
+    mFreeOperations.pop_back();
+    return (static_cast<OperationId>(operation.generation) << 32) | slot;
+}
+
+void IoRing::releaseOperation(const OperationId operation) noexcept {
+    if (operation == IGNORED_OPERATION) {
+        return;
+    }
+    const std::uint32_t slot = slotOf(operation);
+    mOperations[slot].handler = nullptr;
+    ++mOperations[slot].generation;
+    mFreeOperations.push_back(slot);
+}
+
+IoRing::Operation* IoRing::findOperation(const OperationId operation) noexcept {
+    const std::uint32_t slot = slotOf(operation);
+    if (slot >= mOperations.size() || mOperations[slot].generation != generationOf(operation)) {
+        return nullptr;
+    }
+    return &mOperations[slot];
+}
+
+int IoRing::enter(const unsigned toSubmit, const unsigned minComplete, const long long timeoutNs) {
+    __atomic_store_n(mSqTail, mSqLocalTail, __ATOMIC_RELEASE);
+    unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int result;
+    if (minComplete > 0 && timeoutNs >= 0) {
+        if (!(mFeatures & IORING_FEAT_EXT_ARG)) {
+            throw Exception(FUNC_NAME, "Waiting with a timeout is not supported by the kernel");
+        }
+        __kernel_timespec ts = {};
+        ts.tv_sec = timeoutNs / 1000000000LL;
+        ts.tv_nsec = timeoutNs % 1000000000LL;
+        io_uring_getevents_arg arg = {};
+        arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+        result = ioUringEnter(
+            mRingFd, toSubmit, minComplete, flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    } else {
+        result = ioUringEnter(mRingFd, toSubmit, minComplete, flags, nullptr, 0);
+    }
+    if (result >= 0) {
+        mSqSubmitted += static_cast<unsigned>(result);
+    }
+    return result;
+}
+
+UnsignedSize IoRing::pollImpl(const long long timeoutNs) {
+    UnsignedSize dispatched = dispatch();
+    if (dispatched > 0) {
+        submit();
+        return dispatched;
+    }
+    if (enter(mSqLocalTail - mSqSubmitted, 1, timeoutNs) == -1 && errno != ETIME && errno != EINTR) {
+        throw Exception(FUNC_NAME, "Couldn't wait for completions - ", getLastErrorFormatted());
+    }
+    return dispatch();
+}
+
+UnsignedSize IoRing::dispatch() {
+    UnsignedSize dispatched = 0;
+    unsigned head = *mCqHead;
+    while (head != __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE)) {
+        const io_uring_cqe cqe = mCqes[head & mCqMask];
+        __atomic_store_n(mCqHead, ++head, __ATOMIC_RELEASE);
+        if (cqe.user_data == IGNORED_OPERATION) {
+            continue;
+        }
+
+        IoCompletion completion;
+        completion.result = cqe.res;
+        completion.more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+            completion.bufferId = static_cast<std::uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        }
+
+        Operation* operation = findOperation(cqe.user_data);
+        if (!operation) {
+            continue;
+        }
+        ++dispatched;
+        if (completion.more) {
+            operation->handler(completion);
+        } else {
+            // The slot may be reused by operations the handler submits
+            CompletionHandler handler = std::move(operation->handler);
+            releaseOperation(cqe.user_data);
+            handler(completion);
+        }
+    }
+    return dispatched;
+}
+
+} // namespace cpplibsocket
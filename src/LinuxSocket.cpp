@@ -5,8 +5,18 @@
 #include <fcntl.h>
 #include <ifaddrs.h>
 #include <limits>
+#include <linux/errqueue.h>
+#include <linux/filter.h>
+#include <memory>
 #include <net/if.h>
 #include <netdb.h>
+#include <netinet/udp.h>
+#include <new>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
 #include <unistd.h>
 
 namespace cpplibsocket {
@@ -15,16 +25,134 @@ std::string getLastErrorFormatted() {
     return std::strerror(errno);
 }
 
+SocketError::SocketError(const int code) noexcept
+    : mCode(code) {
+    switch (code) {
+    case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+        mCategory = Category::WouldBlock;
+        break;
+    case EINTR:
+        mCategory = Category::Interrupted;
+        break;
+    case EINPROGRESS:
+        mCategory = Category::InProgress;
+        break;
+    case ECONNRESET:
+        mCategory = Category::ConnectionReset;
+        break;
+    case ECONNREFUSED:
+        mCategory = Category::ConnectionRefused;
+        break;
+    case ECONNABORTED:
+        mCategory = Category::ConnectionAborted;
+        break;
+    case EPIPE:
+        mCategory = Category::BrokenPipe;
+        break;
+    case ETIMEDOUT:
+        mCategory = Category::TimedOut;
+        break;
+    case ENOTCONN:
+        mCategory = Category::NotConnected;
+        break;
+    case EBADF:
+        mCategory = Category::NotOpen;
+        break;
+    default:
+        mCategory = Category::Other;
+        break;
+    }
+}
+
+SocketError SocketError::last() noexcept {
+    return SocketError(errno);
+}
+
+SocketError SocketError::notOpen() noexcept {
+    return SocketError(EBADF);
+}
+
+SocketError SocketError::noBuffers() noexcept {
+    return SocketError(ENOBUFS);
+}
+
+SocketError SocketError::timedOut() noexcept {
+    return SocketError(ETIMEDOUT);
+}
+
+SocketError SocketError::unsupportedFamily() noexcept {
+    return SocketError(EAFNOSUPPORT);
+}
+
+SocketError SocketError::invalidArgument() noexcept {
+    return SocketError(EINVAL);
+}
+
+std::string SocketError::message() const {
+    return std::strerror(mCode);
+}
+
+namespace {
+
+    /// Calls the function with SIGPIPE blocked, consuming the signal if the call raised it
+    ///
+    /// Unlike send(), sendfile() and splice() have no MSG_NOSIGNAL.
+    template <typename TFunction>
+    SignedSize withoutSigPipe(TFunction function) {
+        sigset_t pipe;
+        sigemptyset(&pipe);
+        sigaddset(&pipe, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        const bool wasPending = sigismember(&pending, SIGPIPE) == 1;
+        sigset_t previous;
+        pthread_sigmask(SIG_BLOCK, &pipe, &previous);
+
+        const SignedSize result = function();
+
+        const int error = errno;
+        if (result == -1 && error == EPIPE && !wasPending) {
+            const timespec noWait = {};
+            while (sigtimedwait(&pipe, nullptr, &noWait) == -1 && errno == EINTR) {
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+        errno = error;
+        return result;
+    }
+
+    /// Sends the segments as separate datagrams, where UDP GSO isn't available
+    SignedSize sendSegments(SocketHandle socket,
+                            const Byte* data,
+                            const UnsignedSize size,
+                            const UnsignedSize segmentSize,
+                            const sockaddr* addr) {
+        UnsignedSize sent = 0;
+        while (sent < size) {
+            const UnsignedSize segment = std::min(segmentSize, size - sent);
+            if (Platform::sendTo(socket, data + sent, segment, addr) == -1) {
+                return sent == 0 ? -1 : static_cast<SignedSize>(sent);
+            }
+            sent += segment;
+        }
+        return static_cast<SignedSize>(sent);
+    }
+
+} // namespace
+
 namespace Platform {
 
     SignedSize send(SocketHandle socket, const Byte* data, const UnsignedSize size) {
         const std::size_t viableSize = std::min(std::numeric_limits<size_t>::max(), size);
-        return ::send(socket, data, viableSize, 0);
+        return ::send(socket, data, viableSize, MSG_NOSIGNAL);
     }
 
     SignedSize sendTo(SocketHandle socket, const Byte* data, const UnsignedSize size, const sockaddr* addr) {
         const std::size_t viableSize = std::min(std::numeric_limits<size_t>::max(), size);
-        const SockLenType sockSize = getAddrSize(toIPVer(addr->sa_family));
+        const SockLenType sockSize = getAddrSize(addr);
         return ::sendto(socket, data, viableSize, 0, addr, sockSize);
     }
 
@@ -39,6 +167,142 @@ namespace Platform {
         return ::recvfrom(socket, data, viableSize, 0, addr, &sockSize);
     }
 
+    SignedSize sendToSegmented(SocketHandle socket,
+                               const Byte* data,
+                               const UnsignedSize size,
+                               const UnsignedSize segmentSize,
+                               const sockaddr* addr) {
+#ifdef UDP_SEGMENT
+        iovec buffer = { const_cast<Byte*>(data), size };
+        msghdr message = {};
+        message.msg_iov = &buffer;
+        message.msg_iovlen = 1;
+        message.msg_name = const_cast<sockaddr*>(addr);
+        message.msg_namelen = getAddrSize(addr);
+        // A single datagram doesn't need to be segmented, which saves the checks of the GSO path
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(std::uint16_t))] = {};
+        if (size > segmentSize) {
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            cmsghdr* header = CMSG_FIRSTHDR(&message);
+            header->cmsg_level = IPPROTO_UDP;
+            header->cmsg_type = UDP_SEGMENT;
+            header->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+            const std::uint16_t gsoSize = static_cast<std::uint16_t>(segmentSize);
+            std::memcpy(CMSG_DATA(header), &gsoSize, sizeof(gsoSize));
+        }
+        const SignedSize sent = ::sendmsg(socket, &message, 0);
+        // A kernel without GSO rejects the segment size (EINVAL), a device without checksum offload rejects
+        // the send (EIO), the segments are sent one by one then
+        if (sent != -1 || size <= segmentSize || (errno != EINVAL && errno != EIO)) {
+            return sent;
+        }
+#endif
+        return sendSegments(socket, data, size, segmentSize, addr);
+    }
+
+    SignedSize receiveFromCoalesced(
+        SocketHandle socket, Byte* data, const UnsignedSize size, sockaddr* addr, UnsignedSize* segmentSize) {
+        iovec buffer = { data, size };
+        msghdr message = {};
+        message.msg_iov = &buffer;
+        message.msg_iovlen = 1;
+        message.msg_name = addr;
+        message.msg_namelen = sizeof(Address);
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        const SignedSize received = ::recvmsg(socket, &message, 0);
+        if (received == -1) {
+            return -1;
+        }
+        // The datagrams are never coalesced without the offload
+        *segmentSize = static_cast<UnsignedSize>(received);
+#ifdef UDP_GRO
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level == IPPROTO_UDP && header->cmsg_type == UDP_GRO) {
+                int gsoSize = 0;
+                std::memcpy(&gsoSize, CMSG_DATA(header), sizeof(gsoSize));
+                *segmentSize = static_cast<UnsignedSize>(gsoSize);
+            }
+        }
+#endif
+        return received;
+    }
+
+    SignedSize peek(SocketHandle socket, Byte* data, const UnsignedSize size) {
+        return ::recv(socket, data, size, MSG_PEEK | MSG_DONTWAIT);
+    }
+
+    SignedSize sendv(SocketHandle socket, const ConstBuffer* buffers, const UnsignedSize count) {
+        const UnsignedSize bufferCount = std::min(count, MAX_BUFFER_COUNT);
+        iovec iov[MAX_BUFFER_COUNT];
+        for (UnsignedSize i = 0; i < bufferCount; ++i) {
+            iov[i].iov_base = const_cast<Byte*>(buffers[i].data);
+            iov[i].iov_len = buffers[i].size;
+        }
+        msghdr message = {};
+        message.msg_iov = iov;
+        message.msg_iovlen = bufferCount;
+        return ::sendmsg(socket, &message, MSG_NOSIGNAL);
+    }
+
+    SignedSize receivev(SocketHandle socket, const MutableBuffer* buffers, const UnsignedSize count) {
+        const UnsignedSize bufferCount = std::min(count, MAX_BUFFER_COUNT);
+        iovec iov[MAX_BUFFER_COUNT];
+        for (UnsignedSize i = 0; i < bufferCount; ++i) {
+            iov[i].iov_base = buffers[i].data;
+            iov[i].iov_len = buffers[i].size;
+        }
+        msghdr message = {};
+        message.msg_iov = iov;
+        message.msg_iovlen = bufferCount;
+        return ::recvmsg(socket, &message, 0);
+    }
+
+    SignedSize sendBatch(SocketHandle socket, OutgoingDatagram* datagrams, const UnsignedSize count) {
+        const UnsignedSize batchSize = std::min(count, MAX_BATCH_SIZE);
+        mmsghdr messages[MAX_BATCH_SIZE] = {};
+        iovec buffers[MAX_BATCH_SIZE];
+        for (UnsignedSize i = 0; i < batchSize; ++i) {
+            buffers[i].iov_base = const_cast<Byte*>(datagrams[i].data);
+            buffers[i].iov_len = datagrams[i].size;
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            // No address on a connected socket, the datagram goes to its peer
+            if (datagrams[i].address) {
+                messages[i].msg_hdr.msg_name = const_cast<sockaddr*>(&datagrams[i].address->sa);
+                messages[i].msg_hdr.msg_namelen = getAddrSize(&datagrams[i].address->sa);
+            }
+        }
+        const int sent = ::sendmmsg(socket, messages, static_cast<unsigned>(batchSize), 0);
+        for (int i = 0; i < sent; ++i) {
+            datagrams[i].sent = messages[i].msg_len;
+        }
+        return sent;
+    }
+
+    SignedSize receiveBatch(SocketHandle socket, IncomingDatagram* datagrams, const UnsignedSize count) {
+        const UnsignedSize batchSize = std::min(count, MAX_BATCH_SIZE);
+        mmsghdr messages[MAX_BATCH_SIZE] = {};
+        iovec buffers[MAX_BATCH_SIZE];
+        for (UnsignedSize i = 0; i < batchSize; ++i) {
+            buffers[i].iov_base = datagrams[i].data;
+            buffers[i].iov_len = datagrams[i].maxSize;
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = &datagrams[i].source.sa;
+            messages[i].msg_hdr.msg_namelen = sizeof(Address);
+        }
+        // Blocks only until the first datagram arrives, the rest is received only if already queued
+        const int received =
+            ::recvmmsg(socket, messages, static_cast<unsigned>(batchSize), MSG_WAITFORONE, nullptr);
+        for (int i = 0; i < received; ++i) {
+            datagrams[i].size = messages[i].msg_len;
+        }
+        return received;
+    }
+
     bool setBlocked(SocketHandle socket, const bool blocked) {
         int flags = fcntl(socket, F_GETFL, 0);
         if (flags == -1) {
@@ -52,12 +316,175 @@ namespace Platform {
         return true;
     }
 
+    bool setZeroCopy(SocketHandle socket, const bool enabled) {
+        const int value = enabled ? 1 : 0;
+        return setsockopt(socket, SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) != -1;
+    }
+
+    bool setOption(SocketHandle socket, const int level, const int name, const int value) {
+        return setsockopt(socket, level, name, &value, sizeof(value)) != -1;
+    }
+
+    bool getOption(SocketHandle socket, const int level, const int name, int* value) {
+        SockLenType size = sizeof(*value);
+        return getsockopt(socket, level, name, value, &size) != -1;
+    }
+
+    bool shutdown(SocketHandle socket, const bool send, const bool receive) {
+        const int how = send && receive ? SHUT_RDWR : send ? SHUT_WR : SHUT_RD;
+        return ::shutdown(socket, how) == 0;
+    }
+
+    bool setReusePort(SocketHandle socket, const bool enabled) {
+        const int value = enabled ? 1 : 0;
+        return setsockopt(socket, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) != -1;
+    }
+
+    bool attachReusePortCpuSteering(SocketHandle socket, const unsigned groupSize) {
+        // A = current CPU; A %= groupSize; return A
+        sock_filter code[] = {
+            { BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+            { BPF_ALU | BPF_MOD | BPF_K, 0, 0, groupSize },
+            { BPF_RET | BPF_A, 0, 0, 0 },
+        };
+        sock_fprog program = {};
+        program.len = sizeof(code) / sizeof(code[0]);
+        program.filter = code;
+        return setsockopt(socket, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) != -1;
+    }
+
+    SignedSize
+    sendZeroCopy(SocketHandle socket, const Byte* data, const UnsignedSize size, const sockaddr* addr) {
+        const SockLenType sockSize = addr ? getAddrSize(addr) : 0;
+        return ::sendto(socket, data, size, MSG_ZEROCOPY | MSG_NOSIGNAL, addr, sockSize);
+    }
+
+    SignedSize readZeroCopyCompletion(SocketHandle socket, ZeroCopyCompletion* completion) {
+        for (;;) {
+            alignas(cmsghdr) char control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+            msghdr message = {};
+            message.msg_control = control;
+            message.msg_controllen = sizeof(control);
+            if (::recvmsg(socket, &message, MSG_ERRQUEUE) == -1) {
+                return -1;
+            }
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+                const bool isRecvErr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                                       (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+                if (!isRecvErr) {
+                    continue;
+                }
+                sock_extended_err error;
+                std::memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+                if (error.ee_origin != SO_EE_ORIGIN_ZEROCOPY || error.ee_errno != 0) {
+                    continue; // Other errors (e.g. ICMP) queued for the socket are not of our interest
+                }
+                completion->first = error.ee_info;
+                completion->last = error.ee_data;
+                completion->copied = (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+                return 1;
+            }
+        }
+    }
+
     SocketHandle openSocket(const IPProto ipProtocol, const IPVer ipVersion) {
-        return ::socket(toNativeDomain(ipVersion), toNativeType(ipProtocol), toNativeProtocol(ipProtocol));
+        const AddressFamily domain = isUnixProtocol(ipProtocol) ? AF_UNIX : toNativeDomain(ipVersion);
+        return ::socket(domain, toNativeType(ipProtocol), toNativeProtocol(ipProtocol));
+    }
+
+    bool socketPair(const IPProto ipProtocol, SocketHandle* sockets) {
+        return ::socketpair(AF_UNIX, toNativeType(ipProtocol), 0, sockets) == 0;
+    }
+
+    bool connect(SocketHandle socket, const sockaddr* addr, const SockLenType addrSize) {
+        return ::connect(socket, addr, addrSize) == 0;
+    }
+
+    int
+    waitWritable(const SocketHandle* sockets, bool* ready, const UnsignedSize count, const int timeoutMs) {
+        // A connection races just a few sockets, so the descriptors are allocated only past the stack array
+        constexpr UnsignedSize MAX_POLL_STACK_COUNT = 16;
+        pollfd local[MAX_POLL_STACK_COUNT];
+        std::unique_ptr<pollfd[]> allocated;
+        pollfd* descriptors = local;
+        if (count > MAX_POLL_STACK_COUNT) {
+            allocated.reset(new (std::nothrow) pollfd[count]);
+            if (!allocated) {
+                errno = ENOMEM;
+                return -1;
+            }
+            descriptors = allocated.get();
+        }
+        for (UnsignedSize i = 0; i < count; ++i) {
+            descriptors[i].fd = sockets[i];
+            descriptors[i].events = POLLOUT;
+            descriptors[i].revents = 0;
+        }
+        const int polled = ::poll(descriptors, static_cast<nfds_t>(count), timeoutMs);
+        for (UnsignedSize i = 0; i < count; ++i) {
+            ready[i] = polled > 0 && descriptors[i].revents != 0;
+        }
+        return polled;
+    }
+
+    SocketHandle accept(SocketHandle socket, Address* peer, const bool nonBlocking, const bool closeOnExec) {
+        SockLenType addrLen = sizeof(Address);
+        const int flags = (nonBlocking ? SOCK_NONBLOCK : 0) | (closeOnExec ? SOCK_CLOEXEC : 0);
+        return ::accept4(socket, peer ? &peer->sa : nullptr, peer ? &addrLen : nullptr, flags);
     }
 
     bool closeSocket(SocketHandle socket) { return ::close(socket) == 0; }
 
+    FileHandle openFile(const std::string& path) { return ::open(path.c_str(), O_RDONLY | O_CLOEXEC); }
+
+    bool closeFile(FileHandle file) { return ::close(file) == 0; }
+
+    SignedSize
+    sendFile(SocketHandle socket, FileHandle file, const std::uint64_t offset, const UnsignedSize size) {
+        // Linux transfers at most 0x7ffff000 bytes per call
+        const std::size_t viableSize = std::min<UnsignedSize>(size, 0x7ffff000);
+        off_t fileOffset = static_cast<off_t>(offset);
+        return withoutSigPipe(
+            [=, &fileOffset]() { return ::sendfile(socket, file, &fileOffset, viableSize); });
+    }
+
+    SignedSize spliceToPipe(const int from, const int pipe, const UnsignedSize size) {
+        const std::size_t viableSize = std::min<UnsignedSize>(size, 0x7ffff000);
+        return ::splice(from, nullptr, pipe, nullptr, viableSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    }
+
+    SignedSize spliceFromPipe(const int pipe, const SocketHandle socket, const UnsignedSize size) {
+        const std::size_t viableSize = std::min<UnsignedSize>(size, 0x7ffff000);
+        // Only the socket can raise SIGPIPE, once the peer shuts its receiving side down
+        return withoutSigPipe([=]() {
+            return ::splice(pipe, nullptr, socket, nullptr, viableSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        });
+    }
+
+    void* mapMemory(const UnsignedSize size, const bool hugePages, bool* mappedHugePages) {
+        *mappedHugePages = false;
+        const int protection = PROT_READ | PROT_WRITE;
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if (hugePages) {
+            void* memory = ::mmap(nullptr, size, protection, flags | MAP_HUGETLB, -1, 0);
+            if (memory != MAP_FAILED) {
+                *mappedHugePages = true;
+                return memory;
+            }
+        }
+        void* memory = ::mmap(nullptr, size, protection, flags, -1, 0);
+        if (memory == MAP_FAILED) {
+            return nullptr;
+        }
+        if (hugePages) {
+            // No huge pages reserved, transparent huge pages are the next best thing
+            ::madvise(memory, size, MADV_HUGEPAGE);
+        }
+        return memory;
+    }
+
+    bool unmapMemory(void* memory, const UnsignedSize size) { return ::munmap(memory, size) == 0; }
+
 } // namespace Platform
 
 } // namespace cpplibsocket
@@ -0,0 +1,209 @@
+#include "cpplibsocket/Reactor.h"
+#include "cpplibsocket/utils/Defer.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace cpplibsocket {
+
+static std::uint32_t toEpollEvents(const Reactor::Events interest, const TriggerMode mode) {
+    std::uint32_t events = EPOLLRDHUP;
+    if (interest.isSet(IOEvent::Readable)) {
+        events |= EPOLLIN;
+    }
+    if (interest.isSet(IOEvent::Writable)) {
+        events |= EPOLLOUT;
+    }
+    if (mode == TriggerMode::Edge) {
+        events |= EPOLLET;
+    }
+    return events;
+}
+
+static Reactor::Events fromEpollEvents(const std::uint32_t events) {
+    Reactor::Events result;
+    if (events & EPOLLIN) {
+        result |= IOEvent::Readable;
+    }
+    if (events & EPOLLOUT) {
+        result |= IOEvent::Writable;
+    }
+    if (events & EPOLLERR) {
+        result |= IOEvent::Error;
+    }
+    if (events & (EPOLLHUP | EPOLLRDHUP)) {
+        result |= IOEvent::HangUp;
+    }
+    return result;
+}
+
+Reactor::Reactor(const UnsignedSize maxEvents)
+    : mMaxEvents(std::max<UnsignedSize>(maxEvents, 1))
+    , mEvents(new epoll_event[mMaxEvents]) {
+    mEpollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (mEpollFd == -1) {
+        throw Exception(FUNC_NAME, "Couldn't create epoll instance - ", getLastErrorFormatted());
+    }
+    mWakeupFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mWakeupFd == -1) {
+        const std::string error = getLastErrorFormatted();
+        ::close(mEpollFd);
+        throw Exception(FUNC_NAME, "Couldn't create wakeup event - ", error);
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr; // Registrations are never null, so this marks the wakeup event
+    if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeupFd, &event) == -1) {
+        const std::string error = getLastErrorFormatted();
+        ::close(mWakeupFd);
+        ::close(mEpollFd);
+        throw Exception(FUNC_NAME, "Couldn't register wakeup event - ", error);
+    }
+}
+
+Reactor::~Reactor() noexcept {
+    // Owned sockets have to be closed before the epoll instance so they don't outlive it
+    mRegistrations.clear();
+    mRetired.clear();
+    ::close(mWakeupFd);
+    ::close(mEpollFd);
+}
+
+void Reactor::watch(const SocketHandle handle,
+                    const Events interest,
+                    Handler handler,
+                    const TriggerMode mode) {
+    registerHandle(handle, interest, std::move(handler), mode);
+}
+
+void Reactor::modify(const SocketHandle handle, const Events interest) {
+    const auto it = mRegistrations.find(handle);
+    if (it == mRegistrations.end()) {
+        throw Exception(FUNC_NAME, "Socket handle ", handle, " is not registered");
+    }
+    epoll_event event = {};
+    event.events = toEpollEvents(interest, it->second->mode);
+    event.data.ptr = it->second.get();
+    if (::epoll_ctl(mEpollFd, EPOLL_CTL_MOD, handle, &event) == -1) {
+        throw Exception(FUNC_NAME, "Couldn't modify socket handle ", handle, " - ", getLastErrorFormatted());
+    }
+}
+
+void Reactor::remove(const SocketHandle handle) {
+    std::unique_ptr<Registration> registration = unregisterHandle(handle);
+    if (mDispatching) {
+        // Events for this registration may still be pending in the current batch
+        mRetired.push_back(std::move(registration));
+    }
+}
+
+std::unique_ptr<SocketBase> Reactor::release(const SocketHandle handle) {
+    std::unique_ptr<Registration> registration = unregisterHandle(handle);
+    std::unique_ptr<SocketBase> socket = std::move(registration->socket);
+    if (mDispatching) {
+        mRetired.push_back(std::move(registration));
+    }
+    return socket;
+}
+
+bool Reactor::contains(const SocketHandle handle) const noexcept {
+    return mRegistrations.find(handle) != mRegistrations.end();
+}
+
+void Reactor::run() {
+    while (!mStopRequested) {
+        poll();
+    }
+    mStopRequested = false;
+}
+
+void Reactor::run(TimerWheel& timers) {
+    while (!mStopRequested) {
+        poll(timers.timeUntilNext());
+        timers.advance();
+    }
+    mStopRequested = false;
+}
+
+void Reactor::stop() noexcept {
+    mStopRequested = true;
+    const std::uint64_t value = 1;
+    const ssize_t written = ::write(mWakeupFd, &value, sizeof(value));
+    (void)written; // The counter can only overflow if stop() was called ~2^64 times without polling
+}
+
+Reactor::Registration& Reactor::registerHandle(const SocketHandle handle,
+                                               const Events interest,
+                                               Handler handler,
+                                               const TriggerMode mode) {
+    if (handle == Platform::SOCKET_NULL) {
+        throw Exception(FUNC_NAME, "Invalid socket handle");
+    }
+    if (contains(handle)) {
+        throw Exception(FUNC_NAME, "Socket handle ", handle, " is already registered");
+    }
+    std::unique_ptr<Registration> registration(new Registration());
+    registration->handle = handle;
+    registration->handler = std::move(handler);
+    registration->mode = mode;
+
+    epoll_event event = {};
+    event.events = toEpollEvents(interest, mode);
+    event.data.ptr = registration.get();
+    if (::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, handle, &event) == -1) {
+        throw Exception(
+            FUNC_NAME, "Couldn't register socket handle ", handle, " - ", getLastErrorFormatted());
+    }
+    Registration& result = *registration;
+    mRegistrations.emplace(handle, std::move(registration));
+    return result;
+}
+
+std::unique_ptr<Reactor::Registration> Reactor::unregisterHandle(const SocketHandle handle) {
+    const auto it = mRegistrations.find(handle);
+    if (it == mRegistrations.end()) {
+        throw Exception(FUNC_NAME, "Socket handle ", handle, " is not registered");
+    }
+    std::unique_ptr<Registration> registration = std::move(it->second);
+    mRegistrations.erase(it);
+    registration->active = false;
+    // Fails only if the watched socket has already been closed, in which case epoll has dropped it anyway
+    ::epoll_ctl(mEpollFd, EPOLL_CTL_DEL, handle, nullptr);
+    return registration;
+}
+
+UnsignedSize Reactor::pollImpl(const int timeoutMs) {
+    const int count = ::epoll_wait(mEpollFd, mEvents.get(), static_cast<int>(mMaxEvents), timeoutMs);
+    if (count == -1) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        throw Exception(FUNC_NAME, "Couldn't wait for events - ", getLastErrorFormatted());
+    }
+
+    mDispatching = true;
+    auto retire = utils::makeDeferred([this]() noexcept {
+        mDispatching = false;
+        mRetired.clear();
+    });
+
+    UnsignedSize dispatched = 0;
+    for (int i = 0; i < count; ++i) {
+        Registration* registration = static_cast<Registration*>(mEvents[i].data.ptr);
+        if (!registration) {
+            std::uint64_t value;
+            const ssize_t drained = ::read(mWakeupFd, &value, sizeof(value));
+            (void)drained;
+            continue;
+        }
+        if (!registration->active) {
+            continue; // Removed by one of the handlers dispatched before
+        }
+        registration->handler(fromEpollEvents(mEvents[i].events));
+        ++dispatched;
+    }
+    return dispatched;
+}
+
+} // namespace cpplibsocket
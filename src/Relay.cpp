@@ -0,0 +1,128 @@
+#include "cpplibsocket/Relay.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace cpplibsocket {
+
+Relay::Relay(Socket<IPProto::TCP>& first, Socket<IPProto::TCP>& second, const Options& options) {
+    if (!first.isOpen() || !second.isOpen()) {
+        throw Exception(FUNC_NAME, "The socket is not open");
+    }
+    first.setBlocked(false);
+    second.setBlocked(false);
+    mToSecond.from = mToFirst.to = first.getSocketHandle();
+    mToSecond.to = mToFirst.from = second.getSocketHandle();
+    openPipe(mToSecond, options.pipeCapacity);
+    try {
+        openPipe(mToFirst, options.pipeCapacity);
+    } catch (...) {
+        closePipe(mToSecond);
+        throw;
+    }
+}
+
+Relay::~Relay() noexcept {
+    closePipe(mToSecond);
+    closePipe(mToFirst);
+}
+
+Expected<UnsignedSize, SocketError> Relay::pump() noexcept {
+    const Expected<UnsignedSize, SocketError> toSecond = pump(mToSecond);
+    if (!toSecond) {
+        return toSecond;
+    }
+    const Expected<UnsignedSize, SocketError> toFirst = pump(mToFirst);
+    if (!toFirst) {
+        return toFirst;
+    }
+    return *toSecond + *toFirst;
+}
+
+void Relay::openPipe(Flow& flow, const UnsignedSize capacity) {
+    if (::pipe2(flow.pipe, O_NONBLOCK | O_CLOEXEC) == -1) {
+        throw Exception(FUNC_NAME, "Couldn't create the pipe - ", getLastErrorFormatted());
+    }
+    // Best effort, unprivileged processes are limited by /proc/sys/fs/pipe-max-size
+    ::fcntl(flow.pipe[1], F_SETPIPE_SZ, static_cast<int>(std::min<UnsignedSize>(capacity, 1U << 30)));
+    const int actual = ::fcntl(flow.pipe[1], F_GETPIPE_SZ);
+    if (actual == -1) {
+        const std::string error = getLastErrorFormatted();
+        closePipe(flow);
+        throw Exception(FUNC_NAME, "Couldn't get the pipe capacity - ", error);
+    }
+    flow.capacity = static_cast<UnsignedSize>(actual);
+}
+
+void Relay::closePipe(Flow& flow) noexcept {
+    for (int& fd : flow.pipe) {
+        if (fd != -1) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+Expected<UnsignedSize, SocketError> Relay::pump(Flow& flow) noexcept {
+    const UnsignedSize start = flow.forwarded;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        if (flow.receiving()) {
+            const SignedSize received =
+                Platform::spliceToPipe(flow.from, flow.pipe[1], flow.capacity - flow.buffered);
+            if (received > 0) {
+                flow.buffered += static_cast<UnsignedSize>(received);
+                progress = true;
+            } else if (received == 0) {
+                flow.ended = true;
+            } else {
+                const SocketError error = SocketError::last();
+                if (error.category() == SocketError::Category::Interrupted) {
+                    progress = true;
+                } else if (!error.isWouldBlock()) {
+                    return makeUnexpected(error);
+                }
+                // Either there's no data to receive or the pipe is full, which can only be told apart once
+                // the pipe is drained a bit
+                flow.stalled = error.isWouldBlock() && flow.buffered > 0;
+            }
+        }
+        if (flow.buffered > 0) {
+            const SignedSize sent = Platform::spliceFromPipe(flow.pipe[0], flow.to, flow.buffered);
+            if (sent > 0) {
+                flow.buffered -= static_cast<UnsignedSize>(sent);
+                flow.forwarded += static_cast<UnsignedSize>(sent);
+                flow.stalled = false;
+                progress = true;
+            } else if (sent == -1) {
+                const SocketError error = SocketError::last();
+                if (error.category() == SocketError::Category::Interrupted) {
+                    progress = true;
+                } else if (!error.isWouldBlock()) {
+                    return makeUnexpected(error);
+                }
+            }
+        }
+    }
+    if (flow.finished() && !flow.shutDown) {
+        if (!Platform::shutdown(flow.to, true, false)) {
+            return makeUnexpected(SocketError::last());
+        }
+        flow.shutDown = true;
+    }
+    return flow.forwarded - start;
+}
+
+Reactor::Events Relay::interest(const Flow& outgoing, const Flow& incoming) noexcept {
+    Reactor::Events events;
+    if (outgoing.receiving()) {
+        events |= IOEvent::Readable;
+    }
+    if (incoming.buffered > 0) {
+        events |= IOEvent::Writable;
+    }
+    return events;
+}
+
+} // namespace cpplibsocket
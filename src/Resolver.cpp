@@ -0,0 +1,299 @@
+#include "cpplibsocket/Resolver.h"
+#include "cpplibsocket/utils/AddressParser.h"
+#include "cpplibsocket/utils/Defer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+namespace cpplibsocket {
+
+namespace {
+
+    std::string toLower(std::string str) {
+        std::transform(str.begin(), str.end(), str.begin(), [](const unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        return str;
+    }
+
+    ResolveError::Status toStatus(const int gaiError) noexcept {
+        switch (gaiError) {
+        case EAI_NONAME:
+#if defined(EAI_NODATA) && EAI_NODATA != EAI_NONAME
+        case EAI_NODATA:
+#endif
+#ifdef EAI_ADDRFAMILY
+        case EAI_ADDRFAMILY:
+#endif
+            return ResolveError::Status::NotFound;
+        case EAI_AGAIN:
+            return ResolveError::Status::TemporaryFailure;
+        default:
+            return ResolveError::Status::Failure;
+        }
+    }
+
+    bool isSameAddress(const Address& lhs, const Address& rhs) noexcept {
+        if (lhs.sa_stor.ss_family != rhs.sa_stor.ss_family) {
+            return false;
+        }
+        return lhs.sa_stor.ss_family == AF_INET
+                   ? std::memcmp(&lhs.sa_in.sin_addr, &rhs.sa_in.sin_addr, sizeof(lhs.sa_in.sin_addr)) == 0
+                   : std::memcmp(&lhs.sa_in6, &rhs.sa_in6, sizeof(lhs.sa_in6)) == 0;
+    }
+
+    /// Calls the callback, swallowing whatever it throws so it can't take down a worker thread
+    void notify(const Resolver::Callback& callback, const ResolveResult& result) noexcept {
+        try {
+            callback(result);
+        } catch (...) {
+        }
+    }
+
+} // namespace
+
+ResolverSource::Answer SystemResolverSource::lookup(const std::string& hostname,
+                                                    const Optional<IPVer> ipVersion) {
+    struct addrinfo hint = {};
+    hint.ai_family = ipVersion ? toNativeDomain(*ipVersion) : AF_UNSPEC;
+    hint.ai_socktype = SOCK_STREAM; // One entry per address rather than per address and socket type
+    struct addrinfo* info = nullptr;
+    const int status = ::getaddrinfo(hostname.c_str(), nullptr, &hint, &info);
+    if (status != 0) {
+        return { makeUnexpected(ResolveError{ toStatus(status), gai_strerror(status) }), NullOptional };
+    }
+    auto freeInfo = utils::makeDeferred([info]() noexcept { ::freeaddrinfo(info); });
+
+    std::vector<Address> addresses;
+    for (struct addrinfo* it = info; it != nullptr; it = it->ai_next) {
+        if ((it->ai_family != AF_INET && it->ai_family != AF_INET6) || it->ai_addrlen > sizeof(Address)) {
+            continue;
+        }
+        Address addr = {};
+        std::memcpy(&addr.sa, it->ai_addr, it->ai_addrlen);
+        if (std::none_of(addresses.begin(), addresses.end(), [&addr](const Address& known) {
+                return isSameAddress(known, addr);
+            })) {
+            addresses.push_back(addr);
+        }
+    }
+    if (addresses.empty()) {
+        return { makeUnexpected(ResolveError{ ResolveError::Status::NotFound, "No usable address" }),
+                 NullOptional };
+    }
+    return { std::move(addresses), NullOptional };
+}
+
+HostsResolverSource::HostsResolverSource(std::istream& hosts) {
+    std::string line;
+    while (std::getline(hosts, line)) {
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string ip;
+        if (!(fields >> ip)) {
+            continue;
+        }
+        utils::IpBytes bytes;
+        if (!utils::parseIp(IPVer::IPV4, ip.data(), ip.size(), bytes) &&
+            !utils::parseIp(IPVer::IPV6, ip.data(), ip.size(), bytes)) {
+            continue;
+        }
+        const Address addr = utils::StaticAddress(bytes, 0);
+        std::string name;
+        while (fields >> name) {
+            std::vector<Address>& addresses = mHosts[toLower(name)];
+            if (std::none_of(addresses.begin(), addresses.end(), [&addr](const Address& known) {
+                    return isSameAddress(known, addr);
+                })) {
+                addresses.push_back(addr);
+            }
+        }
+    }
+}
+
+std::unique_ptr<HostsResolverSource> HostsResolverSource::fromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw Exception(FUNC_NAME, "Couldn't open hosts file \"", path, "\"");
+    }
+    return std::unique_ptr<HostsResolverSource>(new HostsResolverSource(file));
+}
+
+ResolverSource::Answer HostsResolverSource::lookup(const std::string& hostname,
+                                                   const Optional<IPVer> ipVersion) {
+    const auto it = mHosts.find(toLower(hostname));
+    std::vector<Address> addresses;
+    if (it != mHosts.end()) {
+        for (const Address& addr : it->second) {
+            if (!ipVersion || addr.sa_stor.ss_family == toNativeDomain(*ipVersion)) {
+                addresses.push_back(addr);
+            }
+        }
+    }
+    if (addresses.empty()) {
+        return { makeUnexpected(ResolveError{ ResolveError::Status::NotFound, "Name not found in hosts" }),
+                 NullOptional };
+    }
+    return { std::move(addresses), NullOptional };
+}
+
+Resolver::Resolver()
+    : Resolver(nullptr) {}
+
+Resolver::Resolver(std::unique_ptr<ResolverSource> source, const Options& options)
+    : mSource(source ? std::move(source) : std::unique_ptr<ResolverSource>(new SystemResolverSource))
+    , mOptions(options) {
+    const unsigned workers = std::max(mOptions.workers, 1U);
+    mWorkers.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        mWorkers.emplace_back(&Resolver::work, this);
+    }
+}
+
+Resolver::~Resolver() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mQueued.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+
+    const ResolveResult cancelled =
+        makeUnexpected(ResolveError{ ResolveError::Status::Cancelled, "The resolver was destroyed" });
+    for (const std::string& key : mQueue) {
+        for (const Callback& callback : mQueries[key].callbacks) {
+            notify(callback, cancelled);
+        }
+    }
+}
+
+void Resolver::resolve(const std::string& hostname, Callback callback, const Optional<IPVer> ipVersion) {
+    ASSERT(callback);
+    const std::string key = makeKey(hostname, ipVersion);
+    std::unique_lock<std::mutex> lock(mMutex);
+    const auto cachedIt = mCache.find(key);
+    if (cachedIt != mCache.end()) {
+        if (cachedIt->second.expiry > Clock::now()) {
+            const ResolveResult result = cachedIt->second.result;
+            lock.unlock();
+            callback(result);
+            return;
+        }
+        mCache.erase(cachedIt);
+    }
+
+    const auto queryIt = mQueries.find(key);
+    if (queryIt != mQueries.end()) {
+        queryIt->second.callbacks.push_back(std::move(callback));
+        return;
+    }
+    Query& query = mQueries[key];
+    query.hostname = hostname;
+    query.ipVersion = ipVersion;
+    query.callbacks.push_back(std::move(callback));
+    mQueue.push_back(key);
+    lock.unlock();
+    mQueued.notify_one();
+}
+
+std::future<ResolveResult> Resolver::resolve(const std::string& hostname, const Optional<IPVer> ipVersion) {
+    auto promise = std::make_shared<std::promise<ResolveResult>>();
+    std::future<ResolveResult> future = promise->get_future();
+    resolve(hostname, [promise](const ResolveResult& result) { promise->set_value(result); }, ipVersion);
+    return future;
+}
+
+Optional<ResolveResult> Resolver::cached(const std::string& hostname, const Optional<IPVer> ipVersion) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mCache.find(makeKey(hostname, ipVersion));
+    if (it == mCache.end() || it->second.expiry <= Clock::now()) {
+        return NullOptional;
+    }
+    return it->second.result;
+}
+
+void Resolver::clearCache() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCache.clear();
+}
+
+std::string Resolver::makeKey(const std::string& hostname, const Optional<IPVer> ipVersion) {
+    const char family = !ipVersion ? '*' : (*ipVersion == IPVer::IPV4 ? '4' : '6');
+    return family + toLower(hostname);
+}
+
+void Resolver::work() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mQueued.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+        if (mStopping) {
+            return;
+        }
+        const std::string key = std::move(mQueue.front());
+        mQueue.pop_front();
+        const Query& query = mQueries[key];
+        const std::string hostname = query.hostname;
+        const Optional<IPVer> ipVersion = query.ipVersion;
+        lock.unlock();
+
+        const ResolverSource::Answer answer = lookup(hostname, ipVersion);
+
+        lock.lock();
+        store(key, answer);
+        const auto it = mQueries.find(key);
+        const std::vector<Callback> callbacks = std::move(it->second.callbacks);
+        mQueries.erase(it);
+        lock.unlock();
+        for (const Callback& callback : callbacks) {
+            notify(callback, answer.result);
+        }
+        lock.lock();
+    }
+}
+
+ResolverSource::Answer
+Resolver::lookup(const std::string& hostname, const Optional<IPVer> ipVersion) noexcept {
+    try {
+        return mSource->lookup(hostname, ipVersion);
+    } catch (const std::exception& e) {
+        return { makeUnexpected(ResolveError{ ResolveError::Status::Failure, e.what() }), NullOptional };
+    } catch (...) {
+        return { makeUnexpected(ResolveError{ ResolveError::Status::Failure, "Unknown error" }),
+                 NullOptional };
+    }
+}
+
+void Resolver::store(const std::string& key, const ResolverSource::Answer& answer) {
+    std::chrono::seconds ttl(0);
+    if (answer.result) {
+        ttl = answer.ttl ? *answer.ttl : mOptions.defaultTtl;
+    } else if (answer.result.error().status == ResolveError::Status::NotFound) {
+        ttl = mOptions.negativeTtl;
+    }
+    if (ttl <= std::chrono::seconds(0) || mOptions.maxEntries == 0) {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (mCache.size() >= mOptions.maxEntries && mCache.find(key) == mCache.end()) {
+        for (auto it = mCache.begin(); it != mCache.end();) {
+            it = it->second.expiry <= now ? mCache.erase(it) : std::next(it);
+        }
+        if (mCache.size() >= mOptions.maxEntries) {
+            mCache.erase(std::min_element(mCache.begin(), mCache.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.second.expiry < rhs.second.expiry;
+            }));
+        }
+    }
+    mCache.erase(key);
+    mCache.emplace(key, CacheEntry{ answer.result, now + ttl });
+}
+
+} // namespace cpplibsocket
@@ -0,0 +1,77 @@
+#include "cpplibsocket/RingBuffer.h"
+#include "cpplibsocket/utils/Defer.h"
+
+#include <linux/memfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <utility>
+
+namespace cpplibsocket {
+
+namespace {
+
+    int memfdCreate(const char* name, const unsigned flags) {
+        return static_cast<int>(::syscall(__NR_memfd_create, name, flags));
+    }
+
+} // namespace
+
+RingBuffer::RingBuffer(const UnsignedSize capacity) {
+    const UnsignedSize pageSize = static_cast<UnsignedSize>(::sysconf(_SC_PAGESIZE));
+    if (capacity == 0) {
+        throw Exception(FUNC_NAME, "The capacity has to be non-zero");
+    }
+    mCapacity = (capacity + pageSize - 1) / pageSize * pageSize;
+
+    const int fd = memfdCreate("cpplibsocket-ring", MFD_CLOEXEC);
+    if (fd == -1) {
+        throw Exception(FUNC_NAME, "Couldn't create the memory file - ", getLastErrorFormatted());
+    }
+    // The mappings keep the memory alive
+    auto closeFd = utils::makeDeferred([fd]() noexcept { ::close(fd); });
+    if (::ftruncate(fd, static_cast<off_t>(mCapacity)) == -1) {
+        throw Exception(FUNC_NAME, "Couldn't resize the memory file - ", getLastErrorFormatted());
+    }
+
+    // Reserves the address range of both the mappings at once, so nothing else can be mapped in between
+    void* range = ::mmap(nullptr, 2 * mCapacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (range == MAP_FAILED) {
+        throw Exception(FUNC_NAME, "Couldn't reserve the address range - ", getLastErrorFormatted());
+    }
+    mData = static_cast<Byte*>(range);
+    for (Byte* half : { mData, mData + mCapacity }) {
+        if (::mmap(half, mCapacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            const std::string error = getLastErrorFormatted();
+            ::munmap(mData, 2 * mCapacity);
+            throw Exception(FUNC_NAME, "Couldn't map the memory file - ", error);
+        }
+    }
+}
+
+RingBuffer::~RingBuffer() noexcept {
+    if (mData) {
+        ::munmap(mData, 2 * mCapacity);
+    }
+}
+
+RingBuffer::RingBuffer(RingBuffer&& other) noexcept
+    : mData(other.mData)
+    , mCapacity(other.mCapacity)
+    , mRead(other.mRead)
+    , mSize(other.mSize) {
+    other.mData = nullptr;
+    other.mCapacity = 0;
+    other.clear();
+}
+
+RingBuffer& RingBuffer::operator=(RingBuffer&& other) noexcept {
+    std::swap(mData, other.mData);
+    std::swap(mCapacity, other.mCapacity);
+    std::swap(mRead, other.mRead);
+    std::swap(mSize, other.mSize);
+    return *this;
+}
+
+} // namespace cpplibsocket
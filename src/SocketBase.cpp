@@ -14,7 +14,10 @@ SocketBase::~SocketBase() noexcept {
 
 SocketBase& SocketBase::operator=(SocketBase&& other) noexcept {
     mSocketHandle = other.mSocketHandle;
+    mIpProtocol = other.mIpProtocol;
     mIpVersion = other.mIpVersion;
+    mZeroCopyEnabled = other.mZeroCopyEnabled;
+    mZeroCopyNextId = other.mZeroCopyNextId;
     other.mSocketHandle =
         Platform::SOCKET_NULL; // So the destructor of the moved object doesn't close our socket
     return *this;
@@ -79,6 +82,82 @@ void SocketBase::setBlocked(const bool blocked) {
     }
 }
 
+void SocketBase::shutdown(const utils::Flags<Direction> direction) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (!Platform::shutdown(mSocketHandle, direction.isSet(Direction::TX), direction.isSet(Direction::RX))) {
+        throw Exception(FUNC_NAME, "Couldn't shut down the socket - ", getLastErrorFormatted());
+    }
+}
+
+void SocketBase::setReusePort(const bool enabled) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (!Platform::setReusePort(mSocketHandle, enabled)) {
+        throw Exception(FUNC_NAME, "Couldn't set reuse port socket property - ", getLastErrorFormatted());
+    }
+}
+
+void SocketBase::setZeroCopy(const bool enabled) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (!Platform::setZeroCopy(mSocketHandle, enabled)) {
+        throw Exception(FUNC_NAME, "Couldn't set zero-copy socket property - ", getLastErrorFormatted());
+    }
+    mZeroCopyEnabled = enabled;
+}
+
+Expected<ZeroCopyCompletion, WouldBlock> SocketBase::readZeroCopyCompletion() {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    ZeroCopyCompletion completion;
+    if (Platform::readZeroCopyCompletion(mSocketHandle, &completion) == -1) {
+        if (errno == EWOULDBLOCK) {
+            return makeUnexpected(WouldBlock{});
+        }
+        throw Exception(FUNC_NAME, "Couldn't read zero-copy completion - ", getLastErrorFormatted());
+    }
+    return completion;
+}
+
+void SocketBase::setOption(const SocketOptionValue& option) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (!isUnixProtocol(mIpProtocol) && !(mIpVersion == IPVer::IPV4 ? option.ipv4 : option.ipv6)) {
+        throw Exception(
+            FUNC_NAME, "Option ", option.optionName, " doesn't apply to the IP version of the socket");
+    }
+    if (!Platform::setOption(mSocketHandle, option.level, option.name, option.value)) {
+        throw Exception(FUNC_NAME, "Couldn't set option ", option.optionName, " - ", getLastErrorFormatted());
+    }
+}
+
+void SocketBase::setOptions(const std::vector<SocketOptionValue>& options) {
+    for (const SocketOptionValue& option : options) {
+        setOption(option);
+    }
+}
+
+int SocketBase::getOption(const SocketOptionValue& option) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (!isUnixProtocol(mIpProtocol) && !(mIpVersion == IPVer::IPV4 ? option.ipv4 : option.ipv6)) {
+        throw Exception(
+            FUNC_NAME, "Option ", option.optionName, " doesn't apply to the IP version of the socket");
+    }
+    int value = 0;
+    if (!Platform::getOption(mSocketHandle, option.level, option.name, &value)) {
+        throw Exception(FUNC_NAME, "Couldn't get option ", option.optionName, " - ", getLastErrorFormatted());
+    }
+    return value;
+}
+
 Endpoint SocketBase::getEndpoint() const {
     return utils::getEndpoint(mSocketHandle);
 }
@@ -100,4 +179,29 @@ Address SocketBase::createAddr(const std::string& hostIp, const Port port) const
     return utils::createAddr(mIpVersion, hostIp, port);
 }
 
+Expected<ZeroCopySend, WouldBlock>
+SocketBase::sendZeroCopy(const Byte* data, const UnsignedSize size, const Address* address) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (!mZeroCopyEnabled) {
+        throw Exception(FUNC_NAME, "Zero-copy sends are not enabled");
+    }
+    const SignedSize sent =
+        Platform::sendZeroCopy(mSocketHandle, data, size, address ? &address->sa : nullptr);
+    if (sent == -1) {
+        if (errno == EWOULDBLOCK) {
+            return makeUnexpected(WouldBlock{});
+        }
+        throw Exception(FUNC_NAME, "Couldn't send data - ", getLastErrorFormatted());
+    }
+    ASSERT(sent >= 0);
+    // The kernel numbers the zero-copy sends the same way, it skips sends of stream sockets which didn't
+    // send anything
+    if (sent > 0 || mIpProtocol != IPProto::TCP) {
+        return ZeroCopySend{ mZeroCopyNextId++, static_cast<UnsignedSize>(sent) };
+    }
+    return ZeroCopySend{ mZeroCopyNextId, 0 };
+}
+
 } // namespace cpplibsocket
@@ -1,19 +1,70 @@
 #include "cpplibsocket/SocketTcp.h"
+#include "cpplibsocket/utils/Defer.h"
 #include "cpplibsocket/utils/EndpointPrint.h"
 #include "cpplibsocket/utils/utils.h"
 
+#include <algorithm>
 #include <sstream>
 
+#ifdef __linux__
+#include "cpplibsocket/RingBuffer.h"
+#endif
+
 namespace cpplibsocket {
 
+namespace {
+
+    /// Copies the descriptors of the buffers remaining from the cursor, skipping the part already transferred
+    template <typename TBuffer>
+    UnsignedSize remainingBuffers(const TBuffer* buffers,
+                                  const UnsignedSize count,
+                                  const BufferCursor& cursor,
+                                  TBuffer* out) noexcept {
+        const UnsignedSize remaining = std::min(count - cursor.buffer, Platform::MAX_BUFFER_COUNT);
+        std::copy(buffers + cursor.buffer, buffers + cursor.buffer + remaining, out);
+        out[0].data += cursor.offset;
+        out[0].size -= cursor.offset;
+        return remaining;
+    }
+
+    /// Moves the cursor past the transferred data and past any empty buffers
+    template <typename TBuffer>
+    void advance(const TBuffer* buffers,
+                 const UnsignedSize count,
+                 BufferCursor& cursor,
+                 UnsignedSize size) noexcept {
+        while (cursor.buffer < count) {
+            const UnsignedSize left = buffers[cursor.buffer].size - cursor.offset;
+            if (size < left) {
+                cursor.offset += size;
+                return;
+            }
+            size -= left;
+            ++cursor.buffer;
+            cursor.offset = 0;
+        }
+    }
+
+} // namespace
+
 Socket<IPProto::TCP>::Socket(const IPVer ipVersion)
     : SocketBase(IPProto::TCP, ipVersion) {}
 
+Socket<IPProto::TCP>::Socket(const IPVer ipVersion, const SocketOptions<IPProto::TCP>& options)
+    : SocketBase(IPProto::TCP, ipVersion) {
+    setOptions(options);
+}
+
+Socket<IPProto::TCP> Socket<IPProto::TCP>::adopt(const IPVer ipVersion,
+                                                 const SocketHandle socketHandle) noexcept {
+    return Socket<IPProto::TCP>(ipVersion, socketHandle);
+}
+
 void Socket<IPProto::TCP>::connect(const Address& address) {
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "The socket is not open");
     }
-    if (::connect(mSocketHandle, &address.sa, getAddrSize(mIpVersion)) == -1) {
+    if (!Platform::connect(mSocketHandle, &address.sa, getAddrSize(mIpVersion))) {
         std::ostringstream ss;
         ss << "Couldn't connect to " << utils::getEndpoint(address) << " - " << getLastErrorFormatted();
         throw Exception(FUNC_NAME, ss.str());
@@ -24,6 +75,75 @@ void Socket<IPProto::TCP>::connect(const std::string& hostIp, const Port hostPor
     connect(createAddr(hostIp, hostPort));
 }
 
+Expected<Connected, SocketError> Socket<IPProto::TCP>::tryConnect(const Address& address) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    if (!Platform::connect(mSocketHandle, &address.sa, getAddrSize(mIpVersion))) {
+        return makeUnexpected(SocketError::last());
+    }
+    return Connected{};
+}
+
+void Socket<IPProto::TCP>::connect(const Address& address, const std::chrono::milliseconds timeout) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "The socket is not open");
+    }
+    const Expected<Connected, SocketError> connected = tryConnect(address, timeout);
+    if (!connected) {
+        std::ostringstream ss;
+        ss << "Couldn't connect to " << utils::getEndpoint(address) << " - " << connected.error();
+        throw Exception(FUNC_NAME, ss.str());
+    }
+}
+
+Expected<Connected, SocketError>
+Socket<IPProto::TCP>::tryConnect(const Address& address,
+                                 const std::chrono::milliseconds timeout) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    if (!Platform::setBlocked(mSocketHandle, false)) {
+        return makeUnexpected(SocketError::last());
+    }
+    auto restoreBlocking =
+        utils::makeDeferred([this]() noexcept { Platform::setBlocked(mSocketHandle, true); });
+    const Expected<Connected, SocketError> initiated = tryConnect(address);
+    if (initiated || initiated.error().category() != SocketError::Category::InProgress) {
+        return initiated;
+    }
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        bool ready = false;
+        const int polled =
+            Platform::waitWritable(&mSocketHandle, &ready, 1, utils::remainingTimeoutMs(deadline));
+        if (polled > 0) {
+            return connectResult();
+        }
+        if (polled == 0) {
+            return makeUnexpected(SocketError::timedOut());
+        }
+        const SocketError error = SocketError::last();
+        if (error.category() != SocketError::Category::Interrupted) {
+            return makeUnexpected(error);
+        }
+    }
+}
+
+Expected<Connected, SocketError> Socket<IPProto::TCP>::connectResult() const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    int error = 0;
+    if (!Platform::getOption(mSocketHandle, SOL_SOCKET, SO_ERROR, &error)) {
+        return makeUnexpected(SocketError::last());
+    }
+    if (error != 0) {
+        return makeUnexpected(SocketError(error));
+    }
+    return Connected{};
+}
+
 void Socket<IPProto::TCP>::listen(const int backlogSize) {
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "The socket is not open");
@@ -37,51 +157,378 @@ Expected<Socket<IPProto::TCP>, WouldBlock> Socket<IPProto::TCP>::accept() const
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "The socket is not open");
     }
-    sockaddr_in6 addr6 = {};
-    SockLenType addrLen = sizeof(sockaddr_in6);
-    const SocketHandle clientFileDescriptor =
-        ::accept(mSocketHandle, reinterpret_cast<sockaddr*>(&addr6), &addrLen);
-    if (clientFileDescriptor == -1) {
-        if (errno == EWOULDBLOCK) {
-            return makeUnexpected(WouldBlock{});
-        }
-        throw Exception(FUNC_NAME, "Couldn't accept client - ", getLastErrorFormatted());
+    Expected<Socket<IPProto::TCP>, SocketError> client = tryAccept();
+    if (client) {
+        return std::move(*client);
+    }
+    if (client.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't accept client - ", client.error());
+}
+
+Expected<Socket<IPProto::TCP>, SocketError> Socket<IPProto::TCP>::tryAccept() const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SocketHandle clientFileDescriptor = Platform::accept(mSocketHandle, nullptr);
+    if (clientFileDescriptor == Platform::SOCKET_NULL) {
+        return makeUnexpected(SocketError::last());
     }
     return Socket<IPProto::TCP>(mIpVersion, clientFileDescriptor);
 }
 
-Expected<UnsignedSize, WouldBlock> Socket<IPProto::TCP>::send(const Byte* data,
-                                                              const UnsignedSize size) const {
+std::vector<AcceptedSocket> Socket<IPProto::TCP>::acceptMany(const UnsignedSize maxCount,
+                                                             const utils::Flags<AcceptFlag> flags) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "The socket is not open");
+    }
+    std::vector<AcceptedSocket> accepted;
+    while (accepted.size() < maxCount) {
+        Address peer = {};
+        const SocketHandle client = Platform::accept(mSocketHandle,
+                                                     &peer,
+                                                     flags.isSet(AcceptFlag::NonBlocking),
+                                                     flags.isSet(AcceptFlag::CloseOnExec));
+        if (client == Platform::SOCKET_NULL) {
+            const SocketError error = SocketError::last();
+            if (error.isWouldBlock()) {
+                break;
+            }
+            if (error.category() == SocketError::Category::ConnectionAborted ||
+                error.category() == SocketError::Category::Interrupted) {
+                continue; // The connection was reset while queued
+            }
+            if (!accepted.empty()) {
+                break;
+            }
+            throw Exception(FUNC_NAME, "Couldn't accept client - ", error);
+        }
+        accepted.push_back({ Socket<IPProto::TCP>(mIpVersion, client), peer });
+    }
+    return accepted;
+}
+
+Expected<UnsignedSize, WouldBlock>
+Socket<IPProto::TCP>::send(const Byte* data, const UnsignedSize size) const {
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "Socket is not open");
     }
+    const Expected<UnsignedSize, SocketError> sent = trySend(data, size);
+    if (sent) {
+        return *sent;
+    }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::trySend(const Byte* data, const UnsignedSize size) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
     const SignedSize sent = Platform::send(mSocketHandle, data, size);
     if (sent == -1) {
-        if (errno == EWOULDBLOCK) {
-            return makeUnexpected(WouldBlock{});
-        }
-        throw Exception(FUNC_NAME, "Couldn't send data - ", getLastErrorFormatted());
+        return makeUnexpected(SocketError::last());
     }
     ASSERT(sent >= 0);
     return static_cast<UnsignedSize>(sent);
 }
 
-Expected<UnsignedSize, WouldBlock> Socket<IPProto::TCP>::receive(Byte* data,
-                                                                 const UnsignedSize maxSize) const {
+Expected<UnsignedSize, WouldBlock>
+Socket<IPProto::TCP>::receive(Byte* data, const UnsignedSize maxSize) const {
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "Couldn't receive data");
     }
+    const Expected<UnsignedSize, SocketError> received = tryReceive(data, maxSize);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::tryReceive(Byte* data, const UnsignedSize maxSize) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
     const SignedSize received = Platform::receive(mSocketHandle, data, maxSize);
     if (received == -1) {
-        if (errno == EWOULDBLOCK) {
-            return makeUnexpected(WouldBlock{});
-        }
-        throw Exception(FUNC_NAME, "Couldn't receive data - ", getLastErrorFormatted());
+        return makeUnexpected(SocketError::last());
     }
     ASSERT(received >= 0);
     return static_cast<UnsignedSize>(received);
 }
 
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::tryPeek(Byte* data, const UnsignedSize maxSize) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize peeked = Platform::peek(mSocketHandle, data, maxSize);
+    if (peeked == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(peeked >= 0);
+    return static_cast<UnsignedSize>(peeked);
+}
+
+Expected<PooledBuffer, WouldBlock>
+Socket<IPProto::TCP>::receive(BufferPool& pool, const UnsignedSize maxSize) const {
+    PooledBuffer buffer = pool.acquire(maxSize);
+    const Expected<UnsignedSize, WouldBlock> received = receive(buffer.data(), maxSize);
+    if (!received) {
+        return makeUnexpected(WouldBlock{});
+    }
+    buffer.resize(*received);
+    return buffer;
+}
+
+Expected<PooledBuffer, SocketError>
+Socket<IPProto::TCP>::tryReceive(BufferPool& pool, const UnsignedSize maxSize) const noexcept {
+    PooledBuffer buffer = pool.tryAcquire(maxSize);
+    if (!buffer) {
+        return makeUnexpected(SocketError::noBuffers());
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceive(buffer.data(), maxSize);
+    if (!received) {
+        return makeUnexpected(received.error());
+    }
+    buffer.resize(*received);
+    return buffer;
+}
+
+Expected<ZeroCopySend, WouldBlock> Socket<IPProto::TCP>::sendZeroCopy(const Byte* data,
+                                                                     const UnsignedSize size) {
+    return SocketBase::sendZeroCopy(data, size, nullptr);
+}
+
+Expected<UnsignedSize, WouldBlock>
+Socket<IPProto::TCP>::sendv(const ConstBuffer* buffers, const UnsignedSize count) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    const Expected<UnsignedSize, SocketError> sent = trySendv(buffers, count);
+    if (sent) {
+        return *sent;
+    }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::trySendv(const ConstBuffer* buffers, const UnsignedSize count) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize sent = Platform::sendv(mSocketHandle, buffers, count);
+    if (sent == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(sent >= 0);
+    return static_cast<UnsignedSize>(sent);
+}
+
+Expected<UnsignedSize, WouldBlock>
+Socket<IPProto::TCP>::receivev(const MutableBuffer* buffers, const UnsignedSize count) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't receive data");
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceivev(buffers, count);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::tryReceivev(const MutableBuffer* buffers, const UnsignedSize count) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize received = Platform::receivev(mSocketHandle, buffers, count);
+    if (received == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(received >= 0);
+    return static_cast<UnsignedSize>(received);
+}
+
+#ifdef __linux__
+Expected<UnsignedSize, WouldBlock> Socket<IPProto::TCP>::receiveInto(RingBuffer& ring) const {
+    if (ring.full()) {
+        throw Exception(FUNC_NAME, "Couldn't receive data - the ring buffer is full");
+    }
+    const Expected<UnsignedSize, WouldBlock> received = receive(ring.space(), ring.available());
+    if (received) {
+        ring.commit(*received);
+    }
+    return received;
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::TCP>::tryReceiveInto(RingBuffer& ring) const noexcept {
+    if (ring.full()) {
+        return makeUnexpected(SocketError::noBuffers());
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceive(ring.space(), ring.available());
+    if (received) {
+        ring.commit(*received);
+    }
+    return received;
+}
+
+Expected<UnsignedSize, WouldBlock> Socket<IPProto::TCP>::sendFrom(RingBuffer& ring) const {
+    const Expected<UnsignedSize, WouldBlock> sent = send(ring.data(), ring.size());
+    if (sent) {
+        ring.consume(*sent);
+    }
+    return sent;
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::TCP>::trySendFrom(RingBuffer& ring) const noexcept {
+    const Expected<UnsignedSize, SocketError> sent = trySend(ring.data(), ring.size());
+    if (sent) {
+        ring.consume(*sent);
+    }
+    return sent;
+}
+#endif
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::sendAll(const Byte* data, const UnsignedSize size, UnsignedSize& sent) const noexcept {
+    ASSERT(sent <= size);
+    const UnsignedSize start = sent;
+    while (sent < size) {
+        const Expected<UnsignedSize, SocketError> result = trySend(data + sent, size - sent);
+        if (!result) {
+            if (result.error().category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(result.error());
+        }
+        sent += *result;
+    }
+    return sent - start;
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::TCP>::sendFile(const FileHandle file,
+                                                               const std::uint64_t offset,
+                                                               const UnsignedSize size,
+                                                               UnsignedSize& sent) const noexcept {
+    ASSERT(sent <= size);
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const UnsignedSize start = sent;
+    while (sent < size) {
+        const SignedSize result = Platform::sendFile(mSocketHandle, file, offset + sent, size - sent);
+        if (result == -1) {
+            const SocketError error = SocketError::last();
+            if (error.category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(error);
+        }
+        if (result == 0) {
+            break;
+        }
+        sent += static_cast<UnsignedSize>(result);
+    }
+    return sent - start;
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::TCP>::sendFile(const std::string& path,
+                                                               const std::uint64_t offset,
+                                                               const UnsignedSize size,
+                                                               UnsignedSize& sent) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const FileHandle file = Platform::openFile(path);
+    if (file == Platform::FILE_NULL) {
+        return makeUnexpected(SocketError::last());
+    }
+    auto closeFile = utils::makeDeferred([file]() noexcept { Platform::closeFile(file); });
+    return sendFile(file, offset, size, sent);
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::TCP>::receiveExact(Byte* data,
+                                   const UnsignedSize size,
+                                   UnsignedSize& received) const noexcept {
+    ASSERT(received <= size);
+    const UnsignedSize start = received;
+    while (received < size) {
+        const Expected<UnsignedSize, SocketError> result = tryReceive(data + received, size - received);
+        if (!result) {
+            if (result.error().category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(result.error());
+        }
+        if (*result == 0) {
+            break; // The peer closed the connection
+        }
+        received += *result;
+    }
+    return received - start;
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::TCP>::sendAllv(const ConstBuffer* buffers,
+                                                                   const UnsignedSize count,
+                                                                   BufferCursor& cursor) const noexcept {
+    UnsignedSize total = 0;
+    advance(buffers, count, cursor, 0);
+    while (cursor.buffer < count) {
+        ConstBuffer remaining[Platform::MAX_BUFFER_COUNT];
+        const UnsignedSize remainingCount = remainingBuffers(buffers, count, cursor, remaining);
+        const Expected<UnsignedSize, SocketError> result = trySendv(remaining, remainingCount);
+        if (!result) {
+            if (result.error().category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(result.error());
+        }
+        advance(buffers, count, cursor, *result);
+        total += *result;
+    }
+    return total;
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::TCP>::receiveExactv(const MutableBuffer* buffers,
+                                                                        const UnsignedSize count,
+                                                                        BufferCursor& cursor) const noexcept {
+    UnsignedSize total = 0;
+    advance(buffers, count, cursor, 0);
+    while (cursor.buffer < count) {
+        MutableBuffer remaining[Platform::MAX_BUFFER_COUNT];
+        const UnsignedSize remainingCount = remainingBuffers(buffers, count, cursor, remaining);
+        const Expected<UnsignedSize, SocketError> result = tryReceivev(remaining, remainingCount);
+        if (!result) {
+            if (result.error().category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(result.error());
+        }
+        if (*result == 0) {
+            break; // The peer closed the connection
+        }
+        advance(buffers, count, cursor, *result);
+        total += *result;
+    }
+    return total;
+}
+
 Socket<IPProto::TCP>::Socket(const IPVer ipVersion, const SocketHandle clientSocketHandle) noexcept
     : SocketBase(IPProto::TCP, ipVersion, clientSocketHandle) {}
 
@@ -1,22 +1,52 @@
 #include "cpplibsocket/SocketUdp.h"
 #include "cpplibsocket/utils/utils.h"
 
+#include <limits>
+
 namespace cpplibsocket {
 
+namespace {
+
+    bool isIPAddress(const Address* address) noexcept {
+        return address->sa.sa_family == AF_INET || address->sa.sa_family == AF_INET6;
+    }
+
+} // namespace
+
 Socket<IPProto::UDP>::Socket(const IPVer ipVersion)
     : SocketBase(IPProto::UDP, ipVersion) {}
 
+Socket<IPProto::UDP>::Socket(const IPVer ipVersion, const SocketOptions<IPProto::UDP>& options)
+    : SocketBase(IPProto::UDP, ipVersion) {
+    setOptions(options);
+}
+
 Expected<UnsignedSize, WouldBlock>
 Socket<IPProto::UDP>::sendTo(const Byte* data, const UnsignedSize size, const Address& address) {
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "Couldn't send data");
     }
+    const Expected<UnsignedSize, SocketError> sent = trySendTo(data, size, address);
+    if (sent) {
+        return *sent;
+    }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::UDP>::trySendTo(const Byte* data, const UnsignedSize size, const Address& address) noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    if (!isIPAddress(&address)) {
+        return makeUnexpected(SocketError::unsupportedFamily());
+    }
     const SignedSize sent = Platform::sendTo(mSocketHandle, data, size, &address.sa);
     if (sent == -1) {
-        if (errno == EWOULDBLOCK) {
-            return makeUnexpected(WouldBlock{});
-        }
-        throw Exception(FUNC_NAME, "Couldn't send data - ", getLastErrorFormatted());
+        return makeUnexpected(SocketError::last());
     }
     ASSERT(sent >= 0);
     return static_cast<UnsignedSize>(sent);
@@ -29,23 +59,206 @@ Expected<UnsignedSize, WouldBlock> Socket<IPProto::UDP>::sendTo(const Byte* data
     return sendTo(data, size, createAddr(hostIp, hostPort));
 }
 
+Expected<UnsignedSize, WouldBlock> Socket<IPProto::UDP>::sendToSegmented(const Byte* data,
+                                                                         const UnsignedSize size,
+                                                                         const UnsignedSize segmentSize,
+                                                                         const Address& address) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't send data");
+    }
+    const Expected<UnsignedSize, SocketError> sent = trySendToSegmented(data, size, segmentSize, address);
+    if (sent) {
+        return *sent;
+    }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::UDP>::trySendToSegmented(const Byte* data,
+                                         const UnsignedSize size,
+                                         const UnsignedSize segmentSize,
+                                         const Address& address) noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    if (segmentSize == 0 || segmentSize > std::numeric_limits<std::uint16_t>::max()) {
+        return makeUnexpected(SocketError::invalidArgument());
+    }
+    if (!isIPAddress(&address)) {
+        return makeUnexpected(SocketError::unsupportedFamily());
+    }
+    const SignedSize sent = Platform::sendToSegmented(mSocketHandle, data, size, segmentSize, &address.sa);
+    if (sent == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(sent >= 0);
+    return static_cast<UnsignedSize>(sent);
+}
+
+Expected<ZeroCopySend, WouldBlock>
+Socket<IPProto::UDP>::sendToZeroCopy(const Byte* data, const UnsignedSize size, const Address& address) {
+    return SocketBase::sendZeroCopy(data, size, &address);
+}
+
 Expected<UnsignedSize, WouldBlock>
 Socket<IPProto::UDP>::receiveFrom(Byte* data, const UnsignedSize maxSize, Endpoint* source) {
+    Address addr;
+    const Expected<UnsignedSize, WouldBlock> received = receiveFrom(data, maxSize, addr);
+    if (received && source) {
+        *source = utils::getEndpoint(addr);
+    }
+    return received;
+}
+
+Expected<UnsignedSize, WouldBlock>
+Socket<IPProto::UDP>::receiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) {
     if (!isOpen()) {
         throw Exception(FUNC_NAME, "Couldn't receive data");
     }
-    Address addr;
-    const SignedSize received = Platform::receiveFrom(mSocketHandle, data, maxSize, &addr.sa);
+    const Expected<UnsignedSize, SocketError> received = tryReceiveFrom(data, maxSize, source);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::UDP>::tryReceiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize received = Platform::receiveFrom(mSocketHandle, data, maxSize, &source.sa);
     if (received == -1) {
-        if (errno == EWOULDBLOCK) {
-            return makeUnexpected(WouldBlock{});
-        }
-        throw Exception(FUNC_NAME, "Couldn't receive data - ", getLastErrorFormatted());
+        return makeUnexpected(SocketError::last());
     }
     ASSERT(received >= 0);
-    if (source) {
-        *source = utils::getEndpoint(addr);
+    return static_cast<UnsignedSize>(received);
+}
+
+Expected<UnsignedSize, WouldBlock> Socket<IPProto::UDP>::receiveFromCoalesced(Byte* data,
+                                                                              const UnsignedSize maxSize,
+                                                                              Address& source,
+                                                                              UnsignedSize& segmentSize) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't receive data");
+    }
+    const Expected<UnsignedSize, SocketError> received =
+        tryReceiveFromCoalesced(data, maxSize, source, segmentSize);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::UDP>::tryReceiveFromCoalesced(Byte* data,
+                                              const UnsignedSize maxSize,
+                                              Address& source,
+                                              UnsignedSize& segmentSize) noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize received =
+        Platform::receiveFromCoalesced(mSocketHandle, data, maxSize, &source.sa, &segmentSize);
+    if (received == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(received >= 0);
+    return static_cast<UnsignedSize>(received);
+}
+
+Expected<PooledBuffer, WouldBlock>
+Socket<IPProto::UDP>::receiveFrom(BufferPool& pool, const UnsignedSize maxSize, Address& source) {
+    PooledBuffer buffer = pool.acquire(maxSize);
+    const Expected<UnsignedSize, WouldBlock> received = receiveFrom(buffer.data(), maxSize, source);
+    if (!received) {
+        return makeUnexpected(WouldBlock{});
+    }
+    buffer.resize(*received);
+    return buffer;
+}
+
+Expected<PooledBuffer, SocketError>
+Socket<IPProto::UDP>::tryReceiveFrom(BufferPool& pool, const UnsignedSize maxSize, Address& source) noexcept {
+    PooledBuffer buffer = pool.tryAcquire(maxSize);
+    if (!buffer) {
+        return makeUnexpected(SocketError::noBuffers());
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceiveFrom(buffer.data(), maxSize, source);
+    if (!received) {
+        return makeUnexpected(received.error());
+    }
+    buffer.resize(*received);
+    return buffer;
+}
+
+Expected<UnsignedSize, WouldBlock> Socket<IPProto::UDP>::sendBatch(OutgoingDatagram* datagrams,
+                                                                   const UnsignedSize count) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't send data");
+    }
+    const Expected<UnsignedSize, SocketError> sent = trySendBatch(datagrams, count);
+    if (sent) {
+        return *sent;
     }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+Expected<UnsignedSize, SocketError> Socket<IPProto::UDP>::trySendBatch(OutgoingDatagram* datagrams,
+                                                                       const UnsignedSize count) noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    for (UnsignedSize i = 0; i < count; ++i) {
+        if (datagrams[i].address && !isIPAddress(datagrams[i].address)) {
+            return makeUnexpected(SocketError::unsupportedFamily());
+        }
+    }
+    const SignedSize sent = Platform::sendBatch(mSocketHandle, datagrams, count);
+    if (sent == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(sent >= 0);
+    return static_cast<UnsignedSize>(sent);
+}
+
+Expected<UnsignedSize, WouldBlock> Socket<IPProto::UDP>::receiveBatch(IncomingDatagram* datagrams,
+                                                                      const UnsignedSize count) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't receive data");
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceiveBatch(datagrams, count);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+Expected<UnsignedSize, SocketError>
+Socket<IPProto::UDP>::tryReceiveBatch(IncomingDatagram* datagrams, const UnsignedSize count) noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize received = Platform::receiveBatch(mSocketHandle, datagrams, count);
+    if (received == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(received >= 0);
     return static_cast<UnsignedSize>(received);
 }
 
@@ -0,0 +1,336 @@
+#include "cpplibsocket/SocketUnix.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <cstring>
+
+namespace cpplibsocket {
+
+template <IPProto TIPProto>
+std::pair<Socket<TIPProto>, Socket<TIPProto>> UnixSocketBase<TIPProto>::pair() {
+    SocketHandle sockets[2];
+    if (!Platform::socketPair(TIPProto, sockets)) {
+        throw Exception(FUNC_NAME, "Couldn't create socket pair - ", getLastErrorFormatted());
+    }
+    return std::make_pair(Socket<TIPProto>(sockets[0]), Socket<TIPProto>(sockets[1]));
+}
+
+template <IPProto TIPProto>
+void UnixSocketBase<TIPProto>::bind(const Address& address) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    if (::bind(mSocketHandle, &address.sa, getAddrSize(&address.sa)) != 0) {
+        throw Exception(FUNC_NAME,
+                        "Couldn't bind address \"",
+                        utils::getUnixPath(address),
+                        "\" - ",
+                        getLastErrorFormatted());
+    }
+}
+
+template <IPProto TIPProto>
+void UnixSocketBase<TIPProto>::bind(const std::string& path) {
+    bind(utils::createUnixAddr(path));
+}
+
+template <IPProto TIPProto>
+void UnixSocketBase<TIPProto>::bindAbstract(const std::string& name) {
+    bind(utils::createAbstractAddr(name));
+}
+
+template <IPProto TIPProto>
+std::string UnixSocketBase<TIPProto>::getPath() const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    return utils::getUnixPath(utils::getAddressFromFd(mSocketHandle));
+}
+
+template <IPProto TIPProto>
+std::string UnixSocketBase<TIPProto>::getPeerPath() const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Socket is not open");
+    }
+    return utils::getUnixPath(utils::getPeerAddressFromFd(mSocketHandle));
+}
+
+template <IPProto TIPProto>
+void UnixSocketBase<TIPProto>::connect(const Address& address) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "The socket is not open");
+    }
+    const Expected<Connected, SocketError> connected = tryConnect(address);
+    if (!connected) {
+        throw Exception(
+            FUNC_NAME, "Couldn't connect to \"", utils::getUnixPath(address), "\" - ", connected.error());
+    }
+}
+
+template <IPProto TIPProto>
+void UnixSocketBase<TIPProto>::connect(const std::string& path) {
+    connect(utils::createUnixAddr(path));
+}
+
+template <IPProto TIPProto>
+Expected<Connected, SocketError> UnixSocketBase<TIPProto>::tryConnect(const Address& address) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    if (address.sa.sa_family != AF_UNIX) {
+        return makeUnexpected(SocketError::unsupportedFamily());
+    }
+    if (!Platform::connect(mSocketHandle, &address.sa, getAddrSize(&address.sa))) {
+        return makeUnexpected(SocketError::last());
+    }
+    return Connected{};
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, WouldBlock> UnixSocketBase<TIPProto>::send(const Byte* data,
+                                                                  const UnsignedSize size) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't send data");
+    }
+    const Expected<UnsignedSize, SocketError> sent = trySend(data, size);
+    if (sent) {
+        return *sent;
+    }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, SocketError>
+UnixSocketBase<TIPProto>::trySend(const Byte* data, const UnsignedSize size) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize sent = Platform::send(mSocketHandle, data, size);
+    if (sent == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(sent >= 0);
+    return static_cast<UnsignedSize>(sent);
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, WouldBlock> UnixSocketBase<TIPProto>::receive(Byte* data,
+                                                                     const UnsignedSize maxSize) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't receive data");
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceive(data, maxSize);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, SocketError>
+UnixSocketBase<TIPProto>::tryReceive(Byte* data, const UnsignedSize maxSize) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SignedSize received = Platform::receive(mSocketHandle, data, maxSize);
+    if (received == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(received >= 0);
+    return static_cast<UnsignedSize>(received);
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, SocketError>
+UnixSocketBase<TIPProto>::sendAll(const Byte* data,
+                                  const UnsignedSize size,
+                                  UnsignedSize& sent) const noexcept {
+    ASSERT(sent <= size);
+    const UnsignedSize start = sent;
+    while (sent < size) {
+        const Expected<UnsignedSize, SocketError> result = trySend(data + sent, size - sent);
+        if (!result) {
+            if (result.error().category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(result.error());
+        }
+        sent += *result;
+    }
+    return sent - start;
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, SocketError>
+UnixSocketBase<TIPProto>::receiveExact(Byte* data,
+                                       const UnsignedSize size,
+                                       UnsignedSize& received) const noexcept {
+    ASSERT(received <= size);
+    const UnsignedSize start = received;
+    while (received < size) {
+        const Expected<UnsignedSize, SocketError> result = tryReceive(data + received, size - received);
+        if (!result) {
+            if (result.error().category() == SocketError::Category::Interrupted) {
+                continue;
+            }
+            return makeUnexpected(result.error());
+        }
+        if (*result == 0) {
+            break; // The peer closed the connection
+        }
+        received += *result;
+    }
+    return received - start;
+}
+
+template <IPProto TIPProto>
+UnixSocketBase<TIPProto>::UnixSocketBase()
+    : SocketBase(TIPProto, IPVer::IPV4) {}
+
+template <IPProto TIPProto>
+UnixSocketBase<TIPProto>::UnixSocketBase(const SocketHandle socketHandle) noexcept
+    : SocketBase(TIPProto, IPVer::IPV4, socketHandle) {}
+
+template <IPProto TIPProto>
+void UnixSocketBase<TIPProto>::listen(const int backlogSize) {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "The socket is not open");
+    }
+    if (::listen(mSocketHandle, backlogSize) == -1) {
+        throw Exception(FUNC_NAME, "Couldn't open socket for listening - ", getLastErrorFormatted());
+    }
+}
+
+template <IPProto TIPProto>
+Expected<Socket<TIPProto>, WouldBlock> UnixSocketBase<TIPProto>::accept() const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "The socket is not open");
+    }
+    Expected<Socket<TIPProto>, SocketError> client = tryAccept();
+    if (client) {
+        return std::move(*client);
+    }
+    if (client.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't accept client - ", client.error());
+}
+
+template <IPProto TIPProto>
+Expected<Socket<TIPProto>, SocketError> UnixSocketBase<TIPProto>::tryAccept() const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    const SocketHandle client = Platform::accept(mSocketHandle, nullptr);
+    if (client == Platform::SOCKET_NULL) {
+        return makeUnexpected(SocketError::last());
+    }
+    return Socket<TIPProto>(client);
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, WouldBlock>
+UnixSocketBase<TIPProto>::sendTo(const Byte* data, const UnsignedSize size, const Address& address) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't send data");
+    }
+    const Expected<UnsignedSize, SocketError> sent = trySendTo(data, size, address);
+    if (sent) {
+        return *sent;
+    }
+    if (sent.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't send data - ", sent.error());
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, SocketError>
+UnixSocketBase<TIPProto>::trySendTo(const Byte* data,
+                                    const UnsignedSize size,
+                                    const Address& address) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    if (address.sa.sa_family != AF_UNIX) {
+        return makeUnexpected(SocketError::unsupportedFamily());
+    }
+    const SignedSize sent = Platform::sendTo(mSocketHandle, data, size, &address.sa);
+    if (sent == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(sent >= 0);
+    return static_cast<UnsignedSize>(sent);
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, WouldBlock>
+UnixSocketBase<TIPProto>::receiveFrom(Byte* data, const UnsignedSize maxSize, Address& source) const {
+    if (!isOpen()) {
+        throw Exception(FUNC_NAME, "Couldn't receive data");
+    }
+    const Expected<UnsignedSize, SocketError> received = tryReceiveFrom(data, maxSize, source);
+    if (received) {
+        return *received;
+    }
+    if (received.error().isWouldBlock()) {
+        return makeUnexpected(WouldBlock{});
+    }
+    throw Exception(FUNC_NAME, "Couldn't receive data - ", received.error());
+}
+
+template <IPProto TIPProto>
+Expected<UnsignedSize, SocketError>
+UnixSocketBase<TIPProto>::tryReceiveFrom(Byte* data,
+                                         const UnsignedSize maxSize,
+                                         Address& source) const noexcept {
+    if (!isOpen()) {
+        return makeUnexpected(SocketError::notOpen());
+    }
+    // Zeroed whole, the abstract names are not terminated and an unnamed sender leaves the path untouched
+    std::memset(&source, 0, sizeof(source));
+    const SignedSize received = Platform::receiveFrom(mSocketHandle, data, maxSize, &source.sa);
+    if (received == -1) {
+        return makeUnexpected(SocketError::last());
+    }
+    ASSERT(received >= 0);
+    return static_cast<UnsignedSize>(received);
+}
+
+template class UnixSocketBase<IPProto::UnixStream>;
+template class UnixSocketBase<IPProto::UnixDatagram>;
+template class UnixSocketBase<IPProto::UnixSeqPacket>;
+
+Socket<IPProto::UnixStream>::Socket() = default;
+
+Socket<IPProto::UnixStream>::Socket(const SocketOptions<IPProto::UnixStream>& options) {
+    setOptions(options);
+}
+
+Socket<IPProto::UnixStream>::Socket(const SocketHandle socketHandle) noexcept
+    : UnixSocketBase(socketHandle) {}
+
+Socket<IPProto::UnixDatagram>::Socket() = default;
+
+Socket<IPProto::UnixDatagram>::Socket(const SocketOptions<IPProto::UnixDatagram>& options) {
+    setOptions(options);
+}
+
+Socket<IPProto::UnixDatagram>::Socket(const SocketHandle socketHandle) noexcept
+    : UnixSocketBase(socketHandle) {}
+
+Socket<IPProto::UnixSeqPacket>::Socket() = default;
+
+Socket<IPProto::UnixSeqPacket>::Socket(const SocketOptions<IPProto::UnixSeqPacket>& options) {
+    setOptions(options);
+}
+
+Socket<IPProto::UnixSeqPacket>::Socket(const SocketHandle socketHandle) noexcept
+    : UnixSocketBase(socketHandle) {}
+
+} // namespace cpplibsocket
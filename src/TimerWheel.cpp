@@ -0,0 +1,208 @@
+#include "cpplibsocket/TimerWheel.h"
+
+#include <algorithm>
+
+namespace cpplibsocket {
+
+namespace {
+
+    void pushBack(detail::TimerLink& list, detail::TimerLink& link) noexcept {
+        link.prev = list.prev;
+        link.next = &list;
+        list.prev->next = &link;
+        list.prev = &link;
+    }
+
+    void remove(detail::TimerLink& link) noexcept {
+        link.prev->next = link.next;
+        link.next->prev = link.prev;
+        link.prev = &link;
+        link.next = &link;
+    }
+
+    bool isEmpty(const detail::TimerLink& list) noexcept { return list.next == &list; }
+
+    std::uint64_t rotateRight(const std::uint64_t value, const unsigned shift) noexcept {
+        return shift == 0 ? value : (value >> shift) | (value << (64 - shift));
+    }
+
+    unsigned countTrailingZeros(const std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+        unsigned count = 0;
+        while (!(value & (std::uint64_t(1) << count))) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+} // namespace
+
+void Timer::cancel() noexcept {
+    if (mWheel) {
+        mWheel->unlink(*this);
+    }
+}
+
+TimerWheel::TimerWheel(const Options& options, const Clock::time_point now)
+    : mStart(now)
+    , mResolution(options.resolution) {
+    if (mResolution <= Clock::duration::zero()) {
+        throw Exception(FUNC_NAME, "The resolution has to be positive");
+    }
+}
+
+TimerWheel::~TimerWheel() noexcept {
+    for (List& list : mLists) {
+        while (!isEmpty(list)) {
+            Timer& timer = static_cast<Timer&>(*list.next);
+            remove(timer);
+            timer.mWheel = nullptr;
+        }
+    }
+}
+
+void TimerWheel::schedule(Timer& timer, const Clock::time_point deadline) noexcept {
+    timer.cancel();
+    if (deadline <= mStart) {
+        timer.mExpiry = 0;
+    } else {
+        // Rounded up, so the timer never expires before its deadline
+        timer.mExpiry = static_cast<std::uint64_t>((deadline - mStart + mResolution - Clock::duration(1)) /
+                                                   mResolution);
+    }
+    timer.mWheel = this;
+    ++mSize;
+    link(timer);
+}
+
+UnsignedSize TimerWheel::advance(const Clock::time_point now) {
+    const std::uint64_t target =
+        now <= mStart ? 0 : static_cast<std::uint64_t>((now - mStart) / mResolution);
+    UnsignedSize expired = expire(mLists[DUE_LIST]);
+    for (std::uint64_t next = nextTick(); next != NO_TICK && next <= target; next = nextTick()) {
+        mTick = next;
+        for (unsigned level = LEVELS; level-- > 1;) {
+            const std::uint64_t slotTicks = std::uint64_t(1) << (level * SLOT_BITS);
+            if (mTick % slotTicks == 0) {
+                cascade(level);
+            }
+        }
+        // The timers of the slot of the current tick, as well as those cascaded to it, are due now
+        const unsigned slot = mTick % SLOTS;
+        List& list = mLists[slot];
+        while (!isEmpty(list)) {
+            Timer& timer = static_cast<Timer&>(*list.next);
+            remove(timer);
+            timer.mList = DUE_LIST;
+            pushBack(mLists[DUE_LIST], timer);
+        }
+        mOccupied[0] &= ~(std::uint64_t(1) << slot);
+        expired += expire(mLists[DUE_LIST]);
+    }
+    mTick = std::max(mTick, target);
+    return expired;
+}
+
+TimerWheel::Clock::duration TimerWheel::timeUntilNext(const Clock::time_point now) const noexcept {
+    if (!isEmpty(mLists[DUE_LIST])) {
+        return Clock::duration::zero();
+    }
+    const std::uint64_t next = nextTick();
+    if (next == NO_TICK) {
+        return Clock::duration(-1);
+    }
+    const Clock::time_point at = mStart + mResolution * static_cast<Clock::rep>(next);
+    return std::max(at - now, Clock::duration::zero());
+}
+
+void TimerWheel::link(Timer& timer) noexcept {
+    if (timer.mExpiry <= mTick) {
+        timer.mList = DUE_LIST;
+        pushBack(mLists[DUE_LIST], timer);
+        return;
+    }
+    // The lowest level whose slot of the expiry is less than a revolution ahead of the current one
+    unsigned level = 0;
+    std::uint64_t slot = 0;
+    for (; level < LEVELS; ++level) {
+        const unsigned shift = level * SLOT_BITS;
+        if ((timer.mExpiry >> shift) - (mTick >> shift) < SLOTS) {
+            slot = (timer.mExpiry >> shift) % SLOTS;
+            break;
+        }
+    }
+    if (level == LEVELS) {
+        // Beyond the span of the wheel, parked in the farthest slot and rescheduled once it's reached
+        level = LEVELS - 1;
+        slot = ((mTick >> (level * SLOT_BITS)) + SLOTS - 1) % SLOTS;
+    }
+    timer.mList = level * SLOTS + static_cast<unsigned>(slot);
+    pushBack(mLists[timer.mList], timer);
+    mOccupied[level] |= std::uint64_t(1) << slot;
+}
+
+void TimerWheel::unlink(Timer& timer) noexcept {
+    remove(timer);
+    if (timer.mList != DUE_LIST && isEmpty(mLists[timer.mList])) {
+        mOccupied[timer.mList / SLOTS] &= ~(std::uint64_t(1) << (timer.mList % SLOTS));
+    }
+    timer.mWheel = nullptr;
+    --mSize;
+}
+
+std::uint64_t TimerWheel::nextTick() const noexcept {
+    std::uint64_t next = NO_TICK;
+    for (unsigned level = 0; level < LEVELS; ++level) {
+        if (!mOccupied[level]) {
+            continue;
+        }
+        // The slots are searched starting from the one following the current slot of the level, which
+        // can't hold any timers as they'd be due in this very slot
+        const unsigned shift = level * SLOT_BITS;
+        const unsigned current = (mTick >> shift) % SLOTS;
+        const std::uint64_t ahead = rotateRight(mOccupied[level], (current + 1) % SLOTS);
+        const unsigned distance = 1 + countTrailingZeros(ahead);
+        next = std::min(next, ((mTick >> shift) + distance) << shift);
+    }
+    return next;
+}
+
+void TimerWheel::cascade(const unsigned level) noexcept {
+    const unsigned slot = (mTick >> (level * SLOT_BITS)) % SLOTS;
+    List& list = mLists[level * SLOTS + slot];
+    if (isEmpty(list)) {
+        return;
+    }
+    List cascaded;
+    while (!isEmpty(list)) {
+        List& link = *list.next;
+        remove(link);
+        pushBack(cascaded, link);
+    }
+    mOccupied[level] &= ~(std::uint64_t(1) << slot);
+    while (!isEmpty(cascaded)) {
+        Timer& timer = static_cast<Timer&>(*cascaded.next);
+        remove(timer);
+        link(timer);
+    }
+}
+
+UnsignedSize TimerWheel::expire(List& list) {
+    UnsignedSize expired = 0;
+    while (!isEmpty(list)) {
+        Timer& timer = static_cast<Timer&>(*list.next);
+        unlink(timer);
+        ++expired;
+        // Called through a copy, so the callback may destroy the timer
+        const Timer::Callback callback = timer.mCallback;
+        if (callback) {
+            callback();
+        }
+    }
+    return expired;
+}
+
+} // namespace cpplibsocket
@@ -3,7 +3,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <set>
 #include <vector>
 
@@ -58,6 +60,73 @@ std::string getLastErrorFormatted() {
     return getErrorString(WSAGetLastError());
 }
 
+SocketError::SocketError(const int code) noexcept
+    : mCode(code) {
+    switch (code) {
+    case WSAEWOULDBLOCK:
+        mCategory = Category::WouldBlock;
+        break;
+    case WSAEINTR:
+        mCategory = Category::Interrupted;
+        break;
+    case WSAEINPROGRESS:
+        mCategory = Category::InProgress;
+        break;
+    case WSAECONNRESET:
+        mCategory = Category::ConnectionReset;
+        break;
+    case WSAECONNREFUSED:
+        mCategory = Category::ConnectionRefused;
+        break;
+    case WSAECONNABORTED:
+        mCategory = Category::ConnectionAborted;
+        break;
+    case WSAESHUTDOWN:
+        mCategory = Category::BrokenPipe;
+        break;
+    case WSAETIMEDOUT:
+        mCategory = Category::TimedOut;
+        break;
+    case WSAENOTCONN:
+        mCategory = Category::NotConnected;
+        break;
+    case WSAENOTSOCK:
+        mCategory = Category::NotOpen;
+        break;
+    default:
+        mCategory = Category::Other;
+        break;
+    }
+}
+
+SocketError SocketError::last() noexcept {
+    return SocketError(WSAGetLastError());
+}
+
+SocketError SocketError::notOpen() noexcept {
+    return SocketError(WSAENOTSOCK);
+}
+
+SocketError SocketError::noBuffers() noexcept {
+    return SocketError(WSAENOBUFS);
+}
+
+SocketError SocketError::timedOut() noexcept {
+    return SocketError(WSAETIMEDOUT);
+}
+
+SocketError SocketError::unsupportedFamily() noexcept {
+    return SocketError(WSAEAFNOSUPPORT);
+}
+
+SocketError SocketError::invalidArgument() noexcept {
+    return SocketError(WSAEINVAL);
+}
+
+std::string SocketError::message() const {
+    return getErrorString(static_cast<DWORD>(mCode));
+}
+
 namespace Platform {
 
     SignedSize send(SocketHandle socket, const Byte* data, const UnsignedSize size) {
@@ -69,7 +138,7 @@ namespace Platform {
     SignedSize sendTo(SocketHandle socket, const Byte* data, const UnsignedSize size, const sockaddr* addr) {
         const int viableSize =
             static_cast<int>(std::min(static_cast<UnsignedSize>(std::numeric_limits<int>::max()), size));
-        const SockLenType sockSize = getAddrSize(toIPVer(addr->sa_family));
+        const SockLenType sockSize = getAddrSize(addr);
         return static_cast<SignedSize>(
             ::sendto(socket, reinterpret_cast<const char*>(data), viableSize, 0, addr, sockSize));
     }
@@ -88,17 +157,295 @@ namespace Platform {
             ::recvfrom(socket, reinterpret_cast<char*>(data), viableSize, 0, addr, &sockSize));
     }
 
+    SignedSize sendToSegmented(SocketHandle socket,
+                               const Byte* data,
+                               const UnsignedSize size,
+                               const UnsignedSize segmentSize,
+                               const sockaddr* addr) {
+        // Without the offload, the segments are sent one by one
+        UnsignedSize sent = 0;
+        while (sent < size) {
+            const UnsignedSize segment = std::min(segmentSize, size - sent);
+            if (sendTo(socket, data + sent, segment, addr) == -1) {
+                return sent == 0 ? -1 : static_cast<SignedSize>(sent);
+            }
+            sent += segment;
+        }
+        return static_cast<SignedSize>(sent);
+    }
+
+    SignedSize receiveFromCoalesced(
+        SocketHandle socket, Byte* data, const UnsignedSize size, sockaddr* addr, UnsignedSize* segmentSize) {
+        // The datagrams are never coalesced without the offload
+        const SignedSize received = receiveFrom(socket, data, size, addr);
+        if (received != -1) {
+            *segmentSize = static_cast<UnsignedSize>(received);
+        }
+        return received;
+    }
+
+    SignedSize peek(SocketHandle socket, Byte* data, const UnsignedSize size) {
+        // There's no MSG_DONTWAIT, the readiness is polled first so the peek never blocks
+        WSAPOLLFD descriptor = {};
+        descriptor.fd = socket;
+        descriptor.events = POLLRDNORM;
+        const int ready = ::WSAPoll(&descriptor, 1, 0);
+        if (ready == SOCKET_ERROR) {
+            return -1;
+        }
+        if (ready == 0) {
+            WSASetLastError(WSAEWOULDBLOCK);
+            return -1;
+        }
+        const int viableSize =
+            static_cast<int>(std::min(static_cast<UnsignedSize>(std::numeric_limits<int>::max()), size));
+        return static_cast<SignedSize>(::recv(socket, reinterpret_cast<char*>(data), viableSize, MSG_PEEK));
+    }
+
+    SignedSize sendv(SocketHandle socket, const ConstBuffer* buffers, const UnsignedSize count) {
+        const UnsignedSize bufferCount = std::min(count, MAX_BUFFER_COUNT);
+        WSABUF wsaBuffers[MAX_BUFFER_COUNT];
+        for (UnsignedSize i = 0; i < bufferCount; ++i) {
+            wsaBuffers[i].buf = reinterpret_cast<char*>(const_cast<Byte*>(buffers[i].data));
+            wsaBuffers[i].len = static_cast<ULONG>(
+                std::min(static_cast<UnsignedSize>(std::numeric_limits<ULONG>::max()), buffers[i].size));
+        }
+        DWORD sent = 0;
+        const int result =
+            WSASend(socket, wsaBuffers, static_cast<DWORD>(bufferCount), &sent, 0, nullptr, nullptr);
+        if (result == SOCKET_ERROR) {
+            return -1;
+        }
+        return static_cast<SignedSize>(sent);
+    }
+
+    SignedSize receivev(SocketHandle socket, const MutableBuffer* buffers, const UnsignedSize count) {
+        const UnsignedSize bufferCount = std::min(count, MAX_BUFFER_COUNT);
+        WSABUF wsaBuffers[MAX_BUFFER_COUNT];
+        for (UnsignedSize i = 0; i < bufferCount; ++i) {
+            wsaBuffers[i].buf = reinterpret_cast<char*>(buffers[i].data);
+            wsaBuffers[i].len = static_cast<ULONG>(
+                std::min(static_cast<UnsignedSize>(std::numeric_limits<ULONG>::max()), buffers[i].size));
+        }
+        DWORD received = 0;
+        DWORD flags = 0;
+        const int result =
+            WSARecv(socket, wsaBuffers, static_cast<DWORD>(bufferCount), &received, &flags, nullptr, nullptr);
+        if (result == SOCKET_ERROR) {
+            return -1;
+        }
+        return static_cast<SignedSize>(received);
+    }
+
+    SignedSize sendBatch(SocketHandle socket, OutgoingDatagram* datagrams, const UnsignedSize count) {
+        // Winsock has no batched datagram API, the datagrams are sent one by one
+        const UnsignedSize batchSize = std::min(count, MAX_BATCH_SIZE);
+        for (UnsignedSize i = 0; i < batchSize; ++i) {
+            const SignedSize sent =
+                datagrams[i].address
+                    ? sendTo(socket, datagrams[i].data, datagrams[i].size, &datagrams[i].address->sa)
+                    : send(socket, datagrams[i].data, datagrams[i].size);
+            if (sent == -1) {
+                return i == 0 ? -1 : static_cast<SignedSize>(i);
+            }
+            datagrams[i].sent = static_cast<UnsignedSize>(sent);
+        }
+        return static_cast<SignedSize>(batchSize);
+    }
+
+    SignedSize receiveBatch(SocketHandle socket, IncomingDatagram* datagrams, const UnsignedSize count) {
+        const UnsignedSize batchSize = std::min(count, MAX_BATCH_SIZE);
+        for (UnsignedSize i = 0; i < batchSize; ++i) {
+            if (i > 0) {
+                // Mimic MSG_WAITFORONE - only wait for the first datagram
+                u_long available = 0;
+                if (ioctlsocket(socket, FIONREAD, &available) == SOCKET_ERROR || available == 0) {
+                    return static_cast<SignedSize>(i);
+                }
+            }
+            const SignedSize received =
+                receiveFrom(socket, datagrams[i].data, datagrams[i].maxSize, &datagrams[i].source.sa);
+            if (received == -1) {
+                return i == 0 ? -1 : static_cast<SignedSize>(i);
+            }
+            datagrams[i].size = static_cast<UnsignedSize>(received);
+        }
+        return static_cast<SignedSize>(batchSize);
+    }
+
     bool setBlocked(SocketHandle socket, const bool blocked) {
         u_long mode = blocked ? 0U : 1U;
         return ioctlsocket(socket, FIONBIO, &mode) != SOCKET_ERROR;
     }
 
+    bool setZeroCopy(SocketHandle, const bool) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return false;
+    }
+
+    bool setOption(SocketHandle socket, const int level, const int name, const int value) {
+        const DWORD optval = static_cast<DWORD>(value);
+        return setsockopt(socket, level, name, reinterpret_cast<const char*>(&optval), sizeof(optval)) !=
+               SOCKET_ERROR;
+    }
+
+    bool getOption(SocketHandle socket, const int level, const int name, int* value) {
+        DWORD optval = 0;
+        SockLenType size = sizeof(optval);
+        if (getsockopt(socket, level, name, reinterpret_cast<char*>(&optval), &size) == SOCKET_ERROR) {
+            return false;
+        }
+        *value = static_cast<int>(optval);
+        return true;
+    }
+
+    bool shutdown(SocketHandle socket, const bool send, const bool receive) {
+        const int how = send && receive ? SD_BOTH : send ? SD_SEND : SD_RECEIVE;
+        return ::shutdown(socket, how) != SOCKET_ERROR;
+    }
+
+    bool setReusePort(SocketHandle, const bool) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return false;
+    }
+
+    bool attachReusePortCpuSteering(SocketHandle, const unsigned) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return false;
+    }
+
+    SignedSize sendZeroCopy(SocketHandle, const Byte*, const UnsignedSize, const sockaddr*) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return -1;
+    }
+
+    SignedSize readZeroCopyCompletion(SocketHandle, ZeroCopyCompletion*) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return -1;
+    }
+
     SocketHandle openSocket(const IPProto ipProtocol, const IPVer ipVersion) {
-        return ::socket(toNativeDomain(ipVersion), toNativeType(ipProtocol), toNativeProtocol(ipProtocol));
+        const AddressFamily domain = isUnixProtocol(ipProtocol) ? AF_UNIX : toNativeDomain(ipVersion);
+        return ::socket(domain, toNativeType(ipProtocol), toNativeProtocol(ipProtocol));
+    }
+
+    bool socketPair(const IPProto, SocketHandle*) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return false;
+    }
+
+    bool connect(SocketHandle socket, const sockaddr* addr, const SockLenType addrSize) {
+        if (::connect(socket, addr, addrSize) != SOCKET_ERROR) {
+            return true;
+        }
+        if (WSAGetLastError() == WSAEWOULDBLOCK) {
+            WSASetLastError(WSAEINPROGRESS);
+        }
+        return false;
+    }
+
+    int
+    waitWritable(const SocketHandle* sockets, bool* ready, const UnsignedSize count, const int timeoutMs) {
+        // A connection races just a few sockets, so the descriptors are allocated only past the stack array
+        constexpr UnsignedSize MAX_POLL_STACK_COUNT = 16;
+        WSAPOLLFD local[MAX_POLL_STACK_COUNT];
+        std::unique_ptr<WSAPOLLFD[]> allocated;
+        WSAPOLLFD* descriptors = local;
+        if (count > MAX_POLL_STACK_COUNT) {
+            allocated.reset(new (std::nothrow) WSAPOLLFD[count]);
+            if (!allocated) {
+                WSASetLastError(WSAENOBUFS);
+                return -1;
+            }
+            descriptors = allocated.get();
+        }
+        for (UnsignedSize i = 0; i < count; ++i) {
+            descriptors[i].fd = sockets[i];
+            descriptors[i].events = POLLWRNORM;
+            descriptors[i].revents = 0;
+        }
+        const int polled = ::WSAPoll(descriptors, static_cast<ULONG>(count), timeoutMs);
+        for (UnsignedSize i = 0; i < count; ++i) {
+            ready[i] = polled > 0 && descriptors[i].revents != 0;
+        }
+        return polled == SOCKET_ERROR ? -1 : polled;
+    }
+
+    SocketHandle accept(SocketHandle socket, Address* peer, const bool nonBlocking, const bool) {
+        // Windows sockets are not inherited by child processes unless explicitly requested
+        SockLenType addrLen = sizeof(Address);
+        const SocketHandle client = ::accept(socket, peer ? &peer->sa : nullptr, peer ? &addrLen : nullptr);
+        if (client != SOCKET_NULL && nonBlocking && !setBlocked(client, false)) {
+            ::closesocket(client);
+            return SOCKET_NULL;
+        }
+        return client;
     }
 
     bool closeSocket(SocketHandle socket) { return ::closesocket(socket) != SOCKET_ERROR; }
 
+    FileHandle openFile(const std::string& path) {
+        return ::CreateFileA(path.c_str(),
+                             GENERIC_READ,
+                             FILE_SHARE_READ,
+                             nullptr,
+                             OPEN_EXISTING,
+                             FILE_FLAG_SEQUENTIAL_SCAN,
+                             nullptr);
+    }
+
+    bool closeFile(FileHandle file) { return ::CloseHandle(file) != 0; }
+
+    SignedSize
+    sendFile(SocketHandle socket, FileHandle file, const std::uint64_t offset, const UnsignedSize size) {
+        // TransmitFile() can't report partial transfers on non-blocking sockets, so the file is read and sent
+        // a chunk at a time. A chunk sent partially is read again from the new offset by the next call.
+        Byte chunk[64 * 1024];
+        OVERLAPPED position = {};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        const DWORD toRead = static_cast<DWORD>(std::min<UnsignedSize>(size, sizeof(chunk)));
+        DWORD read = 0;
+        if (!::ReadFile(file, chunk, toRead, &read, &position)) {
+            if (GetLastError() == ERROR_HANDLE_EOF) {
+                return 0;
+            }
+            return -1;
+        }
+        if (read == 0) {
+            return 0;
+        }
+        return static_cast<SignedSize>(
+            ::send(socket, reinterpret_cast<const char*>(chunk), static_cast<int>(read), 0));
+    }
+
+    SignedSize spliceToPipe(const int, const int, const UnsignedSize) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return -1;
+    }
+
+    SignedSize spliceFromPipe(const int, const SocketHandle, const UnsignedSize) {
+        WSASetLastError(WSAEOPNOTSUPP);
+        return -1;
+    }
+
+    void* mapMemory(const UnsignedSize size, const bool hugePages, bool* mappedHugePages) {
+        *mappedHugePages = false;
+        const DWORD allocation = MEM_RESERVE | MEM_COMMIT;
+        const SIZE_T largePageSize = GetLargePageMinimum();
+        // Large pages need the SeLockMemoryPrivilege, the allocation fails without it
+        if (hugePages && largePageSize != 0 && size % largePageSize == 0) {
+            void* memory = ::VirtualAlloc(nullptr, size, allocation | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (memory) {
+                *mappedHugePages = true;
+                return memory;
+            }
+        }
+        return ::VirtualAlloc(nullptr, size, allocation, PAGE_READWRITE);
+    }
+
+    bool unmapMemory(void* memory, const UnsignedSize) { return ::VirtualFree(memory, 0, MEM_RELEASE) != 0; }
+
 } // namespace Platform
 
 } // namespace cpplibsocket
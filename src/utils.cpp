@@ -1,9 +1,26 @@
 #include "cpplibsocket/utils/utils.h"
+#include "cpplibsocket/utils/AddressParser.h"
 #include "cpplibsocket/utils/Defer.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace cpplibsocket {
 namespace utils {
 
+    int remainingTimeoutMs(const std::chrono::steady_clock::time_point deadline) noexcept {
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= remaining.zero()) {
+            return 0;
+        }
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(remaining);
+        if (ms < remaining) {
+            ++ms;
+        }
+        return static_cast<int>(
+            std::min<std::chrono::milliseconds::rep>(ms.count(), std::numeric_limits<int>::max()));
+    }
+
     AddrInfo::AddrInfo(const std::string& address, struct addrinfo* hint)
         : mInfo(nullptr) {
         const int status = getaddrinfo(address.c_str(), nullptr, hint, &mInfo);
@@ -22,7 +39,9 @@ namespace utils {
     AddrInfo::Iterator AddrInfo::end() const { return Iterator(nullptr); }
 
     Address getAddressFromFd(SocketHandle socket) {
-        Address addr = {};
+        Address addr;
+        // Zeroed whole, the abstract Unix domain names are not terminated
+        std::memset(&addr, 0, sizeof(addr));
         SockLenType len = sizeof(addr);
         if (::getsockname(socket, &addr.sa, &len) != 0) {
             throw Exception(FUNC_NAME, "Couldn't get address from socket - ", getLastErrorFormatted());
@@ -30,21 +49,41 @@ namespace utils {
         return addr;
     }
 
+    Address getPeerAddressFromFd(SocketHandle socket) {
+        Address addr;
+        std::memset(&addr, 0, sizeof(addr));
+        SockLenType len = sizeof(addr);
+        if (::getpeername(socket, &addr.sa, &len) != 0) {
+            throw Exception(FUNC_NAME, "Couldn't get peer address from socket - ", getLastErrorFormatted());
+        }
+        return addr;
+    }
+
     Endpoint getEndpoint(const Address& addr) {
         char str[INET6_ADDRSTRLEN] = {};
         ::inet_ntop(addr.sa_stor.ss_family, getSinAddr(addr), str, sizeof(str));
-        return Endpoint(toIPVer(addr.sa_stor.ss_family), std::string(str), getSinPort(addr));
+        return Endpoint(toIPVer(addr.sa_stor.ss_family), IpString(str), getSinPort(addr));
     }
 
     Endpoint getEndpoint(SocketHandle socket) { return getEndpoint(getAddressFromFd(socket)); }
 
     Address createAddr(const Endpoint& endpoint) {
-        return createAddr(endpoint.ipVersion, endpoint.ip, endpoint.port);
+        IpBytes ip;
+        if (parseIp(endpoint.ipVersion, endpoint.ip.data(), endpoint.ip.size(), ip)) {
+            return StaticAddress(ip, endpoint.port);
+        }
+        return createAddr(endpoint.ipVersion, endpoint.ip.str(), endpoint.port);
     }
 
     Address createAddr(const IPVer ipVersion, const std::string& ipAddress, const Port port) {
         Address addr = {};
         if (!ipAddress.empty()) {
+            IpBytes ip;
+            if (parseIp(ipVersion, ipAddress.data(), ipAddress.size(), ip)) {
+                return StaticAddress(ip, port);
+            }
+
+            // Forms the fast parser doesn't handle (e.g. scope identifiers) are left to the system
             struct addrinfo hint = {};
             hint.ai_family = toNativeDomain(ipVersion);
             hint.ai_flags = AI_NUMERICHOST;
@@ -72,6 +111,45 @@ namespace utils {
         return addr;
     }
 
+    Address createUnixAddr(const std::string& path) {
+        Address addr;
+        std::memset(&addr, 0, sizeof(addr));
+        // Room is left for the terminating NUL byte
+        if (path.empty() || path.size() >= sizeof(addr.sa_un.sun_path) ||
+            path.find('\0') != std::string::npos) {
+            throw Exception(FUNC_NAME, "Invalid Unix domain socket path \"", path, "\"");
+        }
+        addr.sa_un.sun_family = AF_UNIX;
+        std::memcpy(addr.sa_un.sun_path, path.data(), path.size());
+        return addr;
+    }
+
+    Address createAbstractAddr(const std::string& name) {
+        Address addr;
+        std::memset(&addr, 0, sizeof(addr));
+        // Room is left for the leading NUL byte
+        if (name.empty() || name.size() >= sizeof(addr.sa_un.sun_path) ||
+            name.find('\0') != std::string::npos) {
+            throw Exception(FUNC_NAME, "Invalid abstract Unix domain socket name \"", name, "\"");
+        }
+        addr.sa_un.sun_family = AF_UNIX;
+        std::memcpy(addr.sa_un.sun_path + 1, name.data(), name.size());
+        return addr;
+    }
+
+    std::string getUnixPath(const Address& address) {
+        if (address.sa.sa_family != AF_UNIX) {
+            throw Exception(FUNC_NAME, "Address family ", address.sa.sa_family, " is not supported");
+        }
+        const char* path = address.sa_un.sun_path;
+        const UnsignedSize maxLength = sizeof(address.sa_un.sun_path);
+        if (path[0] != '\0') {
+            return std::string(path, ::strnlen(path, maxLength));
+        }
+        const UnsignedSize length = ::strnlen(path + 1, maxLength - 1);
+        return length == 0 ? std::string() : "@" + std::string(path + 1, length);
+    }
+
     Optional<Address>
     resolveHostname(const std::string& hostname, const Port port, const Optional<IPVer> ipVersion) noexcept {
         struct addrinfo hint = {};
@@ -101,7 +179,7 @@ namespace utils {
         if (!addr) {
             return NullOptional;
         }
-        return getEndpoint(*addr).ip;
+        return getEndpoint(*addr).ip.str();
     }
 
 } // namespace utils
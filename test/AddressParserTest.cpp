@@ -0,0 +1,91 @@
+#include "cpplibsocket/utils/AddressParser.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+using namespace cpplibsocket;
+using namespace cpplibsocket::literals;
+
+namespace {
+
+constexpr utils::StaticAddress STATSD = "10.0.0.1:8125"_addr;
+static_assert(STATSD.ipVersion() == IPVer::IPV4, "");
+static_assert(STATSD.port() == 8125, "");
+static_assert(STATSD.ip().bytes[0] == 10 && STATSD.ip().bytes[3] == 1, "");
+
+constexpr utils::StaticAddress LOOPBACK6 = "[::1]:80"_addr;
+static_assert(LOOPBACK6.ipVersion() == IPVer::IPV6, "");
+static_assert(LOOPBACK6.port() == 80, "");
+static_assert(LOOPBACK6.ip().bytes[15] == 1, "");
+
+bool parsesLikeSystem(const IPVer ipVersion, const std::string& str) {
+    utils::IpBytes parsed;
+    const bool valid = utils::parseIp(ipVersion, str.data(), str.size(), parsed);
+    std::uint8_t expected[16] = {};
+    const int family = ipVersion == IPVer::IPV4 ? AF_INET : AF_INET6;
+    const bool expectedValid = ::inet_pton(family, str.c_str(), expected) == 1;
+    if (valid != expectedValid) {
+        return false;
+    }
+    return !valid || std::memcmp(parsed.bytes, expected, ipVersion == IPVer::IPV4 ? 4 : 16) == 0;
+}
+
+} // namespace
+
+TEST(AddressParserTest, ipv4MatchesSystemParser) {
+    for (const char* str : { "0.0.0.0",
+                             "127.0.0.1",
+                             "255.255.255.255",
+                             "192.168.1.20",
+                             "256.0.0.1",
+                             "1.2.3",
+                             "1.2.3.4.5",
+                             "1..2.3",
+                             "01.2.3.4",
+                             "1.2.3.4 ",
+                             "",
+                             "a.b.c.d" }) {
+        EXPECT_TRUE(parsesLikeSystem(IPVer::IPV4, str)) << str;
+    }
+}
+
+TEST(AddressParserTest, ipv6MatchesSystemParser) {
+    for (const char* str : { "::",
+                             "::1",
+                             "1::",
+                             "fe80::1:2",
+                             "2001:db8:0:0:1:0:0:1",
+                             "2001:DB8::ABCD:ef01",
+                             "::ffff:192.168.1.1",
+                             "64:ff9b::10.0.0.1",
+                             "1:2:3:4:5:6:7:8",
+                             "1:2:3:4:5:6:7::",
+                             "1:2:3:4:5:6:7:8:9",
+                             "1:2:3:4:5:6:7",
+                             "1::2::3",
+                             ":1::",
+                             "1:",
+                             "12345::",
+                             "::1.2.3",
+                             "1.2.3.4::",
+                             "g::1" }) {
+        EXPECT_TRUE(parsesLikeSystem(IPVer::IPV6, str)) << str;
+    }
+}
+
+TEST(AddressParserTest, createAddrFallsBackForScopeIds) {
+    const Address fast = utils::createAddr(IPVer::IPV6, "fe80::1", 443);
+    EXPECT_EQ(utils::getSinPort(fast), 443);
+    EXPECT_EQ(utils::getEndpoint(fast).ip, "fe80::1");
+
+    const Address scoped = utils::createAddr(IPVer::IPV6, "fe80::1%1", 443);
+    EXPECT_EQ(scoped.sa_in6.sin6_scope_id, 1U);
+    EXPECT_THROW(utils::createAddr(IPVer::IPV4, "::1", 0), Exception);
+}
+
+TEST(AddressParserTest, literalConvertsToAddress) {
+    const Address addr = "127.0.0.1:9000"_addr;
+    EXPECT_EQ(utils::getEndpoint(addr).ip, "127.0.0.1");
+    EXPECT_EQ(utils::getSinPort(addr), 9000);
+    EXPECT_THROW(utils::parseStaticAddress("1.2.3.4:70000", 13), utils::InvalidAddressLiteral);
+}
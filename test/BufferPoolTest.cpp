@@ -0,0 +1,173 @@
+#include "TestUtils.h"
+#include "cpplibsocket/BufferPool.h"
+#include "cpplibsocket/Socket.h"
+
+#include <gmock/gmock.h>
+
+#include <cerrno>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace cpplibsocket;
+
+namespace {
+
+BufferPool::Options smallPool() {
+    BufferPool::Options options;
+    options.bufferSizes = { 1024, 4096 };
+    options.chunkSize = 16 * 1024;
+    return options;
+}
+
+} // namespace
+
+TEST(BufferPoolTest, acquireTakesSmallestFittingClass) {
+    BufferPool pool(smallPool());
+    EXPECT_EQ(pool.allocatedMemory(), 0u);
+
+    const PooledBuffer small = pool.acquire(100);
+    ASSERT_TRUE(small);
+    EXPECT_EQ(small.capacity(), 1024u);
+    EXPECT_EQ(small.size(), 100u);
+
+    const PooledBuffer large = pool.acquire(1025);
+    EXPECT_EQ(large.capacity(), 4096u);
+    EXPECT_EQ(pool.allocatedMemory(), 2 * 16 * 1024u);
+    EXPECT_EQ(pool.maxBufferSize(), 4096u);
+
+    EXPECT_THROW(pool.acquire(4097), Exception);
+    EXPECT_FALSE(pool.tryAcquire(4097));
+}
+
+TEST(BufferPoolTest, copiesShareTheBuffer) {
+    BufferPool pool(smallPool());
+    PooledBuffer buffer = pool.acquire(10);
+    const Byte* data = buffer.data();
+    {
+        const PooledBuffer copy = buffer;
+        EXPECT_EQ(copy.data(), data);
+        EXPECT_EQ(buffer.useCount(), 2u);
+    }
+    EXPECT_EQ(buffer.useCount(), 1u);
+
+    buffer.reset();
+    EXPECT_FALSE(buffer);
+    // The thread cache hands the buffer released last out first
+    EXPECT_EQ(pool.acquire(10).data(), data);
+}
+
+TEST(BufferPoolTest, memoryLimitIsRespected) {
+    BufferPool::Options options = smallPool();
+    options.bufferSizes = { 4096 };
+    options.maxMemory = 16 * 1024;
+    options.threadCacheSize = 0;
+    BufferPool pool(options);
+
+    std::vector<PooledBuffer> buffers;
+    for (int i = 0; i < 4; ++i) {
+        buffers.push_back(pool.acquire(4096));
+    }
+    EXPECT_FALSE(pool.tryAcquire(1));
+    EXPECT_THROW(pool.acquire(1), Exception);
+
+    buffers.pop_back();
+    EXPECT_TRUE(pool.tryAcquire(1));
+    EXPECT_EQ(pool.allocatedMemory(), 16 * 1024u);
+}
+
+TEST(BufferPoolTest, buffersReleasedByOtherThreadsAreReused) {
+    BufferPool::Options options = smallPool();
+    options.bufferSizes = { 1024 };
+    options.threadCacheSize = 4;
+    options.maxMemory = 16 * 1024;
+    BufferPool pool(options);
+
+    // Exhausts the pool several times over, handing each buffer to another thread to release
+    for (int round = 0; round < 4; ++round) {
+        std::vector<PooledBuffer> buffers;
+        while (PooledBuffer buffer = pool.tryAcquire(1024)) {
+            buffers.push_back(std::move(buffer));
+        }
+        EXPECT_EQ(buffers.size(), 16u);
+        std::thread([moved = std::move(buffers)]() mutable { moved.clear(); }).join();
+    }
+    EXPECT_EQ(pool.allocatedMemory(), 16 * 1024u);
+}
+
+TEST(BufferPoolTest, hugePagesFallBackToRegularPages) {
+    BufferPool::Options options = smallPool();
+    options.hugePages = true;
+    BufferPool pool(options);
+    PooledBuffer buffer = pool.acquire(4096);
+    ASSERT_TRUE(buffer);
+    std::memset(buffer.data(), 0xab, buffer.capacity());
+    // Either way the chunk is rounded up to the huge page size
+    EXPECT_EQ(pool.allocatedMemory(), 2 * 1024 * 1024u);
+}
+
+#ifdef __linux__
+TEST(BufferPoolTest, unmapsWholeHugePageChunkOnRegularPages) {
+    BufferPool::Options options;
+    options.bufferSizes = { 10000 };
+    options.threadCacheSize = 0;
+    options.hugePages = true;
+    const UnsignedSize chunkSize = 2 * 1024 * 1024;
+    const UnsignedSize pageSize = static_cast<UnsignedSize>(::sysconf(_SC_PAGESIZE));
+    unsigned char residency = 0;
+    Byte* chunk = nullptr;
+    {
+        BufferPool pool(options);
+        PooledBuffer buffer = pool.acquire(10000);
+        if (pool.usesHugePages()) {
+            GTEST_SKIP() << "Huge pages are reserved, so the chunks aren't mapped by regular pages";
+        }
+        // Still mapped huge page aligned, with a tail of more than a page past the last whole buffer
+        ASSERT_EQ(pool.allocatedMemory(), chunkSize);
+        ASSERT_GT(chunkSize % options.bufferSizes[0], pageSize);
+        chunk = buffer.data(); // The first buffer taken starts the chunk
+        ASSERT_EQ(::mincore(chunk + chunkSize - pageSize, pageSize, &residency), 0);
+    }
+    EXPECT_EQ(::mincore(chunk, pageSize, &residency), -1);
+    EXPECT_EQ(::mincore(chunk + chunkSize - pageSize, pageSize, &residency), -1);
+    EXPECT_EQ(errno, ENOMEM);
+}
+#endif
+
+TEST(BufferPoolTest, receiveIntoPooledBuffer) {
+    BufferPool pool(smallPool());
+    Socket<IPProto::TCP> client(IPVer::IPV4);
+    Socket<IPProto::TCP> server = connectThroughListener(client);
+    server.setBlocked(false);
+
+    const auto nothing = server.tryReceive(pool, 1024);
+    ASSERT_FALSE(nothing);
+    EXPECT_TRUE(nothing.error().isWouldBlock());
+
+    const Byte message[] = { 'h', 'e', 'l', 'l', 'o' };
+    client.send(message, sizeof(message));
+    server.setBlocked(true);
+    const auto received = server.receive(pool, 1024);
+    ASSERT_TRUE(received);
+    EXPECT_EQ(received->size(), sizeof(message));
+    EXPECT_EQ(std::memcmp(received->data(), message, sizeof(message)), 0);
+}
+
+TEST(BufferPoolTest, receiveFromIntoPooledBuffer) {
+    BufferPool pool(smallPool());
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Byte message[] = { 'h', 'i' };
+    sender.sendTo(message, sizeof(message), "127.0.0.1", port);
+
+    Address source;
+    const auto received = receiver.receiveFrom(pool, 4096, source);
+    ASSERT_TRUE(received);
+    EXPECT_EQ(received->size(), sizeof(message));
+    EXPECT_EQ(received->capacity(), 4096u);
+    EXPECT_EQ(source.sa.sa_family, AF_INET);
+}
@@ -0,0 +1,144 @@
+#include "cpplibsocket/ConnectionPool.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <thread>
+
+using namespace cpplibsocket;
+
+namespace {
+
+/// Listening socket, the connections complete without being accepted
+struct Server {
+    Server()
+        : listener(IPVer::IPV4) {
+        port = listener.bind("127.0.0.1");
+        listener.listen(16);
+        address = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    }
+
+    Socket<IPProto::TCP> listener;
+    Port port;
+    Address address;
+};
+
+} // namespace
+
+TEST(ConnectionPoolTest, reusesReturnedConnections) {
+    Server server;
+    ConnectionPool pool;
+    Port localPort;
+    {
+        ConnectionPool::Lease lease = pool.acquire(server.address);
+        EXPECT_FALSE(lease.isReused());
+        localPort = lease->getEndpoint().port;
+    }
+    EXPECT_EQ(pool.idleCount(), 1U);
+
+    ConnectionPool::Lease lease = pool.acquire(server.address);
+    EXPECT_TRUE(lease.isReused());
+    EXPECT_EQ(lease->getEndpoint().port, localPort);
+    EXPECT_EQ(pool.idleCount(), 0U);
+    EXPECT_EQ(pool.size(server.address), 1U);
+}
+
+TEST(ConnectionPoolTest, replacesConnectionsClosedByPeer) {
+    Server server;
+    ConnectionPool pool;
+    pool.acquire(server.address).release();
+    Socket<IPProto::TCP> accepted = std::move(*server.listener.accept());
+    accepted.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Until the FIN arrives
+
+    ConnectionPool::Lease lease = pool.acquire(server.address);
+    EXPECT_FALSE(lease.isReused());
+    EXPECT_EQ(pool.size(server.address), 1U);
+}
+
+TEST(ConnectionPoolTest, discardsConnections) {
+    Server server;
+    ConnectionPool pool;
+    ConnectionPool::Lease lease = pool.acquire(server.address);
+    lease.discard();
+    EXPECT_EQ(pool.idleCount(), 0U);
+    EXPECT_EQ(pool.size(server.address), 0U);
+}
+
+TEST(ConnectionPoolTest, evictsIdleConnections) {
+    Server server;
+    ConnectionPool::Options options;
+    options.idleTimeout = std::chrono::seconds(10);
+    ConnectionPool pool(options);
+    pool.acquire(server.address).release();
+    pool.acquire(server.address).release();
+    EXPECT_EQ(pool.idleCount(), 1U);
+
+    EXPECT_EQ(pool.evictIdle(), 0U);
+    EXPECT_EQ(pool.evictIdle(ConnectionPool::Clock::now() + std::chrono::seconds(11)), 1U);
+    EXPECT_EQ(pool.idleCount(), 0U);
+    EXPECT_EQ(pool.size(server.address), 0U);
+}
+
+TEST(ConnectionPoolTest, evictsConnectionsClosedByPeer) {
+    Server server;
+    ConnectionPool pool;
+    ConnectionPool::Lease first = pool.acquire(server.address);
+    ConnectionPool::Lease second = pool.acquire(server.address);
+    const Port secondPort = second->getEndpoint().port;
+    first.release();
+    second.release();
+    Socket<IPProto::TCP> accepted = std::move(*server.listener.accept());
+    accepted.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Until the FIN arrives
+
+    EXPECT_EQ(pool.evictIdle(), 1U);
+    EXPECT_EQ(pool.idleCount(), 1U);
+    EXPECT_EQ(pool.size(server.address), 1U);
+    ConnectionPool::Lease lease = pool.acquire(server.address);
+    EXPECT_TRUE(lease.isReused());
+    EXPECT_EQ(lease->getEndpoint().port, secondPort);
+}
+
+TEST(ConnectionPoolTest, limitsConnectionsPerHost) {
+    Server server;
+    ConnectionPool::Options options;
+    options.maxPerHost = 1;
+    ConnectionPool pool(options);
+    ConnectionPool::Lease first = pool.acquire(server.address);
+    EXPECT_THROW(pool.acquire(server.address, std::chrono::milliseconds(10)), Exception);
+
+    std::thread releaser([&first]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        first.release();
+    });
+    ConnectionPool::Lease second = pool.acquire(server.address, std::chrono::seconds(5));
+    releaser.join();
+    EXPECT_TRUE(second.isReused());
+    EXPECT_EQ(pool.size(server.address), 1U);
+}
+
+TEST(ConnectionPoolTest, reportsFailedConnections) {
+    Socket<IPProto::TCP> unused(IPVer::IPV4);
+    const Port port = unused.bind("127.0.0.1");
+    ConnectionPool pool;
+    const Address address = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    EXPECT_THROW(pool.acquire(address), Exception);
+    EXPECT_EQ(pool.size(address), 0U);
+}
+
+TEST(ConnectionPoolTest, connectingRespectsTheDeadline) {
+    // The accept queue is full, so the SYNs of further connections are dropped
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(0);
+    const Address address = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    Socket<IPProto::TCP> filler(IPVer::IPV4);
+    filler.connect(address, std::chrono::seconds(5));
+
+    ConnectionPool pool;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(pool.acquire(address, std::chrono::milliseconds(100)), Exception);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_EQ(pool.size(address), 0U);
+}
@@ -0,0 +1,190 @@
+#include "cpplibsocket/Coroutine.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+using namespace cpplibsocket;
+
+namespace {
+
+Task<UnsignedSize> receiveAll(AsyncSocket<IPProto::TCP>& socket, Byte* data, const UnsignedSize size) {
+    UnsignedSize received = 0;
+    while (received < size) {
+        const Expected<UnsignedSize, SocketError> result =
+            co_await socket.asyncReceive(data + received, size - received);
+        if (!result || *result == 0) {
+            break;
+        }
+        received += *result;
+    }
+    co_return received;
+}
+
+Task<void> echoServer(AsyncSocket<IPProto::TCP>& listener, int& served) {
+    Expected<AsyncSocket<IPProto::TCP>, SocketError> client = co_await listener.asyncAccept();
+    EXPECT_TRUE(client);
+    if (!client) {
+        co_return;
+    }
+    client->socket().setOption<opt::NoDelay>(true);
+    Byte buffer[1024];
+    for (;;) {
+        const Expected<UnsignedSize, SocketError> received =
+            co_await client->asyncReceive(buffer, sizeof(buffer));
+        if (!received || *received == 0) {
+            break;
+        }
+        const Expected<UnsignedSize, SocketError> sent = co_await client->asyncSend(buffer, *received);
+        EXPECT_TRUE(sent);
+    }
+    ++served;
+}
+
+Task<void> echoClient(AsyncIo& io, const Port port, std::vector<Byte>& echoed) {
+    AsyncSocket<IPProto::TCP> socket(io, Socket<IPProto::TCP>(IPVer::IPV4));
+    const Expected<Connected, SocketError> connected =
+        co_await socket.asyncConnect(utils::createAddr(IPVer::IPV4, "127.0.0.1", port));
+    EXPECT_TRUE(connected);
+    socket.socket().setOption<opt::NoDelay>(true);
+
+    std::vector<Byte> data(256 * 1024);
+    for (UnsignedSize i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<Byte>(i * 7);
+    }
+    // Each chunk is echoed before the next one is sent, the receiving side waits for the data every time
+    UnsignedSize echoedSize = 0;
+    echoed.resize(data.size());
+    while (echoedSize < data.size()) {
+        const UnsignedSize chunk = std::min<UnsignedSize>(data.size() - echoedSize, 4096);
+        UnsignedSize sent = 0;
+        while (sent < chunk) {
+            const Expected<UnsignedSize, SocketError> result =
+                co_await socket.asyncSend(data.data() + echoedSize + sent, chunk - sent);
+            if (!result) {
+                ADD_FAILURE() << result.error();
+                co_return;
+            }
+            sent += *result;
+        }
+        const UnsignedSize received = co_await receiveAll(socket, echoed.data() + echoedSize, chunk);
+        if (received != chunk) {
+            ADD_FAILURE() << "The connection was closed";
+            co_return;
+        }
+        echoedSize += chunk;
+    }
+    EXPECT_EQ(echoed, data);
+}
+
+} // namespace
+
+TEST(CoroutineTest, echoesOverTcp) {
+    Reactor reactor;
+    AsyncIo io(reactor);
+    Socket<IPProto::TCP> listenerSocket(IPVer::IPV4);
+    const Port port = listenerSocket.bind("127.0.0.1");
+    listenerSocket.listen(16);
+    AsyncSocket<IPProto::TCP> listener(io, std::move(listenerSocket));
+
+    int served = 0;
+    std::vector<Byte> echoed;
+    spawn(echoServer(listener, served));
+    spawn(echoClient(io, port, echoed));
+    for (int i = 0; i < 10000 && served == 0; ++i) {
+        reactor.poll(std::chrono::seconds(1));
+    }
+    EXPECT_EQ(served, 1);
+    EXPECT_EQ(echoed.size(), 256U * 1024U);
+}
+
+TEST(CoroutineTest, reportsRefusedConnection) {
+    Reactor reactor;
+    AsyncIo io(reactor);
+    Socket<IPProto::TCP> unused(IPVer::IPV4);
+    const Port port = unused.bind("127.0.0.1");
+
+    bool done = false;
+    spawn([](AsyncIo& asyncIo, const Port target, bool& finished) -> Task<void> {
+        AsyncSocket<IPProto::TCP> socket(asyncIo, Socket<IPProto::TCP>(IPVer::IPV4));
+        const Expected<Connected, SocketError> connected =
+            co_await socket.asyncConnect(utils::createAddr(IPVer::IPV4, "127.0.0.1", target));
+        EXPECT_FALSE(connected);
+        if (!connected) {
+            EXPECT_EQ(connected.error().category(), SocketError::Category::ConnectionRefused);
+        }
+        finished = true;
+    }(io, port, done));
+    for (int i = 0; i < 100 && !done; ++i) {
+        reactor.poll(std::chrono::seconds(1));
+    }
+    EXPECT_TRUE(done);
+}
+
+TEST(CoroutineTest, exchangesDatagrams) {
+    Reactor reactor;
+    AsyncIo io(reactor);
+    Socket<IPProto::UDP> receiverSocket(IPVer::IPV4);
+    const Port port = receiverSocket.bind("127.0.0.1");
+    AsyncSocket<IPProto::UDP> receiver(io, std::move(receiverSocket));
+    AsyncSocket<IPProto::UDP> sender(io, Socket<IPProto::UDP>(IPVer::IPV4));
+
+    std::string received;
+    spawn([](AsyncSocket<IPProto::UDP>& socket, std::string& result) -> Task<void> {
+        Byte buffer[64];
+        Address source;
+        const Expected<UnsignedSize, SocketError> size =
+            co_await socket.asyncReceiveFrom(buffer, sizeof(buffer), source);
+        EXPECT_TRUE(size);
+        if (!size) {
+            co_return;
+        }
+        result.assign(reinterpret_cast<const char*>(buffer), *size);
+    }(receiver, received));
+    EXPECT_TRUE(received.empty()); // Suspended until the datagram arrives
+
+    spawn([](AsyncSocket<IPProto::UDP>& socket, const Port target) -> Task<void> {
+        const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", target);
+        const char message[] = "datagram";
+        const Expected<UnsignedSize, SocketError> sent = co_await socket.asyncSendTo(
+            reinterpret_cast<const Byte*>(message), std::strlen(message), destination);
+        EXPECT_TRUE(sent);
+    }(sender, port));
+    for (int i = 0; i < 100 && received.empty(); ++i) {
+        reactor.poll(std::chrono::seconds(1));
+    }
+    EXPECT_EQ(received, "datagram");
+}
+
+TEST(CoroutineTest, allocatesFramesFromCurrentAllocator) {
+    class CountingAllocator final : public FrameAllocator {
+    public:
+        void* allocate(const std::size_t size) override {
+            ++allocations;
+            return mRecycling.allocate(size);
+        }
+
+        void deallocate(void* frame, const std::size_t size) noexcept override {
+            ++deallocations;
+            mRecycling.deallocate(frame, size);
+        }
+
+        int allocations = 0;
+        int deallocations = 0;
+
+    private:
+        RecyclingFrameAllocator mRecycling;
+    };
+
+    CountingAllocator allocator;
+    FrameAllocator* previous = FrameAllocator::setCurrent(&allocator);
+    int result = 0;
+    spawn([](int& value) -> Task<void> {
+        value = co_await [](const int x) -> Task<int> { co_return x * 2; }(21);
+    }(result));
+    EXPECT_EQ(FrameAllocator::setCurrent(previous), &allocator);
+    EXPECT_EQ(result, 42);
+    EXPECT_EQ(allocator.allocations, 2);
+    EXPECT_EQ(allocator.deallocations, 2);
+}
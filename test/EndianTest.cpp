@@ -0,0 +1,61 @@
+#include "cpplibsocket/common/Endian.h"
+
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+constexpr Endian::Type foreign() {
+    return Endian::getNative() == Endian::Type::Little ? Endian::Type::Big : Endian::Type::Little;
+}
+
+template <typename T>
+void expectBulkMatchesScalar() {
+    // Odd sizes exercise both the vector kernels and the scalar tails
+    for (const std::size_t count : { 0, 1, 3, 7, 16, 33, 100, 1027 }) {
+        std::vector<T> values(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i] = static_cast<T>(i * 0x01020304050607ull + 0x1122);
+        }
+        std::vector<T> converted(count);
+        Endian::convertToNative(values.data(), converted.data(), count, foreign());
+        for (std::size_t i = 0; i < count; ++i) {
+            const T expected = Endian::convertToNative(values[i], foreign());
+            ASSERT_EQ(std::memcmp(&converted[i], &expected, sizeof(T)), 0)
+                << "count " << count << ", index " << i;
+        }
+
+        // In place, twice gives the original values back
+        Endian::convertNativeTo(converted.data(), converted.data(), count, foreign());
+        EXPECT_EQ(std::memcmp(converted.data(), values.data(), count * sizeof(T)), 0);
+    }
+}
+
+} // namespace
+
+TEST(EndianTest, nativeOrderIsKnownAtCompileTime) {
+    static_assert(Endian::getNative() != Endian::Type::Unknown, "Unknown byte order");
+    const std::uint32_t value = 1;
+    const bool little = *reinterpret_cast<const unsigned char*>(&value) == 1;
+    EXPECT_EQ(Endian::getNative(), little ? Endian::Type::Little : Endian::Type::Big);
+}
+
+TEST(EndianTest, scalarConversion) {
+    static_assert(Endian::byteSwap(std::uint32_t(0x01020304)) == 0x04030201, "");
+    EXPECT_EQ(Endian::convertToNative(std::uint16_t(0x0102), foreign()), 0x0201);
+    EXPECT_EQ(Endian::convertToNative(std::uint64_t(0x0102030405060708), foreign()), 0x0807060504030201u);
+    EXPECT_EQ(Endian::convertToNative(std::int32_t(0x01020304), Endian::getNative()), 0x01020304);
+    const double value = 1.5;
+    EXPECT_EQ(Endian::convertToNative(Endian::convertNativeTo(value, foreign()), foreign()), value);
+    EXPECT_NE(Endian::convertNativeTo(value, foreign()), value);
+}
+
+TEST(EndianTest, bulkConversion) {
+    expectBulkMatchesScalar<std::uint16_t>();
+    expectBulkMatchesScalar<std::uint32_t>();
+    expectBulkMatchesScalar<std::uint64_t>();
+    expectBulkMatchesScalar<float>();
+    expectBulkMatchesScalar<double>();
+}
@@ -0,0 +1,108 @@
+#include "TestUtils.h"
+#include "cpplibsocket/Framing.h"
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+using namespace cpplibsocket;
+
+namespace {
+
+const Byte* bytes(const std::string& text) {
+    return reinterpret_cast<const Byte*>(text.data());
+}
+
+std::string toString(const ConstBuffer& buffer) {
+    return std::string(reinterpret_cast<const char*>(buffer.data), buffer.size);
+}
+
+} // namespace
+
+TEST(FramingTest, decodeReportsIncompleteFrames) {
+    const FrameDecoder decoder;
+    const Byte frame[] = { 0, 0, 0, 3, 'a', 'b', 'c', 0, 0 };
+
+    DecodedFrame decoded = decoder.decode(frame, 2);
+    EXPECT_EQ(decoded.status, DecodedFrame::Status::Incomplete);
+    EXPECT_EQ(decoded.size, 4u);
+
+    decoded = decoder.decode(frame, 6);
+    EXPECT_EQ(decoded.status, DecodedFrame::Status::Incomplete);
+    EXPECT_EQ(decoded.size, 7u);
+
+    decoded = decoder.decode(frame, sizeof(frame));
+    ASSERT_EQ(decoded.status, DecodedFrame::Status::Complete);
+    EXPECT_EQ(decoded.size, 7u);
+    EXPECT_EQ(decoded.payload.data, frame + 4);
+    EXPECT_EQ(toString(decoded.payload), "abc");
+}
+
+TEST(FramingTest, prefixWidthAndByteOrder) {
+    FramingOptions options;
+    options.prefixSize = 2;
+    options.byteOrder = Endian::Type::Little;
+    FrameEncoder encoder(options);
+    const std::string payload(0x0102, 'x');
+    encoder.add(bytes(payload), payload.size());
+    const std::vector<ConstBuffer>& buffers = encoder.buffers();
+    ASSERT_EQ(buffers.size(), 2u);
+    ASSERT_EQ(buffers[0].size, 2u);
+    EXPECT_EQ(buffers[0].data[0], 0x02);
+    EXPECT_EQ(buffers[0].data[1], 0x01);
+
+    options.prefixSize = 3;
+    EXPECT_THROW(FrameDecoder decoder(options), Exception);
+}
+
+TEST(FramingTest, framesAboveTheLimitAreRejected) {
+    FramingOptions options;
+    options.maxFrameSize = 8;
+    FrameEncoder encoder(options);
+    const std::string payload(9, 'x');
+    EXPECT_THROW(encoder.add(bytes(payload), payload.size()), Exception);
+
+    options.prefixSize = 1;
+    options.maxFrameSize = 1024;
+    FrameEncoder narrowEncoder(options);
+    const std::string wide(256, 'x');
+    EXPECT_THROW(narrowEncoder.add(bytes(wide), wide.size()), Exception);
+
+    const FrameDecoder decoder(FramingOptions{ 4, Endian::Type::Big, 8 });
+    const Byte frame[] = { 0, 0, 1, 0 };
+    const DecodedFrame decoded = decoder.decode(frame, sizeof(frame));
+    EXPECT_EQ(decoded.status, DecodedFrame::Status::TooLarge);
+    EXPECT_EQ(decoded.size, 256u);
+}
+
+TEST(FramingTest, batchedFramesAreReadIncrementally) {
+    ConnectedPair pair;
+    FrameEncoder encoder;
+    std::vector<std::string> payloads;
+    for (int i = 0; i < 100; ++i) {
+        payloads.push_back(std::string(static_cast<UnsignedSize>(i * 37), static_cast<char>('a' + i % 26)));
+    }
+    for (const std::string& payload : payloads) {
+        encoder.add(bytes(payload), payload.size());
+    }
+    while (!encoder.empty()) {
+        ASSERT_TRUE(encoder.flush(pair.client));
+    }
+
+    // A small initial capacity makes the frames straddle the reads and the buffer grow
+    FrameReader reader(FramingOptions(), 64);
+    UnsignedSize decoded = 0;
+    while (decoded < payloads.size()) {
+        const DecodedFrame frame = reader.next();
+        if (frame.status == DecodedFrame::Status::Incomplete) {
+            const auto received = reader.receive(pair.server);
+            ASSERT_TRUE(received);
+            ASSERT_NE(*received, 0u);
+            continue;
+        }
+        ASSERT_EQ(frame.status, DecodedFrame::Status::Complete);
+        EXPECT_EQ(toString(frame.payload), payloads[decoded]);
+        ++decoded;
+    }
+    EXPECT_EQ(reader.size(), 0u);
+}
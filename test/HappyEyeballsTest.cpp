@@ -0,0 +1,106 @@
+#include "cpplibsocket/HappyEyeballs.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+using namespace cpplibsocket;
+
+namespace {
+
+/// Listener whose accept queue is full, the SYNs of further connections are dropped
+struct BlackHole {
+    BlackHole()
+        : listener(IPVer::IPV4)
+        , filler(IPVer::IPV4) {
+        const Port port = listener.bind("127.0.0.1");
+        listener.listen(0);
+        address = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+        filler.connect(address, std::chrono::seconds(5));
+    }
+
+    Socket<IPProto::TCP> listener;
+    Socket<IPProto::TCP> filler;
+    Address address;
+};
+
+/// Address nothing listens on, the connections are refused
+Address refusedAddress() {
+    Socket<IPProto::TCP> unused(IPVer::IPV4);
+    const Port port = unused.bind("127.0.0.1");
+    return utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+}
+
+} // namespace
+
+TEST(HappyEyeballsTest, interleavesAddressFamilies) {
+    const Address v6a = utils::createAddr(IPVer::IPV6, "::1", 1);
+    const Address v6b = utils::createAddr(IPVer::IPV6, "::1", 2);
+    const Address v6c = utils::createAddr(IPVer::IPV6, "::1", 3);
+    const Address v4a = utils::createAddr(IPVer::IPV4, "127.0.0.1", 4);
+    const std::vector<Address> ordered = interleaveAddressFamilies({ v6a, v6b, v6c, v4a });
+    ASSERT_EQ(ordered.size(), 4U);
+    EXPECT_EQ(utils::getSinPort(ordered[0]), 1);
+    EXPECT_EQ(utils::getSinPort(ordered[1]), 4);
+    EXPECT_EQ(utils::getSinPort(ordered[2]), 2);
+    EXPECT_EQ(utils::getSinPort(ordered[3]), 3);
+    EXPECT_TRUE(interleaveAddressFamilies({}).empty());
+}
+
+TEST(HappyEyeballsTest, racesPastUnresponsiveAddress) {
+    BlackHole blackHole;
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+
+    HappyEyeballsOptions options;
+    options.attemptDelay = std::chrono::milliseconds(20);
+    options.timeout = std::chrono::seconds(5);
+    const auto start = std::chrono::steady_clock::now();
+    Socket<IPProto::TCP> socket =
+        connectFirst({ blackHole.address, utils::createAddr(IPVer::IPV4, "127.0.0.1", port) }, options);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    Socket<IPProto::TCP> server = std::move(*listener.accept());
+    const Byte byte = 42;
+    socket.send(&byte, 1);
+    Byte received = 0;
+    EXPECT_EQ(*server.receive(&received, 1), 1U);
+    EXPECT_EQ(received, byte);
+}
+
+TEST(HappyEyeballsTest, skipsRefusedAddresses) {
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+
+    // The delay is long, the refusal starts the next attempt right away
+    HappyEyeballsOptions options;
+    options.attemptDelay = std::chrono::seconds(10);
+    const auto start = std::chrono::steady_clock::now();
+    connectFirst({ refusedAddress(), refusedAddress(), utils::createAddr(IPVer::IPV4, "127.0.0.1", port) },
+                 options);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_TRUE(listener.accept());
+}
+
+TEST(HappyEyeballsTest, reportsFailures) {
+    EXPECT_THROW(connectFirst({}), Exception);
+    EXPECT_THROW(connectFirst({ refusedAddress(), refusedAddress() }), Exception);
+
+    BlackHole blackHole;
+    HappyEyeballsOptions options;
+    options.timeout = std::chrono::milliseconds(50);
+    EXPECT_THROW(connectFirst({ blackHole.address }, options), Exception);
+}
+
+TEST(HappyEyeballsTest, connectsToHostName) {
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+    std::istringstream hosts("127.0.0.1 service.test\n");
+    Resolver resolver(std::unique_ptr<ResolverSource>(new HostsResolverSource(hosts)));
+    connectHost(resolver, "service.test", port);
+    EXPECT_TRUE(listener.accept());
+    EXPECT_THROW(connectHost(resolver, "unknown.test", port), Exception);
+}
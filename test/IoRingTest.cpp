@@ -0,0 +1,175 @@
+#include "cpplibsocket/IoRing.h"
+#include "cpplibsocket/Socket.h"
+#include "cpplibsocket/SocketUnix.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <unistd.h>
+
+using namespace cpplibsocket;
+
+namespace {
+
+std::unique_ptr<IoRing> createRing() {
+    try {
+        return std::unique_ptr<IoRing>(new IoRing(64));
+    } catch (const Exception&) {
+        return nullptr; // io_uring may be disabled (e.g. by seccomp)
+    }
+}
+
+} // namespace
+
+TEST(IoRingTest, acceptConnectSendReceive) {
+    std::unique_ptr<IoRing> ring = createRing();
+    if (!ring) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+
+    Socket<IPProto::TCP> client(IPVer::IPV4);
+    Address peer;
+    SocketHandle accepted = Platform::SOCKET_NULL;
+    bool connected = false;
+    ring->accept(listener.getSocketHandle(), [&](const IoCompletion& c) { accepted = c.result; }, &peer);
+    ring->connect(client.getSocketHandle(),
+                  utils::createAddr(IPVer::IPV4, "127.0.0.1", port),
+                  [&](const IoCompletion& c) { connected = !c.isError(); });
+    while (ring->pending() > 0) {
+        ring->poll(std::chrono::seconds(1));
+    }
+    ASSERT_TRUE(connected);
+    ASSERT_GE(accepted, 0);
+    EXPECT_EQ(utils::getSinPort(peer), utils::getSinPort(utils::getAddressFromFd(client.getSocketHandle())));
+    Socket<IPProto::TCP> server = Socket<IPProto::TCP>::adopt(IPVer::IPV4, accepted);
+
+    const Byte data[] = { 1, 2, 3, 4 };
+    Byte received[8] = {};
+    SignedSize sent = 0;
+    SignedSize receivedSize = 0;
+    const SocketHandle files[] = { server.getSocketHandle() };
+    ring->registerFiles(files, 1);
+    ring->send(client.getSocketHandle(), data, sizeof(data), [&](const IoCompletion& c) { sent = c.result; });
+    ring->receive(FixedFile(0), received, sizeof(received), [&](const IoCompletion& c) {
+        receivedSize = c.result;
+    });
+    while (ring->pending() > 0) {
+        ring->poll(std::chrono::seconds(1));
+    }
+    EXPECT_EQ(sent, 4);
+    ASSERT_EQ(receivedSize, 4);
+    EXPECT_EQ(std::memcmp(received, data, sizeof(data)), 0);
+}
+
+TEST(IoRingTest, multishotReceiveWithBufferRing) {
+    std::unique_ptr<IoRing> ring = createRing();
+    if (!ring) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+
+    IoRing::BufferRing& buffers = ring->addBufferRing(1, 4, 64);
+    std::vector<std::string> messages;
+    const IoRing::OperationId id =
+        ring->receiveMultishot(receiver.getSocketHandle(), buffers, [&](const IoCompletion& c) {
+            if (c.isError()) {
+                return;
+            }
+            ASSERT_TRUE(c.bufferId);
+            const Byte* data = buffers.data(*c.bufferId);
+            messages.emplace_back(reinterpret_cast<const char*>(data), static_cast<std::size_t>(c.result));
+            buffers.recycle(*c.bufferId);
+        });
+    ring->submit();
+
+    for (const char* message : { "first", "second", "third" }) {
+        sender.sendTo(reinterpret_cast<const Byte*>(message), std::strlen(message), "127.0.0.1", port);
+    }
+    while (messages.size() < 3) {
+        ASSERT_GT(ring->poll(std::chrono::seconds(1)), 0U);
+    }
+    EXPECT_THAT(messages, ::testing::ElementsAre("first", "second", "third"));
+
+    ring->cancel(id);
+    while (ring->pending() > 0) {
+        ring->poll(std::chrono::seconds(1));
+    }
+}
+
+TEST(IoRingTest, cancelOfCompletedOperationKeepsReusedSlot) {
+    std::unique_ptr<IoRing> ring = createRing();
+    if (!ring) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Byte data[] = { 1, 2, 3 };
+    Byte buffer[8];
+
+    sender.sendTo(data, sizeof(data), "127.0.0.1", port);
+    SignedSize first = 0;
+    const IoRing::OperationId completed = ring->receive(
+        receiver.getSocketHandle(), buffer, sizeof(buffer), [&](const IoCompletion& c) { first = c.result; });
+    while (ring->pending() > 0) {
+        ring->poll(std::chrono::seconds(1));
+    }
+    EXPECT_EQ(first, 3);
+
+    SignedSize second = 0;
+    const IoRing::OperationId reused =
+        ring->receive(receiver.getSocketHandle(), buffer, sizeof(buffer), [&](const IoCompletion& c) {
+            second = c.result;
+        });
+    EXPECT_EQ(static_cast<std::uint32_t>(reused), static_cast<std::uint32_t>(completed));
+    EXPECT_NE(reused, completed);
+    ring->cancel(completed);
+    EXPECT_EQ(ring->poll(std::chrono::milliseconds(50)), 0U);
+    EXPECT_EQ(ring->pending(), 1U);
+
+    sender.sendTo(data, 2, "127.0.0.1", port);
+    while (ring->pending() > 0) {
+        ring->poll(std::chrono::seconds(1));
+    }
+    EXPECT_EQ(second, 2);
+}
+
+TEST(IoRingTest, connectToInvalidAddressLeavesNothingQueued) {
+    std::unique_ptr<IoRing> ring = createRing();
+    if (!ring) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    Socket<IPProto::TCP> client(IPVer::IPV4);
+    const Address invalid = {};
+    EXPECT_THROW(ring->connect(client.getSocketHandle(), invalid, [](const IoCompletion&) {}), Exception);
+    EXPECT_EQ(ring->pending(), 0U);
+    EXPECT_EQ(ring->submit(), 0U);
+}
+
+TEST(IoRingTest, connectUnixSocket) {
+    std::unique_ptr<IoRing> ring = createRing();
+    if (!ring) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    const std::string name = "cpplibsocket-test-" + std::to_string(::getpid()) + "-ring";
+    Socket<IPProto::UnixStream> listener;
+    listener.bindAbstract(name);
+    listener.listen(1);
+
+    Socket<IPProto::UnixStream> client;
+    SignedSize result = -1;
+    ring->connect(client.getSocketHandle(), utils::createAbstractAddr(name), [&](const IoCompletion& c) {
+        result = c.result;
+    });
+    while (ring->pending() > 0) {
+        ring->poll(std::chrono::seconds(1));
+    }
+    EXPECT_EQ(result, 0);
+    EXPECT_EQ(client.getPeerPath(), "@" + name);
+}
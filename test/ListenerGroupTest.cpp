@@ -0,0 +1,52 @@
+#include "cpplibsocket/ListenerGroup.h"
+
+#include <gmock/gmock.h>
+
+using namespace cpplibsocket;
+
+TEST(ListenerGroupTest, tcpShardsShareThePort) {
+    ListenerGroup<IPProto::TCP> group(IPVer::IPV4, 4, "127.0.0.1");
+    ASSERT_EQ(group.size(), 4U);
+    group.listen(16);
+    group.steerByCpu();
+    for (Socket<IPProto::TCP>& shard : group) {
+        EXPECT_EQ(shard.getEndpoint().port, group.getPort());
+        shard.setBlocked(false);
+    }
+
+    std::vector<Socket<IPProto::TCP>> clients;
+    for (int i = 0; i < 16; ++i) {
+        clients.emplace_back(IPVer::IPV4);
+        clients.back().connect("127.0.0.1", group.getPort());
+    }
+    UnsignedSize accepted = 0;
+    for (Socket<IPProto::TCP>& shard : group) {
+        while (shard.accept()) {
+            ++accepted;
+        }
+    }
+    EXPECT_EQ(accepted, clients.size());
+}
+
+TEST(ListenerGroupTest, udpShardsShareThePort) {
+    ListenerGroup<IPProto::UDP> group(IPVer::IPV4, 2, "127.0.0.1");
+    std::vector<Socket<IPProto::UDP>> shards = group.release();
+    ASSERT_EQ(shards.size(), 2U);
+
+    const Byte data[] = { 42 };
+    for (int i = 0; i < 8; ++i) {
+        // Different source ports make the datagrams hash to various shards
+        Socket<IPProto::UDP> source(IPVer::IPV4);
+        source.sendTo(data, sizeof(data), "127.0.0.1", shards[0].getEndpoint().port);
+    }
+    UnsignedSize received = 0;
+    for (Socket<IPProto::UDP>& shard : shards) {
+        shard.setBlocked(false);
+        Byte buffer[4];
+        Address source;
+        while (shard.receiveFrom(buffer, sizeof(buffer), source)) {
+            ++received;
+        }
+    }
+    EXPECT_EQ(received, 8U);
+}
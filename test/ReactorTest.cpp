@@ -0,0 +1,75 @@
+#include "cpplibsocket/Reactor.h"
+#include "cpplibsocket/Socket.h"
+
+#include <gmock/gmock.h>
+
+#include <thread>
+
+using namespace cpplibsocket;
+
+TEST(ReactorTest, dispatchesReadable) {
+    Reactor reactor;
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+
+    int calls = 0;
+    reactor.watch(receiver.getSocketHandle(), IOEvent::Readable, [&](const Reactor::Events events) {
+        EXPECT_TRUE(events.isSet(IOEvent::Readable));
+        Byte buffer[16];
+        EXPECT_TRUE(receiver.receiveFrom(buffer, sizeof(buffer)));
+        ++calls;
+    });
+    EXPECT_EQ(reactor.poll(std::chrono::milliseconds(0)), 0U);
+
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Byte data[] = { 1, 2, 3 };
+    sender.sendTo(data, sizeof(data), "127.0.0.1", port);
+    EXPECT_EQ(reactor.poll(std::chrono::seconds(1)), 1U);
+    EXPECT_EQ(calls, 1);
+
+    reactor.remove(receiver.getSocketHandle());
+    EXPECT_FALSE(reactor.contains(receiver.getSocketHandle()));
+}
+
+TEST(ReactorTest, ownsAddedSockets) {
+    Reactor reactor;
+    Socket<IPProto::UDP>& receiver = reactor.add(
+        Socket<IPProto::UDP>(IPVer::IPV4),
+        IOEvent::Readable,
+        std::function<void(Socket<IPProto::UDP>&, Reactor::Events)>(
+            [&reactor](Socket<IPProto::UDP>& socket, Reactor::Events) {
+                Byte buffer[16];
+                socket.receiveFrom(buffer, sizeof(buffer));
+                reactor.remove(socket.getSocketHandle()); // Removal from within the handler
+            }));
+    const Port port = receiver.bind("127.0.0.1");
+    EXPECT_EQ(reactor.size(), 1U);
+
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Byte data[] = { 1 };
+    sender.sendTo(data, sizeof(data), "127.0.0.1", port);
+    EXPECT_EQ(reactor.poll(std::chrono::seconds(1)), 1U);
+    EXPECT_EQ(reactor.size(), 0U);
+}
+
+TEST(ReactorTest, stopsFromAnotherThread) {
+    Reactor reactor;
+    std::thread stopper([&reactor]() { reactor.stop(); });
+    reactor.run();
+    stopper.join();
+}
+
+TEST(ReactorTest, runsTimers) {
+    Reactor reactor;
+    TimerWheel timers;
+    int expired = 0;
+    Timer first([&expired]() { ++expired; });
+    Timer second([&expired, &reactor]() {
+        ++expired;
+        reactor.stop();
+    });
+    timers.scheduleAfter(first, std::chrono::milliseconds(1));
+    timers.scheduleAfter(second, std::chrono::milliseconds(5));
+    reactor.run(timers);
+    EXPECT_EQ(expired, 2);
+}
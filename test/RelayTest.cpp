@@ -0,0 +1,134 @@
+#include "cpplibsocket/Relay.h"
+
+#include <gmock/gmock.h>
+
+#include <thread>
+
+using namespace cpplibsocket;
+
+namespace {
+
+/// Binds the listener and connects a new socket to it
+Socket<IPProto::TCP> connectTo(Socket<IPProto::TCP>& listener) {
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+    Socket<IPProto::TCP> socket(IPVer::IPV4);
+    socket.connect("127.0.0.1", port);
+    return socket;
+}
+
+/// Client connected to the server through the two sockets of a proxy
+struct ProxiedConnection {
+    ProxiedConnection()
+        : proxyListener(IPVer::IPV4)
+        , serverListener(IPVer::IPV4)
+        , client(connectTo(proxyListener))
+        , proxyIn(std::move(*proxyListener.accept()))
+        , proxyOut(connectTo(serverListener))
+        , server(std::move(*serverListener.accept())) {}
+
+    Socket<IPProto::TCP> proxyListener;
+    Socket<IPProto::TCP> serverListener;
+    Socket<IPProto::TCP> client;
+    Socket<IPProto::TCP> proxyIn;
+    Socket<IPProto::TCP> proxyOut;
+    Socket<IPProto::TCP> server;
+};
+
+std::vector<Byte> receiveAll(const Socket<IPProto::TCP>& socket) {
+    std::vector<Byte> data;
+    Byte buffer[64 * 1024];
+    while (const UnsignedSize received = *socket.receive(buffer, sizeof(buffer))) {
+        data.insert(data.end(), buffer, buffer + received);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(RelayTest, forwardsBothDirectionsWithHalfClose) {
+    ProxiedConnection connection;
+    Relay relay(connection.proxyIn, connection.proxyOut);
+
+    std::vector<Byte> request(4 * 1024 * 1024);
+    for (UnsignedSize i = 0; i < request.size(); ++i) {
+        request[i] = static_cast<Byte>(i * 7);
+    }
+    const std::vector<Byte> response = { 1, 2, 3 };
+    std::vector<Byte> requestReceived;
+    std::vector<Byte> responseReceived;
+    std::thread client([&]() {
+        UnsignedSize sent = 0;
+        connection.client.sendAll(request.data(), request.size(), sent);
+        connection.client.shutdown(Direction::TX);
+        responseReceived = receiveAll(connection.client);
+    });
+    std::thread server([&]() {
+        // The response is only sent once the whole request arrived, after the half-close
+        requestReceived = receiveAll(connection.server);
+        UnsignedSize sent = 0;
+        connection.server.sendAll(response.data(), response.size(), sent);
+        connection.server.close();
+    });
+
+    Reactor reactor;
+    const auto update = [&]() {
+        reactor.modify(connection.proxyIn.getSocketHandle(), relay.firstInterest());
+        reactor.modify(connection.proxyOut.getSocketHandle(), relay.secondInterest());
+    };
+    const auto handler = [&](const Reactor::Events) {
+        ASSERT_TRUE(relay.pump());
+        update();
+    };
+    reactor.watch(connection.proxyIn.getSocketHandle(), relay.firstInterest(), handler);
+    reactor.watch(connection.proxyOut.getSocketHandle(), relay.secondInterest(), handler);
+    while (!relay.finished()) {
+        ASSERT_GT(reactor.poll(std::chrono::seconds(5)), 0U);
+    }
+    client.join();
+    server.join();
+
+    EXPECT_EQ(requestReceived, request);
+    EXPECT_EQ(responseReceived, response);
+    EXPECT_EQ(relay.forwardedToSecond(), request.size());
+    EXPECT_EQ(relay.forwardedToFirst(), response.size());
+    EXPECT_EQ(relay.bufferedToSecond(), 0U);
+}
+
+TEST(RelayTest, appliesBackpressure) {
+    ProxiedConnection connection;
+    Relay::Options options;
+    options.pipeCapacity = 64 * 1024;
+    Relay relay(connection.proxyIn, connection.proxyOut, options);
+    connection.client.setOption<opt::SndBuf>(4096);
+    connection.proxyOut.setOption<opt::SndBuf>(4096);
+    connection.client.setBlocked(false);
+
+    // The server doesn't read, so the data piles up until the client can't send any more
+    const std::vector<Byte> data(16 * 1024 * 1024, 0xab);
+    UnsignedSize sent = 0;
+    while (true) {
+        const Expected<UnsignedSize, SocketError> out =
+            connection.client.sendAll(data.data(), data.size(), sent);
+        ASSERT_FALSE(out);
+        ASSERT_TRUE(out.error().isWouldBlock());
+        ASSERT_TRUE(relay.pump());
+        if (relay.firstInterest().isEmpty()) {
+            break;
+        }
+    }
+    EXPECT_LT(sent, data.size());
+    EXPECT_GT(relay.bufferedToSecond(), 0U);
+    EXPECT_TRUE(relay.secondInterest().isSet(IOEvent::Writable));
+    EXPECT_FALSE(relay.finished());
+
+    // Reading on the server side resumes the flow
+    const UnsignedSize forwarded = relay.forwardedToSecond();
+    Byte buffer[64 * 1024];
+    UnsignedSize received = 0;
+    while (received < forwarded) {
+        received += *connection.server.receive(buffer, sizeof(buffer));
+    }
+    ASSERT_TRUE(relay.pump());
+    EXPECT_GT(relay.forwardedToSecond(), forwarded);
+}
@@ -0,0 +1,104 @@
+#include "cpplibsocket/Resolver.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+
+using namespace cpplibsocket;
+
+namespace {
+
+/// Source answering from a hosts table, blocking every lookup until released
+class StubSource final : public ResolverSource {
+public:
+    StubSource(std::atomic<int>& lookups, std::shared_future<void> released)
+        : mLookups(lookups)
+        , mReleased(std::move(released)) {
+        std::istringstream hosts("10.0.0.1 backend\n"
+                                 "10.0.0.2 backend # second address\n"
+                                 "fd00::1  backend Backend.local\n");
+        mHosts.reset(new HostsResolverSource(hosts));
+    }
+
+    Answer lookup(const std::string& hostname, const Optional<IPVer> ipVersion) override {
+        ++mLookups;
+        mReleased.wait();
+        Answer answer = mHosts->lookup(hostname, ipVersion);
+        answer.ttl = std::chrono::seconds(60);
+        return answer;
+    }
+
+private:
+    std::atomic<int>& mLookups;
+    std::shared_future<void> mReleased;
+    std::unique_ptr<HostsResolverSource> mHosts;
+};
+
+/// Source failing every lookup with an exception not derived from std::exception
+class ThrowingSource final : public ResolverSource {
+public:
+    Answer lookup(const std::string&, const Optional<IPVer>) override { throw 42; }
+};
+
+} // namespace
+
+TEST(ResolverTest, coalescesAndCachesLookups) {
+    std::atomic<int> lookups(0);
+    std::promise<void> release;
+    Resolver resolver(std::unique_ptr<ResolverSource>(new StubSource(lookups, release.get_future().share())));
+
+    std::vector<std::future<ResolveResult>> results;
+    for (int i = 0; i < 4; ++i) {
+        results.push_back(resolver.resolve("backend"));
+    }
+    release.set_value();
+    for (std::future<ResolveResult>& future : results) {
+        const ResolveResult result = future.get();
+        ASSERT_TRUE(result);
+        ASSERT_EQ(result->size(), 3U);
+        EXPECT_EQ(utils::getEndpoint((*result)[0]).ip, "10.0.0.1");
+        EXPECT_EQ(utils::getEndpoint((*result)[1]).ip, "10.0.0.2");
+        EXPECT_EQ(utils::getEndpoint((*result)[2]).ip, "fd00::1");
+    }
+    EXPECT_EQ(lookups, 1);
+
+    ASSERT_TRUE(resolver.cached("BACKEND"));
+    const ResolveResult ipv6 = resolver.resolve("backend.local", IPVer::IPV6).get();
+    ASSERT_TRUE(ipv6);
+    EXPECT_EQ(ipv6->size(), 1U);
+    resolver.resolve("backend").get();
+    EXPECT_EQ(lookups, 2);
+}
+
+TEST(ResolverTest, cachesMissingNames) {
+    std::atomic<int> lookups(0);
+    std::promise<void> release;
+    release.set_value();
+    Resolver resolver(std::unique_ptr<ResolverSource>(new StubSource(lookups, release.get_future().share())));
+
+    for (int i = 0; i < 2; ++i) {
+        const ResolveResult result = resolver.resolve("unknown").get();
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error().status, ResolveError::Status::NotFound);
+    }
+    EXPECT_EQ(lookups, 1);
+
+    resolver.clearCache();
+    EXPECT_FALSE(resolver.cached("unknown"));
+    resolver.resolve("unknown").get();
+    EXPECT_EQ(lookups, 2);
+}
+
+TEST(ResolverTest, survivesThrowingSourceAndCallbacks) {
+    Resolver resolver(std::unique_ptr<ResolverSource>(new ThrowingSource()));
+    std::promise<ResolveResult> result;
+    resolver.resolve("backend", [](const ResolveResult&) { throw std::runtime_error("callback failed"); });
+    resolver.resolve("backend", [&result](const ResolveResult& answer) { result.set_value(answer); });
+
+    const ResolveResult answer = result.get_future().get();
+    ASSERT_FALSE(answer);
+    EXPECT_EQ(answer.error().status, ResolveError::Status::Failure);
+}
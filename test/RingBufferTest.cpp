@@ -0,0 +1,82 @@
+#include "TestUtils.h"
+#include "cpplibsocket/RingBuffer.h"
+#include "cpplibsocket/Socket.h"
+
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <unistd.h>
+
+using namespace cpplibsocket;
+
+TEST(RingBufferTest, capacityIsRoundedToPages) {
+    const RingBuffer ring(1);
+    EXPECT_EQ(ring.capacity(), static_cast<UnsignedSize>(::sysconf(_SC_PAGESIZE)));
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.available(), ring.capacity());
+}
+
+TEST(RingBufferTest, dataStaysContiguousAcrossWrapAround) {
+    RingBuffer ring(4096);
+    const UnsignedSize capacity = ring.capacity();
+
+    // Moves the read position close to the end of the first mapping
+    ring.commit(capacity - 10);
+    ring.consume(capacity - 10);
+
+    std::vector<Byte> message(100);
+    std::iota(message.begin(), message.end(), Byte(0));
+    std::memcpy(ring.space(), message.data(), message.size());
+    ring.commit(message.size());
+
+    ASSERT_EQ(ring.size(), message.size());
+    EXPECT_EQ(std::memcmp(ring.data(), message.data(), message.size()), 0);
+    EXPECT_EQ(ring.writable().size, capacity - message.size());
+
+    // The part past the end of the first mapping is visible at the beginning of it as well
+    ring.consume(50);
+    EXPECT_EQ(ring.data()[0], Byte(50));
+    EXPECT_EQ(ring.data(), ring.readable().data);
+
+    ring.consume(50);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RingBufferTest, moveTransfersTheMapping) {
+    RingBuffer ring(4096);
+    ring.commit(3);
+    RingBuffer moved(std::move(ring));
+    EXPECT_EQ(moved.size(), 3u);
+    EXPECT_EQ(ring.capacity(), 0u);
+}
+
+TEST(RingBufferTest, receiveIntoAndSendFrom) {
+    Socket<IPProto::TCP> client(IPVer::IPV4);
+    Socket<IPProto::TCP> server = connectThroughListener(client);
+
+    RingBuffer outgoing(4096);
+    const char text[] = "framed";
+    std::memcpy(outgoing.space(), text, sizeof(text));
+    outgoing.commit(sizeof(text));
+    const auto sent = client.sendFrom(outgoing);
+    ASSERT_TRUE(sent);
+    EXPECT_EQ(*sent, sizeof(text));
+    EXPECT_TRUE(outgoing.empty());
+
+    RingBuffer incoming(4096);
+    incoming.commit(incoming.capacity() - 2);
+    incoming.consume(incoming.capacity() - 2);
+    UnsignedSize total = 0;
+    while (total < sizeof(text)) {
+        const auto received = server.receiveInto(incoming);
+        ASSERT_TRUE(received);
+        ASSERT_NE(*received, 0u);
+        total += *received;
+    }
+    EXPECT_EQ(std::memcmp(incoming.data(), text, sizeof(text)), 0);
+
+    incoming.commit(incoming.available());
+    const auto full = server.tryReceiveInto(incoming);
+    ASSERT_FALSE(full);
+    EXPECT_EQ(full.error().code(), SocketError::noBuffers().code());
+}
@@ -0,0 +1,256 @@
+#include "TestUtils.h"
+#include "cpplibsocket/Socket.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace cpplibsocket;
+
+TEST(SocketTcpTest, sendvReceivev) {
+    ConnectedPair pair;
+    const Byte header[] = { 0, 0, 0, 5 };
+    const Byte payload[] = { 'h', 'e', 'l', 'l', 'o' };
+    const ConstBuffer outgoing[] = { { header, sizeof(header) }, { payload, sizeof(payload) } };
+    const auto sent = pair.client.sendv(outgoing, 2);
+    ASSERT_TRUE(sent);
+    EXPECT_EQ(*sent, sizeof(header) + sizeof(payload));
+
+    Byte receivedHeader[4];
+    Byte receivedPayload[16];
+    const MutableBuffer incoming[] = { { receivedHeader, sizeof(receivedHeader) },
+                                       { receivedPayload, sizeof(receivedPayload) } };
+    const auto received = pair.server.receivev(incoming, 2);
+    ASSERT_TRUE(received);
+    EXPECT_EQ(*received, sizeof(header) + sizeof(payload));
+    EXPECT_EQ(std::memcmp(receivedHeader, header, sizeof(header)), 0);
+    EXPECT_EQ(std::memcmp(receivedPayload, payload, sizeof(payload)), 0);
+}
+
+#ifdef __linux__
+TEST(SocketTcpTest, zeroCopySendCompletes) {
+    ConnectedPair pair;
+    try {
+        pair.client.setZeroCopy();
+    } catch (const Exception&) {
+        GTEST_SKIP() << "SO_ZEROCOPY is not supported";
+    }
+    std::vector<Byte> data(64 * 1024, 0xab);
+    const auto send = pair.client.sendZeroCopy(data.data(), data.size());
+    ASSERT_TRUE(send);
+    ASSERT_GT(send->sent, 0U);
+
+    std::vector<Byte> received(data.size());
+    UnsignedSize total = 0;
+    while (total < send->sent) {
+        total += *pair.server.receive(received.data(), received.size());
+    }
+
+    // The notification is queued once the receiver releases the data
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const auto completion = pair.client.readZeroCopyCompletion();
+        if (completion) {
+            EXPECT_TRUE(completion->covers(send->id));
+            EXPECT_TRUE(completion->copied); // Loopback always copies
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    FAIL() << "No zero-copy completion received";
+}
+#endif
+
+TEST(SocketTcpTest, acceptManyCapturesPeers) {
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(8);
+    listener.setBlocked(false);
+    EXPECT_TRUE(listener.acceptMany(8).empty());
+
+    std::vector<Socket<IPProto::TCP>> clients;
+    for (int i = 0; i < 3; ++i) {
+        clients.emplace_back(IPVer::IPV4);
+        clients.back().connect("127.0.0.1", port);
+    }
+    std::vector<AcceptedSocket> accepted = listener.acceptMany(2);
+    ASSERT_EQ(accepted.size(), 2U);
+    const std::vector<AcceptedSocket> rest = listener.acceptMany(8);
+    ASSERT_EQ(rest.size(), 1U);
+
+    for (UnsignedSize i = 0; i < 2; ++i) {
+        EXPECT_EQ(utils::getSinPort(accepted[i].peer), clients[i].getEndpoint().port);
+    }
+    Byte buffer[1];
+    EXPECT_FALSE(accepted[0].socket.receive(buffer, sizeof(buffer))); // Non-blocking by default
+}
+
+TEST(SocketTcpTest, typedOptions) {
+    SocketOptions<IPProto::TCP> options;
+    options.set<opt::NoDelay>(true).set<opt::SndBuf>(64 * 1024);
+    Socket<IPProto::TCP> socket(IPVer::IPV4, options);
+    EXPECT_TRUE(socket.getOption<opt::NoDelay>());
+    EXPECT_GE(socket.getOption<opt::SndBuf>(), 64 * 1024);
+
+    socket.setOption<opt::NoDelay>(false);
+    EXPECT_FALSE(socket.getOption<opt::NoDelay>());
+    socket.setOption<opt::Tos>(0x10);
+    EXPECT_EQ(socket.getOption<opt::Tos>(), 0x10);
+    EXPECT_THROW(socket.setOption<opt::V6Only>(true), Exception);
+
+    Socket<IPProto::TCP> socket6(IPVer::IPV6);
+    socket6.setOption<opt::V6Only>(true);
+    EXPECT_TRUE(socket6.getOption<opt::V6Only>());
+}
+
+TEST(SocketTcpTest, tryApiReportsErrorsWithoutThrowing) {
+    ConnectedPair pair;
+    pair.client.setBlocked(false);
+    Byte buffer[4];
+    const Expected<UnsignedSize, SocketError> empty = pair.client.tryReceive(buffer, sizeof(buffer));
+    ASSERT_FALSE(empty);
+    EXPECT_TRUE(empty.error().isWouldBlock());
+
+    // Closing with zero linger time resets the connection
+    const linger reset = { 1, 0 };
+    ::setsockopt(pair.server.getSocketHandle(),
+                 SOL_SOCKET,
+                 SO_LINGER,
+                 reinterpret_cast<const char*>(&reset),
+                 sizeof(reset));
+    pair.server.close();
+    pair.client.setBlocked(true);
+    const Expected<UnsignedSize, SocketError> received = pair.client.tryReceive(buffer, sizeof(buffer));
+    ASSERT_FALSE(received);
+    EXPECT_EQ(received.error().category(), SocketError::Category::ConnectionReset);
+    EXPECT_FALSE(received.error().message().empty());
+
+    const Expected<UnsignedSize, SocketError> closed = pair.server.trySend(buffer, sizeof(buffer));
+    ASSERT_FALSE(closed);
+    EXPECT_EQ(closed.error().category(), SocketError::Category::NotOpen);
+}
+
+TEST(SocketTcpTest, sendAllResumesAfterWouldBlock) {
+    ConnectedPair pair;
+    pair.client.setOption<opt::SndBuf>(4096);
+    pair.client.setBlocked(false);
+    pair.server.setBlocked(false);
+    std::vector<Byte> data(1024 * 1024);
+    for (UnsignedSize i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<Byte>(i * 7);
+    }
+    std::vector<Byte> received(data.size());
+    const MutableBuffer halves[] = { { received.data(), 1000 },
+                                     { received.data() + 1000, received.size() - 1000 } };
+
+    UnsignedSize sent = 0;
+    BufferCursor cursor;
+    bool blocked = false;
+    while (cursor.buffer < 2) {
+        const Expected<UnsignedSize, SocketError> out = pair.client.sendAll(data.data(), data.size(), sent);
+        blocked = blocked || (!out && out.error().isWouldBlock());
+        const Expected<UnsignedSize, SocketError> in = pair.server.receiveExactv(halves, 2, cursor);
+        ASSERT_TRUE(in || in.error().isWouldBlock());
+    }
+    EXPECT_TRUE(blocked);
+    EXPECT_EQ(sent, data.size());
+    EXPECT_EQ(received, data);
+
+    const Byte header[] = { 1, 2 };
+    const Byte payload[] = { 3, 4, 5 };
+    const ConstBuffer message[] = { { header, sizeof(header) },
+                                    { nullptr, 0 },
+                                    { payload, sizeof(payload) } };
+    BufferCursor messageCursor;
+    pair.client.setBlocked(true);
+    ASSERT_TRUE(pair.client.sendAllv(message, 3, messageCursor));
+    EXPECT_EQ(messageCursor.buffer, 3U);
+
+    UnsignedSize extra = 0;
+    Byte buffer[5];
+    pair.server.setBlocked(true);
+    ASSERT_TRUE(pair.server.receiveExact(buffer, sizeof(buffer), extra));
+    EXPECT_EQ(buffer[4], 5);
+    extra = 0;
+    pair.client.close();
+    const Expected<UnsignedSize, SocketError> eof = pair.server.receiveExact(buffer, sizeof(buffer), extra);
+    ASSERT_TRUE(eof);
+    EXPECT_EQ(extra, 0U);
+}
+
+TEST(SocketTcpTest, connectWithTimeout) {
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(0);
+    const Address address = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    Socket<IPProto::TCP> client(IPVer::IPV4);
+    client.connect(address, std::chrono::seconds(5));
+
+    // The accept queue is full, so the SYNs of further connections are dropped
+    Socket<IPProto::TCP> blackHoled(IPVer::IPV4);
+    const auto start = std::chrono::steady_clock::now();
+    const Expected<Connected, SocketError> timedOut =
+        blackHoled.tryConnect(address, std::chrono::milliseconds(50));
+    ASSERT_FALSE(timedOut);
+    EXPECT_EQ(timedOut.error().category(), SocketError::Category::TimedOut);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    // The connected socket is blocking again
+    Socket<IPProto::TCP> server = std::move(*listener.accept());
+    const Byte byte = 42;
+    client.send(&byte, 1);
+    Byte received = 0;
+    EXPECT_EQ(*server.receive(&received, 1), 1U);
+    EXPECT_EQ(received, byte);
+}
+
+TEST(SocketTcpTest, sendFileResumesAfterWouldBlock) {
+    std::vector<Byte> data(1024 * 1024);
+    for (UnsignedSize i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<Byte>(i * 7);
+    }
+    const std::string path = testing::TempDir() + "cpplibsocket_sendfile";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    ConnectedPair pair;
+    pair.client.setOption<opt::SndBuf>(4096);
+    pair.client.setBlocked(false);
+    pair.server.setBlocked(false);
+    const UnsignedSize offset = 100;
+    std::vector<Byte> received(data.size() - offset);
+    UnsignedSize sent = 0;
+    UnsignedSize receivedSize = 0;
+    bool blocked = false;
+    while (receivedSize < received.size()) {
+        const Expected<UnsignedSize, SocketError> out =
+            pair.client.sendFile(path, offset, received.size(), sent);
+        blocked = blocked || (!out && out.error().isWouldBlock());
+        ASSERT_TRUE(out || out.error().isWouldBlock());
+        const Expected<UnsignedSize, SocketError> in =
+            pair.server.receiveExact(received.data(), received.size(), receivedSize);
+        ASSERT_TRUE(in || in.error().isWouldBlock());
+    }
+    EXPECT_TRUE(blocked);
+    EXPECT_EQ(sent, received.size());
+    EXPECT_TRUE(std::equal(received.begin(), received.end(), data.begin() + offset));
+
+    // The transfer stops at the end of the file
+    pair.client.setBlocked(true);
+    sent = 0;
+    const Expected<UnsignedSize, SocketError> tail = pair.client.sendFile(path, data.size() - 10, 100, sent);
+    ASSERT_TRUE(tail);
+    EXPECT_EQ(*tail, 10U);
+    EXPECT_EQ(sent, 10U);
+    std::remove(path.c_str());
+
+    sent = 0;
+    const Expected<UnsignedSize, SocketError> missing = pair.client.sendFile(path, 0, 1, sent);
+    ASSERT_FALSE(missing);
+    EXPECT_EQ(sent, 0U);
+}
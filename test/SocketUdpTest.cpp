@@ -0,0 +1,200 @@
+#include "cpplibsocket/Socket.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <vector>
+
+using namespace cpplibsocket;
+
+TEST(SocketUdpTest, sendAndReceiveBatch) {
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Port senderPort = sender.bind("127.0.0.1");
+
+    const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    const Byte first[] = { 1 };
+    const Byte second[] = { 2, 2 };
+    const Byte third[] = { 3, 3, 3 };
+    OutgoingDatagram outgoing[] = { { first, sizeof(first), &destination, 0 },
+                                    { second, sizeof(second), &destination, 0 },
+                                    { third, sizeof(third), &destination, 0 } };
+    const auto sent = sender.sendBatch(outgoing, 3);
+    ASSERT_TRUE(sent);
+    EXPECT_EQ(*sent, 3U);
+    EXPECT_EQ(outgoing[2].sent, 3U);
+
+    Byte storage[8][16];
+    IncomingDatagram incoming[8];
+    for (UnsignedSize i = 0; i < 8; ++i) {
+        incoming[i].data = storage[i];
+        incoming[i].maxSize = sizeof(storage[i]);
+    }
+    const auto received = receiver.receiveBatch(incoming, 8);
+    ASSERT_TRUE(received);
+    ASSERT_EQ(*received, 3U);
+    for (UnsignedSize i = 0; i < 3; ++i) {
+        EXPECT_EQ(incoming[i].size, i + 1);
+        EXPECT_EQ(storage[i][0], i + 1);
+        EXPECT_EQ(utils::getSinPort(incoming[i].source), senderPort);
+    }
+
+    receiver.setBlocked(false);
+    EXPECT_FALSE(receiver.receiveBatch(incoming, 8));
+}
+
+TEST(SocketUdpTest, sendBatchOnConnectedSocket) {
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", receiver.bind("127.0.0.1"));
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    ASSERT_TRUE(Platform::connect(sender.getSocketHandle(), &destination.sa, sizeof(destination.sa_in)));
+
+    const Byte first[] = { 1 };
+    const Byte second[] = { 2, 2 };
+    OutgoingDatagram outgoing[] = { { first, sizeof(first), nullptr, 0 },
+                                    { second, sizeof(second), nullptr, 0 } };
+    const auto sent = sender.sendBatch(outgoing, 2);
+    ASSERT_TRUE(sent);
+    EXPECT_EQ(*sent, 2U);
+
+    Byte buffer[16];
+    Address source;
+    EXPECT_EQ(*receiver.receiveFrom(buffer, sizeof(buffer), source), sizeof(first));
+    EXPECT_EQ(*receiver.receiveFrom(buffer, sizeof(buffer), source), sizeof(second));
+}
+
+TEST(SocketUdpTest, rejectsNonIPAddresses) {
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Address zeroed = {};
+    const Byte data[] = { 1 };
+    const auto sent = sender.trySendTo(data, sizeof(data), zeroed);
+    ASSERT_FALSE(sent);
+    EXPECT_EQ(sent.error().code(), SocketError::unsupportedFamily().code());
+
+    OutgoingDatagram outgoing[] = { { data, sizeof(data), &zeroed, 0 } };
+    EXPECT_FALSE(sender.trySendBatch(outgoing, 1));
+    EXPECT_FALSE(sender.trySendToSegmented(data, sizeof(data), 1, zeroed));
+    EXPECT_THROW(sender.sendTo(data, sizeof(data), zeroed), Exception);
+}
+
+TEST(SocketUdpTest, receiveFromRawAddress) {
+    static_assert(std::is_trivially_copyable<Endpoint>::value, "Endpoint must not own heap memory");
+
+    Socket<IPProto::UDP> receiver(IPVer::IPV6);
+    const Port port = receiver.bind("::1");
+    Socket<IPProto::UDP> sender(IPVer::IPV6);
+    const Port senderPort = sender.bind("::1");
+
+    const Byte data[] = { 42 };
+    sender.sendTo(data, sizeof(data), "::1", port);
+    Byte buffer[4];
+    Address source;
+    const auto received = receiver.receiveFrom(buffer, sizeof(buffer), source);
+    ASSERT_TRUE(received);
+    EXPECT_EQ(*received, 1U);
+
+    const Endpoint endpoint = utils::getEndpoint(source);
+    EXPECT_EQ(endpoint.ipVersion, IPVer::IPV6);
+    EXPECT_EQ(endpoint.ip, "::1");
+    EXPECT_EQ(endpoint.port, senderPort);
+}
+
+TEST(SocketUdpTest, sendSegmented) {
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+
+    std::vector<Byte> data(3500);
+    for (UnsignedSize i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<Byte>(i);
+    }
+    const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    EXPECT_EQ(*sender.sendToSegmented(data.data(), data.size(), 1000, destination), data.size());
+
+    // Without coalescing the datagrams are received one by one
+    std::vector<Byte> received(data.size());
+    UnsignedSize offset = 0;
+    for (const UnsignedSize expected : { 1000U, 1000U, 1000U, 500U }) {
+        Address source;
+        UnsignedSize segmentSize = 0;
+        const Expected<UnsignedSize, WouldBlock> size = receiver.receiveFromCoalesced(
+            received.data() + offset, received.size() - offset, source, segmentSize);
+        ASSERT_TRUE(size);
+        EXPECT_EQ(*size, expected);
+        EXPECT_EQ(segmentSize, expected);
+        offset += *size;
+    }
+    EXPECT_EQ(received, data);
+}
+
+TEST(SocketUdpTest, sendSegmentedBeyondOffloadLimit) {
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+
+    // More segments than Linux offloads in a single call, so the datagrams are sent one by one instead
+    const std::vector<Byte> data(100 * 10, 7);
+    const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    EXPECT_EQ(*sender.sendToSegmented(data.data(), data.size(), 10, destination), data.size());
+
+    receiver.setBlocked(false);
+    Byte buffer[64];
+    Address source;
+    UnsignedSize datagrams = 0;
+    while (const auto size = receiver.receiveFrom(buffer, sizeof(buffer), source)) {
+        EXPECT_EQ(*size, 10U);
+        ++datagrams;
+    }
+    EXPECT_EQ(datagrams, 100U);
+}
+
+TEST(SocketUdpTest, rejectsSegmentSizesOutOfRange) {
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", 9);
+    const Byte data[] = { 1, 2 };
+    for (const UnsignedSize segmentSize : { UnsignedSize(0), UnsignedSize(65536) }) {
+        const auto sent = sender.trySendToSegmented(data, sizeof(data), segmentSize, destination);
+        ASSERT_FALSE(sent);
+        EXPECT_EQ(sent.error().code(), SocketError::invalidArgument().code());
+    }
+    EXPECT_THROW(sender.sendToSegmented(data, sizeof(data), 0, destination), Exception);
+}
+
+#ifdef UDP_GRO
+TEST(SocketUdpTest, receiveCoalesced) {
+    Socket<IPProto::UDP> receiver(IPVer::IPV4);
+    const Port port = receiver.bind("127.0.0.1");
+    receiver.setOption<opt::UdpGro>(true);
+    Socket<IPProto::UDP> sender(IPVer::IPV4);
+    sender.setOption<opt::UdpSegment>(1000);
+    EXPECT_EQ(sender.getOption<opt::UdpSegment>(), 1000);
+
+    // The segment size set on the socket applies to the plain sends as well
+    const std::vector<Byte> data(3500, 0xab);
+    const Address destination = utils::createAddr(IPVer::IPV4, "127.0.0.1", port);
+    EXPECT_EQ(*sender.sendTo(data.data(), data.size(), destination), data.size());
+
+    std::vector<Byte> received(64 * 1024);
+    Address source;
+    UnsignedSize segmentSize = 0;
+    const Expected<UnsignedSize, WouldBlock> size =
+        receiver.receiveFromCoalesced(received.data(), received.size(), source, segmentSize);
+    ASSERT_TRUE(size);
+    EXPECT_EQ(*size, data.size());
+    EXPECT_EQ(segmentSize, 1000U);
+}
+#endif
+
+TEST(SocketUdpTest, waitWritableManySockets) {
+    // More sockets than the descriptors kept on the stack
+    std::vector<Socket<IPProto::UDP>> sockets;
+    std::vector<SocketHandle> handles;
+    for (int i = 0; i < 20; ++i) {
+        sockets.emplace_back(IPVer::IPV4);
+        handles.push_back(sockets.back().getSocketHandle());
+    }
+    bool ready[20] = {};
+    EXPECT_EQ(Platform::waitWritable(handles.data(), ready, handles.size(), 1000), 20);
+    EXPECT_THAT(ready, ::testing::Each(true));
+}
@@ -0,0 +1,141 @@
+#include "cpplibsocket/SocketUnix.h"
+#include "cpplibsocket/utils/utils.h"
+
+#include <gmock/gmock.h>
+
+#include <thread>
+#include <unistd.h>
+
+using namespace cpplibsocket;
+
+namespace {
+
+/// Name unique to the test process, so concurrent test runs don't collide
+std::string uniqueName(const std::string& name) {
+    return "cpplibsocket-test-" + std::to_string(::getpid()) + "-" + name;
+}
+
+} // namespace
+
+TEST(SocketUnixTest, streamPair) {
+    auto sockets = Socket<IPProto::UnixStream>::pair();
+    std::vector<Byte> data(1024 * 1024);
+    for (UnsignedSize i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<Byte>(i * 7);
+    }
+    std::vector<Byte> received(data.size());
+    UnsignedSize receivedSize = 0;
+    std::thread receiver(
+        [&]() { sockets.second.receiveExact(received.data(), received.size(), receivedSize); });
+    UnsignedSize sent = 0;
+    EXPECT_TRUE(sockets.first.sendAll(data.data(), data.size(), sent));
+    receiver.join();
+    EXPECT_EQ(receivedSize, data.size());
+    EXPECT_EQ(received, data);
+
+    sockets.first.shutdown(Direction::TX);
+    Byte byte;
+    EXPECT_EQ(*sockets.second.receive(&byte, 1), 0U);
+    EXPECT_EQ(sockets.first.getPath(), "");
+}
+
+TEST(SocketUnixTest, streamConnectsToPath) {
+    const std::string path = "/tmp/" + uniqueName("stream.sock");
+    ::unlink(path.c_str());
+    Socket<IPProto::UnixStream> listener;
+    listener.bind(path);
+    listener.listen(1);
+    EXPECT_EQ(listener.getPath(), path);
+
+    Socket<IPProto::UnixStream> client;
+    client.connect(path);
+    Socket<IPProto::UnixStream> server = std::move(*listener.accept());
+    EXPECT_EQ(client.getPeerPath(), path);
+
+    const Byte message[] = { 1, 2, 3 };
+    EXPECT_EQ(*client.send(message, sizeof(message)), sizeof(message));
+    Byte received[sizeof(message)] = {};
+    EXPECT_EQ(*server.receive(received, sizeof(received)), sizeof(message));
+    EXPECT_THAT(received, ::testing::ElementsAreArray(message));
+
+    // The path stays taken until the socket file is removed
+    Socket<IPProto::UnixStream> other;
+    EXPECT_THROW(other.bind(path), Exception);
+    ::unlink(path.c_str());
+}
+
+TEST(SocketUnixTest, abstractAddress) {
+    const std::string name = uniqueName("abstract");
+    Socket<IPProto::UnixSeqPacket> listener;
+    listener.bindAbstract(name);
+    listener.listen(1);
+    EXPECT_EQ(listener.getPath(), "@" + name);
+
+    Socket<IPProto::UnixSeqPacket> client;
+    client.connect(utils::createAbstractAddr(name));
+    Socket<IPProto::UnixSeqPacket> server = std::move(*listener.accept());
+    EXPECT_EQ(client.getPeerPath(), "@" + name);
+
+    // Another name sharing the prefix is a different address
+    Socket<IPProto::UnixSeqPacket> prefixed;
+    EXPECT_THROW(prefixed.connect(utils::createAbstractAddr(name.substr(0, name.size() - 1))), Exception);
+
+    const Byte message[] = { 4, 5 };
+    EXPECT_EQ(*server.send(message, sizeof(message)), sizeof(message));
+    Byte received[16] = {};
+    EXPECT_EQ(*client.receive(received, sizeof(received)), sizeof(message));
+}
+
+TEST(SocketUnixTest, seqPacketKeepsMessageBoundaries) {
+    auto sockets = Socket<IPProto::UnixSeqPacket>::pair();
+    const Byte first[] = { 1, 2, 3 };
+    const Byte second[] = { 4, 5 };
+    sockets.first.send(first, sizeof(first));
+    sockets.first.send(second, sizeof(second));
+
+    Byte received[16];
+    EXPECT_EQ(*sockets.second.receive(received, sizeof(received)), sizeof(first));
+    EXPECT_EQ(*sockets.second.receive(received, sizeof(received)), sizeof(second));
+    EXPECT_EQ(received[0], 4);
+}
+
+TEST(SocketUnixTest, datagramSendToAndReceiveFrom) {
+    Socket<IPProto::UnixDatagram> server;
+    server.bindAbstract(uniqueName("server"));
+    Socket<IPProto::UnixDatagram> client;
+    client.bindAbstract(uniqueName("client"));
+    server.setBlocked(false);
+    Byte received[16];
+    Address source;
+    EXPECT_FALSE(server.receiveFrom(received, sizeof(received), source));
+
+    const Byte request[] = { 1, 2, 3 };
+    EXPECT_EQ(*client.sendTo(request, sizeof(request), utils::createAbstractAddr(uniqueName("server"))),
+              sizeof(request));
+    EXPECT_EQ(*server.receiveFrom(received, sizeof(received), source), sizeof(request));
+    EXPECT_EQ(utils::getUnixPath(source), "@" + uniqueName("client"));
+
+    const Byte response[] = { 4 };
+    EXPECT_EQ(*server.sendTo(response, sizeof(response), source), sizeof(response));
+    EXPECT_EQ(*client.receive(received, sizeof(received)), sizeof(response));
+    EXPECT_EQ(received[0], 4);
+}
+
+TEST(SocketUnixTest, setsSocketLevelOptions) {
+    Socket<IPProto::UnixDatagram> socket(SocketOptions<IPProto::UnixDatagram>().set<opt::SndBuf>(64 * 1024));
+    EXPECT_GE(socket.getOption<opt::SndBuf>(), 64 * 1024);
+}
+
+TEST(SocketUnixTest, rejectsInvalidAddresses) {
+    EXPECT_THROW(utils::createUnixAddr(""), Exception);
+    EXPECT_THROW(utils::createUnixAddr(std::string(sizeof(sockaddr_un::sun_path), 'a')), Exception);
+    EXPECT_THROW(utils::createAbstractAddr(std::string("a\0b", 3)), Exception);
+    EXPECT_EQ(utils::getUnixPath(utils::createUnixAddr("/tmp/a")), "/tmp/a");
+
+    const Address zeroed = {};
+    Socket<IPProto::UnixDatagram> socket;
+    const Byte data[] = { 1 };
+    EXPECT_FALSE(socket.trySendTo(data, sizeof(data), zeroed));
+    EXPECT_FALSE(socket.tryConnect(zeroed));
+    EXPECT_FALSE(socket.tryConnect(utils::createAddr(IPVer::IPV4, "127.0.0.1", 9)));
+}
@@ -0,0 +1,28 @@
+#ifndef CPPLIBSOCKET_TEST_TESTUTILS_H_
+#define CPPLIBSOCKET_TEST_TESTUTILS_H_
+
+#include "cpplibsocket/Socket.h"
+
+/// Connects the client to a listener on the loopback
+/// \returns The server side of the connection.
+inline cpplibsocket::Socket<cpplibsocket::IPProto::TCP>
+connectThroughListener(cpplibsocket::Socket<cpplibsocket::IPProto::TCP>& client) {
+    using namespace cpplibsocket;
+    Socket<IPProto::TCP> listener(IPVer::IPV4);
+    const Port port = listener.bind("127.0.0.1");
+    listener.listen(1);
+    client.connect("127.0.0.1", port);
+    return std::move(*listener.accept());
+}
+
+/// Both sides of a TCP connection over the loopback
+struct ConnectedPair {
+    ConnectedPair()
+        : client(cpplibsocket::IPVer::IPV4)
+        , server(connectThroughListener(client)) {}
+
+    cpplibsocket::Socket<cpplibsocket::IPProto::TCP> client;
+    cpplibsocket::Socket<cpplibsocket::IPProto::TCP> server;
+};
+
+#endif // CPPLIBSOCKET_TEST_TESTUTILS_H_
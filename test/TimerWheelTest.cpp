@@ -0,0 +1,126 @@
+#include "cpplibsocket/TimerWheel.h"
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace cpplibsocket;
+using namespace std::chrono_literals;
+
+TEST(TimerWheelTest, expiresAtDeadline) {
+    const TimerWheel::Clock::time_point start;
+    TimerWheel wheel({}, start);
+    int calls = 0;
+    Timer timer([&calls]() { ++calls; });
+    wheel.schedule(timer, start + 10ms);
+    EXPECT_TRUE(timer.isArmed());
+    EXPECT_EQ(wheel.size(), 1U);
+
+    EXPECT_EQ(wheel.advance(start + 9ms), 0U);
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(wheel.advance(start + 10ms), 1U);
+    EXPECT_EQ(calls, 1);
+    EXPECT_FALSE(timer.isArmed());
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, reschedulesAndCancels) {
+    const TimerWheel::Clock::time_point start;
+    TimerWheel wheel({}, start);
+    int calls = 0;
+    Timer timer([&calls]() { ++calls; });
+    wheel.schedule(timer, start + 10ms);
+    wheel.schedule(timer, start + 20ms); // Re-armed, e.g. on a message received
+    EXPECT_EQ(wheel.size(), 1U);
+    EXPECT_EQ(wheel.advance(start + 15ms), 0U);
+    EXPECT_EQ(wheel.advance(start + 20ms), 1U);
+    EXPECT_EQ(calls, 1);
+
+    wheel.schedule(timer, start + 30ms);
+    timer.cancel();
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.advance(start + 1s), 0U);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(TimerWheelTest, cancelsDestroyedTimers) {
+    const TimerWheel::Clock::time_point start;
+    TimerWheel wheel({}, start);
+    {
+        Timer timer([]() { FAIL(); });
+        wheel.schedule(timer, start + 1ms);
+    }
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.advance(start + 1s), 0U);
+}
+
+TEST(TimerWheelTest, timerMayBeDestroyedByItsCallback) {
+    const TimerWheel::Clock::time_point start;
+    TimerWheel wheel({}, start);
+    std::unique_ptr<Timer> timer(new Timer());
+    timer->setCallback([&timer]() { timer.reset(); });
+    wheel.schedule(*timer, start + 5ms);
+    EXPECT_EQ(wheel.advance(start + 5ms), 1U);
+    EXPECT_FALSE(timer);
+}
+
+TEST(TimerWheelTest, tellsTimeUntilNext) {
+    const TimerWheel::Clock::time_point start;
+    TimerWheel wheel({}, start);
+    EXPECT_LT(wheel.timeUntilNext(start), TimerWheel::Clock::duration::zero());
+
+    Timer timer;
+    wheel.schedule(timer, start + 10ms);
+    EXPECT_EQ(wheel.timeUntilNext(start), 10ms);
+    EXPECT_EQ(wheel.timeUntilNext(start + 4ms), 6ms);
+
+    // Due far in the future, the wheel has to be advanced on the way to move the timer to the lower levels
+    wheel.schedule(timer, start + 1h);
+    EXPECT_GT(wheel.timeUntilNext(start), TimerWheel::Clock::duration::zero());
+    EXPECT_LE(wheel.timeUntilNext(start), 1h);
+
+    wheel.schedule(timer, start - 1ms);
+    EXPECT_EQ(wheel.timeUntilNext(start), TimerWheel::Clock::duration::zero());
+}
+
+TEST(TimerWheelTest, neverExpiresEarlyOrLate) {
+    const TimerWheel::Clock::time_point start;
+    TimerWheel wheel({}, start);
+    std::mt19937_64 random(42);
+    // Up to 10 hours, beyond the span of the wheel at the millisecond resolution
+    std::uniform_int_distribution<std::int64_t> deadlines(0, 10 * 3600 * 1000);
+    std::uniform_int_distribution<std::int64_t> steps(0, 60 * 1000);
+
+    constexpr int TIMER_COUNT = 2000;
+    std::vector<std::unique_ptr<Timer>> timers;
+    std::vector<TimerWheel::Clock::time_point> expected(TIMER_COUNT);
+    std::vector<TimerWheel::Clock::time_point> expired(TIMER_COUNT);
+    TimerWheel::Clock::time_point now = start;
+    for (int i = 0; i < TIMER_COUNT; ++i) {
+        timers.emplace_back(new Timer([i, &now, &expired]() { expired[i] = now; }));
+        expected[i] = start + std::chrono::milliseconds(deadlines(random));
+        wheel.schedule(*timers.back(), expected[i]);
+    }
+
+    TimerWheel::Clock::time_point previous = start;
+    UnsignedSize total = 0;
+    while (!wheel.empty()) {
+        previous = now;
+        now += std::chrono::milliseconds(steps(random));
+        total += wheel.advance(now);
+        for (int i = 0; i < TIMER_COUNT; ++i) {
+            if (expected[i] > previous && expected[i] <= now) {
+                ASSERT_EQ(expired[i], now) << "Timer " << i;
+            }
+        }
+    }
+    EXPECT_EQ(total, static_cast<UnsignedSize>(TIMER_COUNT));
+}
+
+TEST(TimerWheelTest, rejectsInvalidResolution) {
+    TimerWheelOptions options;
+    options.resolution = TimerWheel::Clock::duration::zero();
+    EXPECT_THROW(TimerWheel wheel(options), Exception);
+}